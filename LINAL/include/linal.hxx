@@ -41,5 +41,6 @@
 #include "linal/flat.hxx"
 #include "linal/hier.hxx"
 #include "linal/operation.hxx"
+#include "linal/kernel.hxx"
 
 #endif
@@ -63,6 +63,20 @@
 #define LINAL_GPU               100
 #define LINAL_CPU_GPU           200
 
+#define LINAL_GEMM_KERNEL_SCALAR    0
+#define LINAL_GEMM_KERNEL_AVX2      1
+#define LINAL_GEMM_KERNEL_AVX512    2
+#define LINAL_GEMM_KERNEL_THRESHOLD 128
+
+#define LINAL_LU_PIV_PANEL_THRESHOLD 0
+#define LINAL_QR_PANEL_THRESHOLD     0
+
+#define LINAL_RECURSIVE_BASE       128
+
+#define LINAL_LOOKAHEAD              0
+
+#define LINAL_TYPED_KERNEL_THRESHOLD 0
+
 
 // Null matrix
 namespace linal {
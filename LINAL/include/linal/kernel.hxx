@@ -0,0 +1,299 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef LINAL_KERNEL_HXX
+#define LINAL_KERNEL_HXX
+
+/*!
+  Block kernels specialized at compile time on the scalar type and on
+  trans/side/uplo/diag.
+
+  The dense algorithms resolve the runtime arguments once per call and
+  then call these on every block, so the inner loops carry no datatype
+  or transpose branches and run on raw column major buffers. Blocks
+  must have unit row stride, see is_typed_kernel.
+*/
+
+namespace linal {
+  namespace kernel {
+
+    // --------------------------------------------------------------
+    // ** Scalar types
+    template<typename T> struct Type_;
+
+    template<> struct Type_<float> {
+      enum { datatype = FLA_FLOAT };
+      static inline float value(FLA_Obj s) { return *FLA_FLOAT_PTR( s ); }
+      static inline float conj (float v)   { return v; }
+    };
+    template<> struct Type_<double> {
+      enum { datatype = FLA_DOUBLE };
+      static inline double value(FLA_Obj s) { return *FLA_DOUBLE_PTR( s ); }
+      static inline double conj (double v)  { return v; }
+    };
+    template<> struct Type_< std::complex<float> > {
+      enum { datatype = FLA_COMPLEX };
+      static inline std::complex<float> value(FLA_Obj s) { 
+        scomplex *v = FLA_COMPLEX_PTR( s );
+        return std::complex<float>(v->real, v->imag); 
+      }
+      static inline std::complex<float> conj(std::complex<float> v) { 
+        return std::conj(v); 
+      }
+    };
+    template<> struct Type_< std::complex<double> > {
+      enum { datatype = FLA_DOUBLE_COMPLEX };
+      static inline std::complex<double> value(FLA_Obj s) { 
+        dcomplex *v = FLA_DOUBLE_COMPLEX_PTR( s );
+        return std::complex<double>(v->real, v->imag); 
+      }
+      static inline std::complex<double> conj(std::complex<double> v) { 
+        return std::conj(v); 
+      }
+    };
+
+    // --------------------------------------------------------------
+    // ** Column major view of a flat block
+    template<typename T> struct View_ {
+      T *a;
+      int m, n, cs;
+
+      View_(FLA_Obj A) : a((T*)FLA_Obj_buffer_at_view( A )),
+                         m(FLA_Obj_length( A )), 
+                         n(FLA_Obj_width( A )),
+                         cs(FLA_Obj_col_stride( A )) { 
+        assert(FLA_Obj_row_stride( A ) == 1);
+      }
+      inline T& operator()(int i, int j) const { return a[i + j*cs]; }
+    };
+
+    // ** op(A), no is true when a column of op(A) is contiguous
+    template<typename T, int Trans> struct Op_;
+
+    template<typename T> struct Op_<T,FLA_NO_TRANSPOSE> {
+      enum { no = true };
+      static inline int m(const View_<T> &A) { return A.m; }
+      static inline int n(const View_<T> &A) { return A.n; }
+      static inline T get(const View_<T> &A, int i, int j) { 
+        return A(i,j); 
+      }
+    };
+    template<typename T> struct Op_<T,FLA_CONJ_NO_TRANSPOSE> {
+      enum { no = true };
+      static inline int m(const View_<T> &A) { return A.m; }
+      static inline int n(const View_<T> &A) { return A.n; }
+      static inline T get(const View_<T> &A, int i, int j) { 
+        return Type_<T>::conj(A(i,j)); 
+      }
+    };
+    template<typename T> struct Op_<T,FLA_TRANSPOSE> {
+      enum { no = false };
+      static inline int m(const View_<T> &A) { return A.n; }
+      static inline int n(const View_<T> &A) { return A.m; }
+      static inline T get(const View_<T> &A, int i, int j) { 
+        return A(j,i); 
+      }
+    };
+    template<typename T> struct Op_<T,FLA_CONJ_TRANSPOSE> {
+      enum { no = false };
+      static inline int m(const View_<T> &A) { return A.n; }
+      static inline int n(const View_<T> &A) { return A.m; }
+      static inline T get(const View_<T> &A, int i, int j) { 
+        return Type_<T>::conj(A(j,i)); 
+      }
+    };
+
+    // --------------------------------------------------------------
+    // ** C = alpha op(A) op(B) + beta C
+    template<typename T, int TransA, int TransB> struct Gemm_ {
+      static void run(T alpha, const View_<T> &A, const View_<T> &B, 
+                      T beta, const View_<T> &C) {
+        typedef Op_<T,TransA> OpA;
+        typedef Op_<T,TransB> OpB;
+
+        int m = C.m, n = C.n, k = OpA::n(A);
+        const T zero = T(0), one = T(1);
+
+        for (int j=0;j<n;++j) {
+          T *c = &C(0,j);
+          if (OpA::no) {
+            // ** axpy form, columns of A are contiguous
+            if (beta == zero)     for (int i=0;i<m;++i) c[i] = zero;
+            else if (beta != one) for (int i=0;i<m;++i) c[i] *= beta;
+
+            for (int p=0;p<k;++p) {
+              T b = alpha*OpB::get(B,p,j);
+              for (int i=0;i<m;++i) 
+                c[i] += OpA::get(A,i,p)*b;
+            }
+          } else {
+            // ** dot form, rows of op(A) are contiguous
+            for (int i=0;i<m;++i) {
+              T s = zero;
+              for (int p=0;p<k;++p) 
+                s += OpA::get(A,i,p)*OpB::get(B,p,j);
+              c[i] = alpha*s + (beta == zero ? zero : beta*c[i]);
+            }
+          }
+        }
+      }
+    };
+
+    // ** double and double complex use the packed simd micro kernels
+    template<int TransA, int TransB> struct Packed_ {
+      static void run(int is_complex, const double *alpha, 
+                      const double *a, int cs_a, 
+                      const double *b, int cs_b, const double *beta, 
+                      double *c, int m, int n, int k, int cs_c) {
+        enum { 
+          no_a   = Op_<double,TransA>::no, 
+          no_b   = Op_<double,TransB>::no,
+          conj_a = (TransA == FLA_CONJ_TRANSPOSE || 
+                    TransA == FLA_CONJ_NO_TRANSPOSE),
+          conj_b = (TransB == FLA_CONJ_TRANSPOSE || 
+                    TransB == FLA_CONJ_NO_TRANSPOSE) 
+        };
+        gemm_kernel_packed( is_complex, conj_a, conj_b, m, n, k, alpha,
+                            a, (no_a ? 1 : cs_a), (no_a ? cs_a : 1),
+                            b, (no_b ? 1 : cs_b), (no_b ? cs_b : 1),
+                            beta, c, 1, cs_c );
+      }
+    };
+    template<int TransA, int TransB> struct Gemm_<double,TransA,TransB> {
+      static void run(double alpha, const View_<double> &A, 
+                      const View_<double> &B, 
+                      double beta, const View_<double> &C) {
+        double al[2] = { alpha, 0.0 }, be[2] = { beta, 0.0 };
+        Packed_<TransA,TransB>::run( false, al, A.a, A.cs, B.a, B.cs, be,
+                                     C.a, C.m, C.n, 
+                                     Op_<double,TransA>::n(A), C.cs );
+      }
+    };
+    template<int TransA, int TransB> 
+    struct Gemm_<std::complex<double>,TransA,TransB> {
+      typedef std::complex<double> T;
+      static void run(T alpha, const View_<T> &A, const View_<T> &B,
+                      T beta, const View_<T> &C) {
+        double al[2] = { alpha.real(), alpha.imag() }, 
+               be[2] = { beta.real(),  beta.imag()  };
+        Packed_<TransA,TransB>::run( true, al, 
+                                     (double*)A.a, A.cs, 
+                                     (double*)B.a, B.cs, be,
+                                     (double*)C.a, C.m, C.n, 
+                                     Op_<T,TransA>::n(A), C.cs );
+      }
+    };
+
+    // --------------------------------------------------------------
+    // ** B = alpha inv(op(A)) B or alpha B inv(op(A))
+    template<typename T, int Side, int Uplo, int Trans, int Diag> 
+    struct Trsm_ {
+      static void run(T alpha, const View_<T> &A, const View_<T> &B) {
+        typedef Op_<T,Trans> OpA;
+        enum { 
+          lower = ((Uplo == FLA_LOWER_TRIANGULAR) == (bool)OpA::no),
+          unit  = (Diag == FLA_UNIT_DIAG) 
+        };
+
+        int m = B.m, n = B.n;
+        const T one = T(1);
+
+        if (alpha != one) 
+          for (int j=0;j<n;++j) {
+            T *b = &B(0,j);
+            for (int i=0;i<m;++i) b[i] *= alpha;
+          }
+
+        if (Side == FLA_LEFT) {
+          for (int j=0;j<n;++j) {
+            T *b = &B(0,j);
+            if (OpA::no) {
+              // ** axpy form
+              if (lower) {
+                for (int p=0;p<m;++p) {
+                  if (!unit) b[p] /= OpA::get(A,p,p);
+                  T bp = b[p];
+                  for (int i=p+1;i<m;++i) b[i] -= OpA::get(A,i,p)*bp;
+                }
+              } else {
+                for (int p=m-1;p>=0;--p) {
+                  if (!unit) b[p] /= OpA::get(A,p,p);
+                  T bp = b[p];
+                  for (int i=0;i<p;++i) b[i] -= OpA::get(A,i,p)*bp;
+                }
+              }
+            } else {
+              // ** dot form
+              if (lower) {
+                for (int i=0;i<m;++i) {
+                  T s = b[i];
+                  for (int p=0;p<i;++p) s -= OpA::get(A,i,p)*b[p];
+                  b[i] = (unit ? s : s/OpA::get(A,i,i));
+                }
+              } else {
+                for (int i=m-1;i>=0;--i) {
+                  T s = b[i];
+                  for (int p=i+1;p<m;++p) s -= OpA::get(A,i,p)*b[p];
+                  b[i] = (unit ? s : s/OpA::get(A,i,i));
+                }
+              }
+            }
+          }
+        } else {
+          // ** columns of B are updated with columns of B, always axpy
+          for (int jj=0;jj<n;++jj) {
+            int j = (lower ? n-1-jj : jj);
+            T *b = &B(0,j);
+            if (lower) {
+              for (int p=j+1;p<n;++p) {
+                T a = OpA::get(A,p,j), *bp = &B(0,p);
+                for (int i=0;i<m;++i) b[i] -= bp[i]*a;
+              }
+            } else {
+              for (int p=0;p<j;++p) {
+                T a = OpA::get(A,p,j), *bp = &B(0,p);
+                for (int i=0;i<m;++i) b[i] -= bp[i]*a;
+              }
+            }
+            if (!unit) {
+              T d = one/OpA::get(A,j,j);
+              for (int i=0;i<m;++i) b[i] *= d;
+            }
+          }
+        }
+      }
+    };
+
+  }
+}
+
+#endif
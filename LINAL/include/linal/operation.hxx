@@ -151,6 +151,29 @@ namespace linal {
   extern int gemm_internal( int transa, int transb,
                             FLA_Obj alpha, FLA_Obj A, FLA_Obj B,
                             FLA_Obj beta,  FLA_Obj C );
+
+  // ** native packed kernel for small double blocks, used by gemm_internal
+  //    returns false when the block is not handled (type, size, threshold)
+  extern int  gemm_kernel( int transa, int transb,
+                           FLA_Obj alpha, FLA_Obj A, FLA_Obj B,
+                           FLA_Obj beta,  FLA_Obj C );
+  extern void set_gemm_kernel_threshold( int threshold );
+  extern int  get_gemm_kernel_threshold();
+  extern void set_gemm_kernel_isa( int isa );
+  extern int  get_gemm_kernel_isa();
+  extern void gemm_kernel_packed( int is_complex, int conj_a, int conj_b,
+                                  int m, int n, int k, const double *alpha,
+                                  const double *a, int rs_a, int cs_a,
+                                  const double *b, int rs_b, int cs_b,
+                                  const double *beta, 
+                                  double *c, int rs_c, int cs_c );
+
+  // ** dense gemm, syrk and trsm run the compile time specialized 
+  //    kernels of kernel.hxx on blocks up to the threshold, 0 is off
+  extern void set_typed_kernel_threshold( int threshold );
+  extern int  get_typed_kernel_threshold();
+  extern int  is_typed_kernel( Hier_ A );
+
   extern int trsm_internal( int side, int uplo, int trans, int diag,
                             FLA_Obj alpha, FLA_Obj A, FLA_Obj B );
   
@@ -163,6 +186,13 @@ namespace linal {
   extern double inv_norm1 ( int uplo, int diag, Flat_ A );  
   extern double inv_norm1 ( double sample, int uplo, int diag, Flat_ A );  
 
+  // ** recursive factorizations, halved down to the base size
+  extern int  chol_rec     ( int uplo, Flat_ A );
+  extern int  lu_nopiv_rec ( Flat_ A );
+  extern int  lu_piv_rec   ( Flat_ A, Flat_ p );
+  extern void set_recursive_base( int base );
+  extern int  get_recursive_base();
+
 
 
   // ----------------------------------------------------------------
@@ -180,6 +210,28 @@ namespace linal {
     extern int lu_nopiv    ( Hier_ A );
     extern int lu_incpiv   ( Hier_ A, Hier_ p );
     extern int lu_piv      ( Hier_ A, Hier_ p );
+
+    // ** recursive on the block grid, one block goes to the flat kernel
+    extern int chol_rec    ( int uplo, Hier_ A );
+    extern int lu_nopiv_rec( Hier_ A );
+    extern int lu_piv_rec  ( Hier_ A, Hier_ p );
+
+    // ** lookahead of one panel, depth block columns wide; chol,
+    //    lu_nopiv and lu_piv use it when set_lookahead is not 0 
+    //    ( default 0 ). depth > 1 only widens the panel, it is not
+    //    a lookahead of depth panels
+    extern int  chol_lookahead    ( int uplo, Hier_ A, int depth );
+    extern int  lu_nopiv_lookahead( Hier_ A, int depth );
+    extern int  lu_piv_lookahead  ( Hier_ A, Hier_ p, int depth );
+    extern void set_lookahead( int depth );
+    extern int  get_lookahead();
+
+    // ** tournament pivoting on panels of at least threshold block rows,
+    //    0 ( default ) keeps FLA_LU_piv on every panel
+    extern int  lu_piv_panel( Hier_ A, Hier_ p );
+    extern void set_lu_piv_panel_threshold( int threshold );
+    extern int  get_lu_piv_panel_threshold();
+
     extern int qr          ( Hier_ A, Hier_ T ); 
     extern int qr_inc      ( Hier_ A, Hier_ T ); 
     extern int qr_inc_var1 ( Hier_ A, Hier_ T ); 
@@ -187,6 +239,13 @@ namespace linal {
     extern int qr_var2     ( Hier_ A, Hier_ T ); 
     extern int qr2         ( Hier_ U, Hier_ D, Hier_ T ); 
 
+    // ** TSQR on panels of at least threshold block rows, 0 ( default )
+    //    keeps FLA_QR_UT on every panel; a panel whose T is not n x n
+    //    also falls back to FLA_QR_UT
+    extern int  qr_panel   ( Hier_ A, Hier_ T );
+    extern void set_qr_panel_threshold( int threshold );
+    extern int  get_qr_panel_threshold();
+
     extern int trmm        ( int side, int uplo, int trans, int diag,
                              FLA_Obj alpha, Hier_ A, Hier_ B );
     extern int trsm        ( int side, int uplo, int trans,
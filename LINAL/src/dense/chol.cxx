@@ -50,6 +50,10 @@ namespace linal {
       LINAL_ERROR(A.get_m() == A.get_n(),
                   ">> Hier_ A is not square matrix");
 
+      // ** panels of the lookahead are factored by this loop
+      if (get_lookahead() && A.get_m() > get_lookahead())
+        return chol_lookahead( uplo, A, get_lookahead() );
+
       FLA_Obj ATL,   ATR,      A00,  A01,  A02,
               ABL,   ABR,      A10,  A11,  A12,
                                A20,  A21,  A22;
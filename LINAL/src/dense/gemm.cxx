@@ -37,10 +37,66 @@
 #include "linal/flat.hxx"
 #include "linal/hier.hxx"
 #include "linal/operation.hxx"
-
+#include "linal/kernel.hxx"
 
 namespace linal {
   namespace dense {
+    // ** same task layout as below with the typed block kernel
+    template<typename T, int TransA, int TransB> 
+    static void gemm_typed_blocks( T alpha, Hier_ A, Hier_ B, 
+                                   T beta,  Hier_ C, int k ) {
+      for (int k2=0;k2<C.get_n();++k2) {
+        for (int k1=0;k1<C.get_m();++k1) {
+
+#pragma omp task firstprivate ( k1, k2 )
+          {
+            for (int p=0;p<k;++p) {
+              FLA_Obj &a = (TransA == FLA_NO_TRANSPOSE ? A(k1,p) : A(p,k1));
+              FLA_Obj &b = (TransB == FLA_NO_TRANSPOSE ? B(p,k2) : B(k2,p));
+              kernel::Gemm_<T,TransA,TransB>::run
+                ( alpha, kernel::View_<T>(a), kernel::View_<T>(b),
+                  (p ? T(1) : beta), kernel::View_<T>(C(k1,k2)) );
+            }
+          }
+        }
+      }
+#pragma omp taskwait
+    }
+
+    template<typename T, int TransA> 
+    static int gemm_typed_b( int transb, T alpha, Hier_ A, Hier_ B, 
+                             T beta, Hier_ C, int k ) {
+      switch (transb) {
+      case FLA_NO_TRANSPOSE:
+        gemm_typed_blocks<T,TransA,FLA_NO_TRANSPOSE>
+          ( alpha, A, B, beta, C, k ); break;
+      case FLA_TRANSPOSE:
+        gemm_typed_blocks<T,TransA,FLA_TRANSPOSE>
+          ( alpha, A, B, beta, C, k ); break;
+      case FLA_CONJ_TRANSPOSE:
+        gemm_typed_blocks<T,TransA,FLA_CONJ_TRANSPOSE>
+          ( alpha, A, B, beta, C, k ); break;
+      default: return false;
+      }
+      return true;
+    }
+
+    template<typename T> 
+    static int gemm_typed( int transa, int transb, 
+                           FLA_Obj alpha, Hier_ A, Hier_ B, 
+                           FLA_Obj beta,  Hier_ C, int k ) {
+      T al = kernel::Type_<T>::value( alpha ), be = kernel::Type_<T>::value( beta );
+      switch (transa) {
+      case FLA_NO_TRANSPOSE:
+        return gemm_typed_b<T,FLA_NO_TRANSPOSE>  ( transb, al, A, B, be, C, k );
+      case FLA_TRANSPOSE:
+        return gemm_typed_b<T,FLA_TRANSPOSE>     ( transb, al, A, B, be, C, k );
+      case FLA_CONJ_TRANSPOSE:
+        return gemm_typed_b<T,FLA_CONJ_TRANSPOSE>( transb, al, A, B, be, C, k );
+      }
+      return false;
+    }
+
     /*!
       General matrix matrix multiplication.
     */
@@ -55,83 +111,64 @@ namespace linal {
       // are allowed
 
       int val = transa*1000 + transb;
-      // Use GEPP algorithm (-- use block rank one update)
-      // scalar beta should be applied first otherwise sign is floping 
-      scal( beta, C );
-
       switch (val) {
-      case 400400:  // nt nt
-        for (int p=0;p<A.get_n();++p) {
-          for (int k2=0;k2<C.get_n();++k2) {
-            for (int k1=0;k1<C.get_m();++k1) {
-
-#pragma omp task firstprivate ( k1, k2, p )
-              {
-                gemm_internal( transa, transb,
-                               alpha,   A(k1,p), B(p,k2),
-                               FLA_ONE, C(k1,k2) );
-              }
-            }
-          }
-#pragma omp taskwait
-        }
-        break;
-      case 401401:  // t t
-      case 402402:  // conj_t conj_t
-        for (int p=0;p<A.get_m();++p) {
-          for (int k2=0;k2<C.get_n();++k2) {
-            for (int k1=0;k1<C.get_m();++k1) {
-
-#pragma omp task firstprivate ( k1, k2, p )
-              {
-                gemm_internal( transa, transb,
-                               alpha,   A(p,k1), B(k2,p),
-                               FLA_ONE, C(k1,k2) );
-              }
-            }
-          }
-#pragma omp taskwait
-        }
-        break;
-      case 400401:  // nt t                                       
-      case 400402:  // nt conj_t                                       
-        for (int p=0;p<A.get_n();++p) {
-          for (int k2=0;k2<C.get_n();++k2) {
-            for (int k1=0;k1<C.get_m();++k1) {
-
-#pragma omp task firstprivate ( k1, k2, p )
-              {
-                gemm_internal( transa, transb,
-                               alpha,   A(k1,p), B(k2,p),
-                               FLA_ONE, C(k1,k2) );
-              }
-            }
+      case 400400: case 401401: case 402402: 
+      case 400401: case 400402: case 401400: case 402400: break;
+      default: val = 0; break;
+      }
+      LINAL_ERROR(val,
+                  ">> Input trans arguement is invalid");
+
+      // ** inner dimension in blocks
+      int k = (transa == FLA_NO_TRANSPOSE ? A.get_n() : A.get_m());
+
+      // ** nothing to accumulate, C = beta C
+      if (!k) {
+        scal( beta, C );
+        return true;
+      }
+
+      // ** datatype and trans are resolved here once for small blocks
+      if (is_typed_kernel(A) && is_typed_kernel(B) && is_typed_kernel(C)) {
+        int datatype = C.get_data_type(), done = false;
+        if (A.get_data_type() == datatype && B.get_data_type() == datatype) {
+          switch (datatype) {
+          case FLA_FLOAT:
+            done = gemm_typed< float >
+              ( transa, transb, alpha, A, B, beta, C, k ); break;
+          case FLA_DOUBLE:
+            done = gemm_typed< double >
+              ( transa, transb, alpha, A, B, beta, C, k ); break;
+          case FLA_COMPLEX:
+            done = gemm_typed< std::complex<float> >
+              ( transa, transb, alpha, A, B, beta, C, k ); break;
+          case FLA_DOUBLE_COMPLEX:
+            done = gemm_typed< std::complex<double> >
+              ( transa, transb, alpha, A, B, beta, C, k ); break;
           }
-#pragma omp taskwait
         }
-        break;
-      case 401400:  // t nt                               
-      case 402400:  // conj_t nt                               
-        for (int p=0;p<A.get_m();++p) {
-          for (int k2=0;k2<C.get_n();++k2) {
-            for (int k1=0;k1<C.get_m();++k1) {
-
-#pragma omp task firstprivate ( k1, k2, p )
-              {
-                gemm_internal( transa, transb,
-                               alpha,   A(p,k1), B(p,k2),
-                               FLA_ONE, C(k1,k2) );
-              }
+        if (done) return true;
+      }
+
+      // ** one task owns C(k1,k2) and runs its whole k-loop, 
+      //    beta is folded into the first update so that there is
+      //    no separate scaling pass and no barrier between k steps
+      for (int k2=0;k2<C.get_n();++k2) {
+        for (int k1=0;k1<C.get_m();++k1) {
+
+#pragma omp task firstprivate ( k1, k2 )
+          {
+            for (int p=0;p<k;++p) {
+              FLA_Obj &a = (transa == FLA_NO_TRANSPOSE ? A(k1,p) : A(p,k1));
+              FLA_Obj &b = (transb == FLA_NO_TRANSPOSE ? B(p,k2) : B(k2,p));
+              gemm_internal( transa, transb,
+                             alpha, a, b,
+                             (p ? FLA_ONE : beta), C(k1,k2) );
             }
           }
-#pragma omp taskwait
         }
-        break;
-      default: val = 0; break;
       }
-
-      LINAL_ERROR(val,
-                  ">> Input trans arguement is invalid");
+#pragma omp taskwait
 
       return true;
     }
@@ -0,0 +1,323 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+namespace linal {
+  namespace dense {
+    /*!
+      Right-looking factorizations with lookahead.
+
+      The panel is depth block columns wide. After a panel is factored,
+      its update of the next depth block columns is applied and the next
+      panel is factored in one task, while the update of the remaining
+      columns runs in another task. The next panel is then ready when
+      the trailing update finishes, instead of waiting for it.
+
+      Only one panel is ahead of the trailing update at any time, so
+      depth > 1 widens the panel and is not a depth-k lookahead. The
+      default depth is 0, which keeps the plain loops.
+    */
+
+    static int lookahead = LINAL_LOOKAHEAD;
+
+    void set_lookahead( int depth ) { lookahead = (depth > 0 ? depth : 0); }
+    int  get_lookahead() { return lookahead; }
+
+    // ** A is the trailing matrix, factor its first w block columns 
+    //    (rows for upper)
+    static int chol_lookahead_panel(int uplo, Hier_ A, int w) {
+      int n = A.get_m();
+
+      Hier_ A_11;
+      A.extract( A_11, w, w, 0, 0 );
+      chol( uplo, A_11 );
+
+      if (n == w) return true;
+
+      Hier_ A_12, A_21;
+      switch (uplo) {
+      case LINAL_UPPER_TRIANGULAR:
+        A.extract( A_12, w, n-w, 0, w );
+        trsm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE,
+              FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_12 );
+        break;
+      case LINAL_LOWER_TRIANGULAR:
+        A.extract( A_21, n-w, w, w, 0 );
+        trsm( FLA_RIGHT, FLA_LOWER_TRIANGULAR, FLA_TRANSPOSE,
+              FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_21 );
+        break;
+      }
+      return true;
+    }
+
+    int chol_lookahead(int uplo, Hier_ A, int depth) {
+      if (!A.get_m()) return true;
+      LINAL_ERROR(A.get_m() == A.get_n(),
+                  ">> Hier_ A is not square matrix");
+      assert(depth > 0);
+
+      int n = A.get_m();
+      chol_lookahead_panel( uplo, A, min(depth, n) );
+
+      for (int j=0;j<n;j+=depth) {
+        int w = min(depth, n-j), r = n-j-w;
+        if (!r) break;
+        int v = min(depth, r);
+
+        // ** P : factored panel, N : next v block columns, F : the rest
+        Hier_ P_N, P_F, T, T_NN, T_NF, T_FF;
+        A.extract( T,    r,   r,   j+w,   j+w   );
+        A.extract( T_NN, v,   v,   j+w,   j+w   );
+
+        switch (uplo) {
+        case LINAL_UPPER_TRIANGULAR:
+          A.extract( P_N,  w, v,   j,   j+w   );
+          A.extract( P_F,  w, r-v, j,   j+w+v );
+          A.extract( T_NF, v, r-v, j+w, j+w+v );
+          A.extract( T_FF, r-v, r-v, j+w+v, j+w+v );
+
+#pragma omp task firstprivate( uplo, v, P_N, P_F, T, T_NN, T_NF )
+          {
+            syrk( FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE, FLA_MINUS_ONE,
+                  P_N, FLA_ONE, T_NN );
+            if (T_NF.get_n()) 
+              gemm( FLA_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                    P_N, P_F, FLA_ONE, T_NF );
+            chol_lookahead_panel( uplo, T, v );
+          }
+          if (T_FF.get_n()) {
+#pragma omp task firstprivate( P_F, T_FF )
+            syrk( FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE, FLA_MINUS_ONE,
+                  P_F, FLA_ONE, T_FF );
+          }
+          break;
+        case LINAL_LOWER_TRIANGULAR:
+          A.extract( P_N,  v,   w, j+w,   j );
+          A.extract( P_F,  r-v, w, j+w+v, j );
+          A.extract( T_NF, r-v, v, j+w+v, j+w );
+          A.extract( T_FF, r-v, r-v, j+w+v, j+w+v );
+
+#pragma omp task firstprivate( uplo, v, P_N, P_F, T, T_NN, T_NF )
+          {
+            syrk( FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                  P_N, FLA_ONE, T_NN );
+            if (T_NF.get_m()) 
+              gemm( FLA_NO_TRANSPOSE, FLA_TRANSPOSE, FLA_MINUS_ONE,
+                    P_F, P_N, FLA_ONE, T_NF );
+            chol_lookahead_panel( uplo, T, v );
+          }
+          if (T_FF.get_m()) {
+#pragma omp task firstprivate( P_F, T_FF )
+            syrk( FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                  P_F, FLA_ONE, T_FF );
+          }
+          break;
+        }
+
+#pragma omp taskwait
+
+      }
+      return true;
+    }
+
+    // ** A is the trailing matrix, factor its first w block columns, 
+    //    the U part right of the panel is left to the update
+    static int lu_nopiv_lookahead_panel(Hier_ A, int w) {
+      int n = A.get_m();
+
+      Hier_ A_11, A_21;
+      A.extract( A_11, w, w, 0, 0 );
+      lu_nopiv( A_11 );
+
+      if (n == w) return true;
+
+      A.extract( A_21, n-w, w, w, 0 );
+      trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+            FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_21 );
+
+      return true;
+    }
+
+    int lu_nopiv_lookahead(Hier_ A, int depth) {
+      if (!A.get_m()) return true;
+      assert(A.get_m() == A.get_n());
+      assert(depth > 0);
+
+      int n = A.get_m();
+      lu_nopiv_lookahead_panel( A, min(depth, n) );
+
+      for (int j=0;j<n;j+=depth) {
+        int w = min(depth, n-j), r = n-j-w;
+        if (!r) break;
+        int v = min(depth, r);
+
+        Hier_ A_11, A_21, A_1N, A_1F, T, T_N, T_F;
+        A.extract( A_11, w, w,   j,   j     );
+        A.extract( A_21, r, w,   j+w, j     );
+        A.extract( A_1N, w, v,   j,   j+w   );
+        A.extract( A_1F, w, r-v, j,   j+w+v );
+        A.extract( T,    r, r,   j+w, j+w   );
+        A.extract( T_N,  r, v,   j+w, j+w   );
+        A.extract( T_F,  r, r-v, j+w, j+w+v );
+
+#pragma omp task firstprivate( v, A_11, A_21, A_1N, T, T_N )
+        {
+          trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                FLA_UNIT_DIAG, FLA_ONE, A_11, A_1N );
+          gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                A_21, A_1N, FLA_ONE, T_N );
+          lu_nopiv_lookahead_panel( T, v );
+        }
+        if (T_F.get_n()) {
+#pragma omp task firstprivate( A_11, A_21, A_1F, T_F )
+          {
+            trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                  FLA_UNIT_DIAG, FLA_ONE, A_11, A_1F );
+            gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                  A_21, A_1F, FLA_ONE, T_F );
+          }
+        }
+
+#pragma omp taskwait
+
+      }
+      return true;
+    }
+
+    // ** A is m x w blocks with m >= w, p has w blocks; the pivots are
+    //    applied within the panel only
+    static int lu_piv_lookahead_panel(Hier_ A, Hier_ p) {
+      int m = A.get_m(), w = A.get_n();
+
+      for (int c=0;c<w;++c) {
+        Hier_ A_1, p_1;
+        A.extract( A_1, m-c, 1, c, c );
+        p.extract( p_1, 1,   1, c, 0 );
+        lu_piv_panel( A_1, p_1 );
+
+        if (c) {
+          Hier_ A_L;
+          A.extract( A_L, m-c, c, c, 0 );
+          apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_L );
+        }
+        if (c+1 < w) {
+          Hier_ A_R, A_11, A_12, A_21, A_22;
+          A.extract( A_R,  m-c,   w-c-1, c,   c+1 );
+          A.extract( A_11, 1,     1,     c,   c   );
+          A.extract( A_12, 1,     w-c-1, c,   c+1 );
+          A.extract( A_21, m-c-1, 1,     c+1, c   );
+          A.extract( A_22, m-c-1, w-c-1, c+1, c+1 );
+
+          apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_R );
+          trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                FLA_UNIT_DIAG, FLA_ONE, A_11, A_12 );
+          gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                A_21, A_12, FLA_ONE, A_22 );
+        }
+      }
+      return true;
+    }
+
+    int lu_piv_lookahead(Hier_ A, Hier_ p, int depth) {
+      if (!A.get_m() || !A.get_n()) return true;
+      assert(A.get_m()==A.get_n());
+      assert(depth > 0);
+
+      int n = A.get_m();
+      {
+        Hier_ A_P, p_P;
+        A.extract( A_P, n, min(depth, n), 0, 0 );
+        p.extract( p_P, min(depth, n), 1, 0, 0 );
+        lu_piv_lookahead_panel( A_P, p_P );
+      }
+
+      for (int j=0;j<n;j+=depth) {
+        int w = min(depth, n-j), r = n-j-w;
+        int v = min(depth, r);
+
+        Hier_ p_1, A_L;
+        p.extract( p_1, w, 1, j, 0 );
+
+        // ** pivots of the panel on the columns left of it
+        if (j) {
+          A.extract( A_L, n-j, j, j, 0 );
+#pragma omp task firstprivate( p_1, A_L )
+          apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_L );
+        }
+
+        if (r) {
+          Hier_ A_11, A_21, A_N, A_F, A_1N, A_1F, T_N, T_F, p_N;
+          A.extract( A_11, w,   w,   j,   j     );
+          A.extract( A_21, r,   w,   j+w, j     );
+          A.extract( A_N,  n-j, v,   j,   j+w   );
+          A.extract( A_1N, w,   v,   j,   j+w   );
+          A.extract( T_N,  r,   v,   j+w, j+w   );
+          A.extract( A_F,  n-j, r-v, j,   j+w+v );
+          A.extract( A_1F, w,   r-v, j,   j+w+v );
+          A.extract( T_F,  r,   r-v, j+w, j+w+v );
+          p.extract( p_N,  v,   1,   j+w, 0     );
+
+#pragma omp task firstprivate( p_1, A_11, A_21, A_N, A_1N, T_N, p_N )
+          {
+            apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_N );
+            trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                  FLA_UNIT_DIAG, FLA_ONE, A_11, A_1N );
+            gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                  A_21, A_1N, FLA_ONE, T_N );
+            lu_piv_lookahead_panel( T_N, p_N );
+          }
+          if (A_F.get_n()) {
+#pragma omp task firstprivate( p_1, A_11, A_21, A_F, A_1F, T_F )
+            {
+              apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_F );
+              trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                    FLA_UNIT_DIAG, FLA_ONE, A_11, A_1F );
+              gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                    A_21, A_1F, FLA_ONE, T_F );
+            }
+          }
+        }
+
+#pragma omp taskwait
+
+      }
+      return true;
+    }
+  }
+}
@@ -105,6 +105,10 @@ namespace linal {
       if (!A.get_m()) return true;
       assert(A.get_m() == A.get_n());
 
+      // ** panels of the lookahead are factored by this loop
+      if (get_lookahead() && A.get_m() > get_lookahead())
+        return lu_nopiv_lookahead( A, get_lookahead() );
+
       FLA_Obj ATL,   ATR,      A00,  A01,  A02,
               ABL,   ABR,      A10,  A11,  A12,
                                A20,  A21,  A22;
@@ -48,6 +48,9 @@ namespace linal {
       if (!A.get_m() || !A.get_n()) return true;
       assert(A.get_m()==A.get_n());
 
+      if (get_lookahead() && A.get_m() > get_lookahead())
+        return lu_piv_lookahead( A, p, get_lookahead() );
+
       FLA_Obj ATL,   ATR,      A00,  A01,  A02,
         ABL,   ABR,      A10,  A11,  A12,
         A20,  A21,  A22;
@@ -76,7 +79,7 @@ namespace linal {
         FLA_Merge_2x1( A12,
                        A22, &AB2 );
         Hier_ AB_0(AB0), AB_1(AB1), AB_2(AB2), p_1(p1);
-        FLA_LU_piv( ~(AB_1.flat()), p_1(0,0) );
+        lu_piv_panel( AB_1, p_1 );
 
 
 #pragma omp task firstprivate( p_1, AB_0 )
@@ -0,0 +1,159 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+namespace linal {
+  namespace dense {
+
+    /*!
+      Tournament pivoting for a block column ( CALU ).
+
+      Each block row of the panel selects its n candidate rows with
+      FLA_LU_piv on a copy. Candidates are paired up in a binary tree,
+      the stacked original rows are factored again and the winners go
+      up. The final rows are swapped to the top, recorded in p as
+      FLAME relative pivots, and the panel is factored without
+      pivoting. Panels with fewer block rows than the threshold use
+      FLA_LU_piv as before; the default threshold 0 turns it off.
+    */
+
+    static int lu_piv_panel_threshold = LINAL_LU_PIV_PANEL_THRESHOLD;
+
+    void set_lu_piv_panel_threshold( int threshold ) {
+      lu_piv_panel_threshold = threshold;
+    }
+    int  get_lu_piv_panel_threshold() { 
+      return lu_piv_panel_threshold; 
+    }
+
+    // ** keep the rows of P (indexed by rows) that GEPP picks first
+    static void lu_piv_panel_select( FLA_Obj P, std::vector<int> &rows ) {
+      int k  = rows.size(), n = FLA_Obj_width( P );
+      int mn = min( k, n );
+
+      int    es   = FLA_Obj_datatype_size( FLA_Obj_datatype( P ) );
+      int    ld_p = FLA_Obj_col_stride( P );
+      char  *buf  = (char*)FLA_Obj_buffer_at_view( P );
+
+      Flat_ W, w;
+      W.create( FLA_Obj_datatype( P ), k, n );
+      w.create( LINAL_INT, mn, 1 );
+
+      int    ld_w = FLA_Obj_col_stride( ~W );
+      char  *wbuf = (char*)FLA_Obj_buffer_at_view( ~W );
+
+      for (int j=0;j<n;++j)
+        for (int i=0;i<k;++i)
+          memcpy( wbuf + (i + j*ld_w)*es, buf + (rows[i] + j*ld_p)*es, es );
+
+      FLA_LU_piv( ~W, ~w );
+
+      int *piv = (int*)FLA_Obj_buffer_at_view( ~w );
+      for (int i=0;i<mn;++i) 
+        std::swap( rows[i], rows[i + piv[i]] );
+      rows.resize( mn );
+
+      w.free();
+      W.free();
+    }
+
+    int lu_piv_panel( Hier_ A, Hier_ p ) {
+      FLA_Obj P = ~(A.flat());
+      int m = FLA_Obj_length( P ), n = FLA_Obj_width( P );
+      
+      if (lu_piv_panel_threshold <= 0 || 
+          A.get_m() < lu_piv_panel_threshold || m <= n) {
+        FLA_LU_piv( P, p(0,0) );
+        return true;
+      }
+
+      // ** leaves, one per block row
+      int nl = A.get_m();
+      std::vector< std::vector<int> > cand( nl );
+      for (int i=0, offm=0;i<nl;++i) {
+        int mi = FLA_Obj_length( A(i,0) );
+        for (int r=0;r<mi;++r) 
+          cand[i].push_back( offm + r );
+        offm += mi;
+
+#pragma omp task firstprivate( P, i ) shared( cand )
+        lu_piv_panel_select( P, cand[i] );
+      }
+#pragma omp taskwait
+
+      // ** reduction tree
+      for (int s=1;s<nl;s*=2) {
+        for (int i=0;i+s<nl;i+=2*s) {
+#pragma omp task firstprivate( P, i, s ) shared( cand )
+          {
+            cand[i].insert( cand[i].end(), cand[i+s].begin(), cand[i+s].end() );
+            lu_piv_panel_select( P, cand[i] );
+          }
+        }
+#pragma omp taskwait
+      }
+
+      // ** winners to relative pivots, row at position k goes to k
+      std::vector<int> row( m ), pos( m );
+      for (int i=0;i<m;++i) 
+        row[i] = pos[i] = i;
+
+      int *piv = (int*)FLA_Obj_buffer_at_view( p(0,0) );
+      for (int k=0;k<n;++k) {
+        int r = cand[0][k], q = pos[r];
+        piv[k] = q - k;
+
+        std::swap( row[k], row[q] );
+        pos[row[k]] = k;
+        pos[row[q]] = q;
+      }
+      FLA_Apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p(0,0), P );
+
+      // ** factor the permuted panel without pivoting
+      FLA_Obj PT, PB;
+      FLA_Part_2x1( P, &PT,
+                       &PB, n, FLA_TOP );
+      FLA_LU_nopiv( PT );
+      FLA_Trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                FLA_NONUNIT_DIAG, FLA_ONE, PT, PB );
+
+      return true;
+    }
+  }
+}
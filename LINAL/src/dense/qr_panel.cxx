@@ -0,0 +1,323 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+#include <complex>
+
+namespace linal {
+  namespace dense {
+
+    /*!
+      TSQR for a block column.
+
+      Each block row of the panel is a leaf factored in place with
+      FLA_QR_UT. The R factors are stacked pairwise and factored again
+      up a binary tree. Going down the tree the explicit Q ( m x n ) is
+      formed in the panel. Householder vectors Y and T in the UT form
+      used by apply_q are then reconstructed from Q ( Ballard et al. ):
+      
+        Q1 - S = Y1 U,  Y2 = Q2 inv(U),  T = -Y1^H S inv(U),  R := S R
+
+      S is the diagonal of sign( -diag ) chosen while factoring Q1, so
+      the reconstruction is stable. Panels with fewer block rows than
+      the threshold, or whose T is not n x n, use FLA_QR_UT as before;
+      the default threshold 0 turns it off.
+    */
+
+    static int qr_panel_threshold = LINAL_QR_PANEL_THRESHOLD;
+
+    void set_qr_panel_threshold( int threshold ) {
+      qr_panel_threshold = threshold;
+    }
+    int  get_qr_panel_threshold() { 
+      return qr_panel_threshold; 
+    }
+
+    // ** Q1 - S = Y1 U without pivoting, s is chosen at each step
+    template<class T_>
+    static void qr_panel_lu_sign( int n, T_ *a, int lda, T_ *s, int lds ) {
+      for (int k=0;k<n;++k) {
+        T_ &d = a[k + k*lda];
+        double abs_d = std::abs( d );
+        s[k + k*lds] = ( abs_d > 0.0 ? -d/abs_d : T_(-1.0) );
+        d -= s[k + k*lds];
+
+        for (int i=k+1;i<n;++i) 
+          a[i + k*lda] /= d;
+
+        for (int j=k+1;j<n;++j)
+          for (int i=k+1;i<n;++i) 
+            a[i + j*lda] -= a[i + k*lda]*a[k + j*lda];
+      }
+    }
+
+    int qr_panel( Hier_ A, Hier_ T ) {
+      FLA_Obj P = ~(A.flat());
+      int m = FLA_Obj_length( P ), n = FLA_Obj_width( P );
+      int datatype = FLA_Obj_datatype( P );
+
+      // ** the reconstructed T is n x n, FLA_QR_UT has the same layout
+      //    only when its block size is the panel width; other T are
+      //    left to FLA_QR_UT
+      if (qr_panel_threshold <= 0 || 
+          A.get_m() < qr_panel_threshold || m < 2*n ||
+          ( datatype != LINAL_REAL && datatype != LINAL_COMPLEX ) ||
+          FLA_Obj_length( ~(T.flat()) ) != n || 
+          FLA_Obj_width( ~(T.flat()) )  != n) {
+        FLA_QR_UT( P, ~(T.flat()) );
+        return true;
+      }
+
+      // ** leaves, block rows merged to have at least n rows
+      std::vector<int> offm;
+      for (int i=0, offs=0;i<A.get_m();++i) {
+        int mi = FLA_Obj_length( A(i,0) );
+        if (offm.empty() || offs - offm.back() >= n)
+          offm.push_back( offs );
+        offs += mi;
+      }
+      if (m - offm.back() < n) 
+        offm.pop_back();
+      offm.push_back( m );
+
+      int nl = offm.size() - 1;
+      if (nl < 2) {
+        FLA_QR_UT( P, ~(T.flat()) );
+        return true;
+      }
+
+      std::vector<FLA_Obj> leaf( nl ), R( nl );
+      std::vector<Flat_>   leaf_T( nl );
+      for (int i=0;i<nl;++i) {
+        FLA_Obj PT, PB, P0, P1, P2;
+        FLA_Part_2x1( P, &PT, 
+                         &PB, offm[i], FLA_TOP );
+        FLA_Part_2x1( PB, &P1, 
+                          &P2, offm[i+1]-offm[i], FLA_TOP );
+        leaf[i] = P1;
+        leaf_T[i].create( datatype, n, n );
+
+        FLA_Part_2x1( P1, &R[i], 
+                          &P0, n, FLA_TOP );
+
+#pragma omp task firstprivate( i ) shared( leaf, leaf_T )
+        FLA_QR_UT( leaf[i], ~leaf_T[i] );
+      }
+#pragma omp taskwait
+
+      // ** reduction tree, node factors [ R_i; R_i+s ]
+      std::vector< std::vector<int> > pair;
+      std::vector< std::vector<Flat_> > node, node_T;
+      for (int s=1;s<nl;s*=2) {
+        int l = pair.size();
+        pair.push_back( std::vector<int>() );
+        for (int i=0;i+s<nl;i+=2*s)
+          pair[l].push_back( i );
+
+        node.push_back( std::vector<Flat_>( pair[l].size() ) );
+        node_T.push_back( std::vector<Flat_>( pair[l].size() ) );
+
+        for (int k=0;k<pair[l].size();++k) {
+          int i = pair[l][k];
+          node[l][k].create( datatype, 2*n, n );
+          node_T[l][k].create( datatype, n, n );
+
+#pragma omp task firstprivate( i, k, l, s ) shared( node, node_T, R )
+          {
+            FLA_Obj NT, NB;
+            FLA_Part_2x1( ~node[l][k], &NT, 
+                                       &NB, n, FLA_TOP );
+            FLA_Set( FLA_ZERO, ~node[l][k] );
+            FLA_Copyr( FLA_UPPER_TRIANGULAR, R[i],   NT );
+            FLA_Copyr( FLA_UPPER_TRIANGULAR, R[i+s], NB );
+
+            FLA_QR_UT( ~node[l][k], ~node_T[l][k] );
+            R[i] = NT;
+          }
+        }
+#pragma omp taskwait
+      }
+
+      // ** keep R before the panel is overwritten by Q
+      Flat_ S, Rs;
+      S.create( datatype, n, n );
+      Rs.create( datatype, n, n );
+      FLA_Set( FLA_ZERO, ~S );
+      FLA_Set( FLA_ZERO, ~Rs );
+      FLA_Copyr( FLA_UPPER_TRIANGULAR, R[0], ~Rs );
+
+      // ** explicit Q, C_i is the n x n block passed down to leaf i
+      std::vector<Flat_> C( nl );
+      C[0].create( datatype, 2*n, n );
+      FLA_Set( FLA_ZERO, ~C[0] );
+      {
+        FLA_Obj CT, CB;
+        FLA_Part_2x1( ~C[0], &CT, 
+                             &CB, n, FLA_TOP );
+        FLA_Set_to_identity( CT );
+      }
+      
+      for (int l=pair.size()-1, s=(1<<l);l>=0;--l, s/=2) {
+        for (int k=0;k<pair[l].size();++k) {
+          int i = pair[l][k];
+          C[i+s].create( datatype, 2*n, n );
+          
+#pragma omp task firstprivate( i, k, l, s ) shared( node, node_T, C )
+          {
+            Flat_ W;
+            W.create( datatype, n, n );
+            FLA_Apply_Q_UT( FLA_LEFT, FLA_NO_TRANSPOSE, 
+                            FLA_FORWARD, FLA_COLUMNWISE,
+                            ~node[l][k], ~node_T[l][k], ~W, ~C[i] );
+            W.free();
+
+            // bottom half goes to the right child, top half stays
+            FLA_Obj CT, CB, DT, DB;
+            FLA_Part_2x1( ~C[i],   &CT, 
+                                   &CB, n, FLA_TOP );
+            FLA_Part_2x1( ~C[i+s], &DT, 
+                                   &DB, n, FLA_TOP );
+            FLA_Copy( CB, DT );
+            FLA_Set( FLA_ZERO, CB );
+            FLA_Set( FLA_ZERO, DB );
+          }
+        }
+#pragma omp taskwait
+      }
+
+      // ** leaf rows of Q overwrite the leaf in the panel
+      for (int i=0;i<nl;++i) {
+#pragma omp task firstprivate( i ) shared( leaf, leaf_T, C )
+        {
+          int mi = FLA_Obj_length( leaf[i] );
+
+          Flat_ B, W;
+          B.create( datatype, mi, n );
+          W.create( datatype, n, n );
+          
+          FLA_Obj BT, BB, CT, CB;
+          FLA_Part_2x1( ~B,    &BT, 
+                               &BB, n, FLA_TOP );
+          FLA_Part_2x1( ~C[i], &CT, 
+                               &CB, n, FLA_TOP );
+          FLA_Set( FLA_ZERO, BB );
+          FLA_Copy( CT, BT );
+
+          FLA_Apply_Q_UT( FLA_LEFT, FLA_NO_TRANSPOSE, 
+                          FLA_FORWARD, FLA_COLUMNWISE,
+                          leaf[i], ~leaf_T[i], ~W, ~B );
+          FLA_Copy( ~B, leaf[i] );
+
+          W.free();
+          B.free();
+        }
+      }
+#pragma omp taskwait
+
+      // ** Householder reconstruction
+      FLA_Obj Q1, Q2;
+      FLA_Part_2x1( P, &Q1, 
+                       &Q2, n, FLA_TOP );
+
+      int lda = FLA_Obj_col_stride( Q1 ), lds = FLA_Obj_col_stride( ~S );
+      switch (datatype) {
+      case LINAL_REAL:
+        qr_panel_lu_sign( n, 
+                          (double*)FLA_Obj_buffer_at_view( Q1 ), lda, 
+                          (double*)FLA_Obj_buffer_at_view( ~S ), lds );
+        break;
+      case LINAL_COMPLEX:
+        qr_panel_lu_sign( n, 
+                          (std::complex<double>*)FLA_Obj_buffer_at_view( Q1 ), lda,
+                          (std::complex<double>*)FLA_Obj_buffer_at_view( ~S ), lds );
+        break;
+      }
+
+      // Y2 = Q2 inv(U) by leaves
+      for (int i=0;i<nl;++i) {
+        FLA_Obj Y;
+        if (i) {
+          Y = leaf[i];
+        } else {
+          FLA_Obj Y0;
+          FLA_Part_2x1( leaf[0], &Y0, 
+                                 &Y, n, FLA_TOP );
+        }
+        if (!FLA_Obj_length( Y )) continue;
+
+#pragma omp task firstprivate( Y, Q1 )
+        FLA_Trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, 
+                  FLA_NO_TRANSPOSE, FLA_NONUNIT_DIAG,
+                  FLA_ONE, Q1, Y );
+      }
+
+      // T = -Y1^H S inv(U)
+      FLA_Obj T_flat = ~(T.flat());
+      FLA_Copy( ~S, T_flat );
+      FLA_Trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, 
+                FLA_NO_TRANSPOSE, FLA_NONUNIT_DIAG,
+                FLA_ONE, Q1, T_flat );
+      FLA_Trmm( FLA_LEFT, FLA_LOWER_TRIANGULAR, 
+                FLA_CONJ_TRANSPOSE, FLA_UNIT_DIAG,
+                FLA_MINUS_ONE, Q1, T_flat );
+
+#pragma omp taskwait
+
+      // R := S R on the upper triangle of the panel
+      FLA_Trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, 
+                FLA_NO_TRANSPOSE, FLA_NONUNIT_DIAG,
+                FLA_ONE, ~S, ~Rs );
+      FLA_Copyr( FLA_UPPER_TRIANGULAR, ~Rs, Q1 );
+
+      for (int i=0;i<nl;++i) 
+        C[i].free();
+      for (int l=0;l<node.size();++l)
+        for (int k=0;k<node[l].size();++k) {
+          node[l][k].free();
+          node_T[l][k].free();
+        }
+      for (int i=0;i<nl;++i) 
+        leaf_T[i].free();
+      Rs.free();
+      S.free();
+
+      return true;
+    }
+  }
+}
@@ -78,7 +78,7 @@ namespace linal {
                        A21,   &AB1 );
 
         Hier_ AB_1(AB1);
-        FLA_QR_UT( ~AB_1.flat(), ~T_11.flat() );
+        qr_panel( AB_1, T_11 );
 
         if ( FLA_Obj_width( A12 ) > 0 )  {
           FLA_Obj AB2;
@@ -77,7 +77,7 @@ namespace linal {
                        A21,   &AB1 );
 
         Hier_ AB_1(AB1), T_1T(T1T);
-        FLA_QR_UT( ~AB_1.flat(), ~T_1T.flat() );
+        qr_panel( AB_1, T_1T );
 
         if ( FLA_Obj_width( A12 ) > 0 ) {
           FLA_Obj AB2;
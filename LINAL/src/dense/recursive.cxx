@@ -0,0 +1,159 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+namespace linal {
+  namespace dense {
+    /*!
+      Recursive factorizations on the block grid.
+
+      The blocks are halved until one block is left, which is factored
+      by the recursive flat kernel. The off diagonal halves are updated
+      by the hier trsm/syrk/gemm, which carry the parallelism.
+    */
+
+    int chol_rec(int uplo, Hier_ A) {
+      if (!A.get_m()) return true;
+      LINAL_ERROR(A.get_m() == A.get_n(),
+                  ">> Hier_ A is not square matrix");
+
+      int n = A.get_m(), k = n/2;
+      if (n == 1) 
+        return linal::chol_rec( uplo, Flat_(A(0,0)) );
+
+      Hier_ A_11, A_12, A_21, A_22;
+      A.extract( A_11, k,   k,   0, 0 );
+      A.extract( A_12, k,   n-k, 0, k );
+      A.extract( A_21, n-k, k,   k, 0 );
+      A.extract( A_22, n-k, n-k, k, k );
+
+      chol_rec( uplo, A_11 );
+
+      switch (uplo) {
+      case LINAL_UPPER_TRIANGULAR:
+        trsm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE,
+              FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_12 );
+
+        syrk( FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE, FLA_MINUS_ONE,
+              A_12, FLA_ONE, A_22 );
+        break;
+      case LINAL_LOWER_TRIANGULAR:
+        trsm( FLA_RIGHT, FLA_LOWER_TRIANGULAR, FLA_TRANSPOSE,
+              FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_21 );
+
+        syrk( FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+              A_21, FLA_ONE, A_22 );
+        break;
+      }
+
+      return chol_rec( uplo, A_22 );
+    }
+
+    int lu_nopiv_rec(Hier_ A) {
+      if (!A.get_m()) return true;
+      assert(A.get_m() == A.get_n());
+
+      int n = A.get_m(), k = n/2;
+      if (n == 1) 
+        return linal::lu_nopiv_rec( Flat_(A(0,0)) );
+
+      Hier_ A_11, A_12, A_21, A_22;
+      A.extract( A_11, k,   k,   0, 0 );
+      A.extract( A_12, k,   n-k, 0, k );
+      A.extract( A_21, n-k, k,   k, 0 );
+      A.extract( A_22, n-k, n-k, k, k );
+
+      lu_nopiv_rec( A_11 );
+
+#pragma omp task firstprivate( A_11, A_12 )
+      trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+            FLA_UNIT_DIAG, FLA_ONE, A_11, A_12 );
+      
+#pragma omp task firstprivate( A_11, A_21 )
+      trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+            FLA_NONUNIT_DIAG, FLA_ONE, A_11, A_21 );
+      
+#pragma omp taskwait
+      
+      gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+            A_21, A_12, FLA_ONE, A_22 );
+
+      return lu_nopiv_rec( A_22 );
+    }
+
+    // ** m x n blocks with m >= n, p has n blocks; halves the columns
+    static int lu_piv_rec_internal(Hier_ A, Hier_ p) {
+      int m = A.get_m(), n = A.get_n(), k = n/2;
+      if (n == 1) 
+        return lu_piv_panel( A, p );
+
+      Hier_ A_L, A_R, A_11, A_12, A_21, A_22, p_1, p_2;
+      A.extract( A_L,  m,   k,   0, 0 );
+      A.extract( A_R,  m,   n-k, 0, k );
+      A.extract( A_11, k,   k,   0, 0 );
+      A.extract( A_12, k,   n-k, 0, k );
+      A.extract( A_21, m-k, k,   k, 0 );
+      A.extract( A_22, m-k, n-k, k, k );
+      p.extract( p_1,  k,   1,   0, 0 );
+      p.extract( p_2,  n-k, 1,   k, 0 );
+
+      lu_piv_rec_internal( A_L, p_1 );
+
+      apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_1, A_R );
+
+      trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+            FLA_UNIT_DIAG, FLA_ONE, A_11, A_12 );
+
+      gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+            A_21, A_12, FLA_ONE, A_22 );
+
+      lu_piv_rec_internal( A_22, p_2 );
+
+      // pivots of the lower half are relative to its first row
+      return apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, p_2, A_21 );
+    }
+
+    int lu_piv_rec(Hier_ A, Hier_ p) {
+      if (!A.get_m() || !A.get_n()) return true;
+      assert(A.get_m()==A.get_n());
+
+      return lu_piv_rec_internal( A, p );
+    }
+  }
+}
@@ -37,14 +37,75 @@
 #include "linal/flat.hxx"
 #include "linal/hier.hxx"
 #include "linal/operation.hxx"
+#include "linal/kernel.hxx"
 
 namespace linal {
   namespace dense {
+    // ** nt_syrk and t_syrk with the typed block kernel, C(k1,k2) is
+    //    updated with op(A)(k1,p) op(A)(k2,p)^T
+    template<typename T, int TransA, int TransB> 
+    static void syrk_typed_blocks( int uplo, T alpha, Hier_ A, Hier_ C ) {
+      int k = (TransA == FLA_NO_TRANSPOSE ? A.get_n() : A.get_m());
+      for (    int p =0 ; p <k ; ++p)  {
+        for (  int k2=0 ; k2<C.get_n() ; ++k2) {
+          int b = (uplo == LINAL_UPPER_TRIANGULAR ? 0    : k2);
+          int e = (uplo == LINAL_UPPER_TRIANGULAR ? k2+1 : C.get_m());
+          for (int k1=b ; k1<e ; ++k1) {
+
+#pragma omp task firstprivate ( k1, k2, p )
+            {
+              FLA_Obj &a1 = (TransA == FLA_NO_TRANSPOSE ? A(k1,p) : A(p,k1));
+              FLA_Obj &a2 = (TransA == FLA_NO_TRANSPOSE ? A(k2,p) : A(p,k2));
+              kernel::Gemm_<T,TransA,TransB>::run
+                ( alpha, kernel::View_<T>(a1), kernel::View_<T>(a2), 
+                  T(1), kernel::View_<T>(C(k1,k2)) );
+            }
+          }
+        }
+#pragma omp taskwait
+      }
+    }
+
+    template<typename T> 
+    static int syrk_typed( int uplo, int trans, 
+                           FLA_Obj alpha, Hier_ A, Hier_ C ) {
+      T al = kernel::Type_<T>::value( alpha );
+      switch (trans) {
+      case LINAL_NO_TRANSPOSE:
+        syrk_typed_blocks<T,FLA_NO_TRANSPOSE,FLA_TRANSPOSE>
+          ( uplo, al, A, C ); break;
+      case LINAL_TRANSPOSE:
+        syrk_typed_blocks<T,FLA_TRANSPOSE,FLA_NO_TRANSPOSE>
+          ( uplo, al, A, C ); break;
+      default: return false;
+      }
+      return true;
+    }
+
     int syrk( int uplo, int trans, 
               FLA_Obj alpha, Hier_ A,
               FLA_Obj beta,  Hier_ C ) {
       // scale first
       scal( beta, C );
+
+      // ** datatype and trans are resolved here once for small blocks
+      if (is_typed_kernel(A) && is_typed_kernel(C) &&
+          A.get_data_type() == C.get_data_type()) {
+        int done = false;
+        switch (C.get_data_type()) {
+        case FLA_FLOAT:
+          done = syrk_typed< float >( uplo, trans, alpha, A, C ); break;
+        case FLA_DOUBLE:
+          done = syrk_typed< double >( uplo, trans, alpha, A, C ); break;
+        case FLA_COMPLEX:
+          done = syrk_typed< std::complex<float> >
+            ( uplo, trans, alpha, A, C ); break;
+        case FLA_DOUBLE_COMPLEX:
+          done = syrk_typed< std::complex<double> >
+            ( uplo, trans, alpha, A, C ); break;
+        }
+        if (done) return true;
+      }
       
       switch (trans) {
       case LINAL_NO_TRANSPOSE:
@@ -37,9 +37,75 @@
 #include "linal/flat.hxx"
 #include "linal/hier.hxx"
 #include "linal/operation.hxx"
+#include "linal/kernel.hxx"
 
 namespace linal {
   namespace dense {
+    // ** trsm_update with the typed block kernel, the runtime arguments
+    //    are peeled one by one into template arguments
+    template<typename T, int Side, int Uplo, int Trans, int Diag>
+    static void trsm_typed_blocks( Hier_ A, Hier_ B ) {
+      for (int k2=0;k2<B.get_n();++k2) {
+        for (int k1=0;k1<B.get_m();++k1) {
+
+#pragma omp task firstprivate( k1, k2 )
+          kernel::Trsm_<T,Side,Uplo,Trans,Diag>::run
+            ( T(1), kernel::View_<T>(A(0,0)), kernel::View_<T>(B(k1,k2)) );
+
+        }
+      }
+
+#pragma omp taskwait
+    }
+
+    template<typename T, int Side, int Uplo, int Trans>
+    static int trsm_typed_diag( int diag, Hier_ A, Hier_ B ) {
+      switch (diag) {
+      case FLA_UNIT_DIAG:
+        trsm_typed_blocks<T,Side,Uplo,Trans,FLA_UNIT_DIAG>( A, B ); break;
+      case FLA_NONUNIT_DIAG:
+        trsm_typed_blocks<T,Side,Uplo,Trans,FLA_NONUNIT_DIAG>( A, B ); break;
+      default: return false;
+      }
+      return true;
+    }
+
+    template<typename T, int Side, int Uplo>
+    static int trsm_typed_trans( int trans, int diag, Hier_ A, Hier_ B ) {
+      switch (trans) {
+      case FLA_NO_TRANSPOSE:
+        return trsm_typed_diag<T,Side,Uplo,FLA_NO_TRANSPOSE>  ( diag, A, B );
+      case FLA_TRANSPOSE:
+        return trsm_typed_diag<T,Side,Uplo,FLA_TRANSPOSE>     ( diag, A, B );
+      case FLA_CONJ_TRANSPOSE:
+        return trsm_typed_diag<T,Side,Uplo,FLA_CONJ_TRANSPOSE>( diag, A, B );
+      }
+      return false;
+    }
+
+    template<typename T, int Side>
+    static int trsm_typed_uplo( int uplo, int trans, int diag, 
+                                Hier_ A, Hier_ B ) {
+      switch (uplo) {
+      case FLA_LOWER_TRIANGULAR:
+        return trsm_typed_trans<T,Side,FLA_LOWER_TRIANGULAR>( trans, diag, A, B );
+      case FLA_UPPER_TRIANGULAR:
+        return trsm_typed_trans<T,Side,FLA_UPPER_TRIANGULAR>( trans, diag, A, B );
+      }
+      return false;
+    }
+
+    template<typename T>
+    static int trsm_typed( int side, int uplo, int trans, int diag, 
+                           Hier_ A, Hier_ B ) {
+      switch (side) {
+      case FLA_LEFT:
+        return trsm_typed_uplo<T,FLA_LEFT> ( uplo, trans, diag, A, B );
+      case FLA_RIGHT:
+        return trsm_typed_uplo<T,FLA_RIGHT>( uplo, trans, diag, A, B );
+      }
+      return false;
+    }
 
     int trsm( int side, int uplo, int trans, int diag,
               FLA_Obj alpha, Hier_ A, Hier_ B ) {
@@ -307,6 +373,25 @@ namespace linal {
       // B is column or row block matrix 
       // it apply TRSM on rowise or columnwise for TRSM block
 
+      // ** datatype and arguments are resolved here once for small blocks
+      if (is_typed_kernel(A) && is_typed_kernel(B) &&
+          A.get_data_type() == B.get_data_type()) {
+        int done = false;
+        switch (B.get_data_type()) {
+        case FLA_FLOAT:
+          done = trsm_typed< float >( side, uplo, trans, diag, A, B ); break;
+        case FLA_DOUBLE:
+          done = trsm_typed< double >( side, uplo, trans, diag, A, B ); break;
+        case FLA_COMPLEX:
+          done = trsm_typed< std::complex<float> >
+            ( side, uplo, trans, diag, A, B ); break;
+        case FLA_DOUBLE_COMPLEX:
+          done = trsm_typed< std::complex<double> >
+            ( side, uplo, trans, diag, A, B ); break;
+        }
+        if (done) return true;
+      }
+
       for (int k2=0;k2<B.get_n();++k2) {
         for (int k1=0;k1<B.get_m();++k1) {
 
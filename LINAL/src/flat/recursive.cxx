@@ -0,0 +1,172 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+namespace linal {
+
+  /*!
+    Recursive ( cache oblivious ) factorizations on a flat matrix.
+
+    The matrix is halved until it is not larger than the base size,
+    which is factored by the blocked FLAME kernel. Everything else is
+    done by the trsm/syrk/gemm of the halves, so most of the flops
+    run in large level 3 calls whatever the cache sizes are.
+  */
+
+  static int recursive_base = LINAL_RECURSIVE_BASE;
+
+  void set_recursive_base( int base ) { 
+    recursive_base = max( base, 1 ); 
+  }
+  int  get_recursive_base() { 
+    return recursive_base; 
+  }
+
+  static void chol_rec_internal( int uplo, FLA_Obj A ) {
+    int n = FLA_Obj_length( A );
+    if (n <= recursive_base) {
+      FLA_Chol( uplo, A );
+      return;
+    }
+
+    FLA_Obj ATL, ATR,
+            ABL, ABR;
+    FLA_Part_2x2( A, &ATL, &ATR,
+                     &ABL, &ABR, n/2, n/2, FLA_TL );
+
+    chol_rec_internal( uplo, ATL );
+
+    switch (uplo) {
+    case LINAL_UPPER_TRIANGULAR:
+      FLA_Trsm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE,
+                FLA_NONUNIT_DIAG, FLA_ONE, ATL, ATR );
+      FLA_Syrk( FLA_UPPER_TRIANGULAR, FLA_TRANSPOSE, FLA_MINUS_ONE,
+                ATR, FLA_ONE, ABR );
+      break;
+    case LINAL_LOWER_TRIANGULAR:
+      FLA_Trsm( FLA_RIGHT, FLA_LOWER_TRIANGULAR, FLA_TRANSPOSE,
+                FLA_NONUNIT_DIAG, FLA_ONE, ATL, ABL );
+      FLA_Syrk( FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE, FLA_MINUS_ONE,
+                ABL, FLA_ONE, ABR );
+      break;
+    }
+
+    chol_rec_internal( uplo, ABR );
+  }
+
+  static void lu_nopiv_rec_internal( FLA_Obj A ) {
+    int n = FLA_Obj_length( A );
+    if (n <= recursive_base) {
+      FLA_LU_nopiv( A );
+      return;
+    }
+
+    FLA_Obj ATL, ATR,
+            ABL, ABR;
+    FLA_Part_2x2( A, &ATL, &ATR,
+                     &ABL, &ABR, n/2, n/2, FLA_TL );
+
+    lu_nopiv_rec_internal( ATL );
+
+    FLA_Trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+              FLA_UNIT_DIAG, FLA_ONE, ATL, ATR );
+    FLA_Trsm( FLA_RIGHT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+              FLA_NONUNIT_DIAG, FLA_ONE, ATL, ABL );
+    FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, 
+              FLA_MINUS_ONE, ABL, ATR, FLA_ONE, ABR );
+
+    lu_nopiv_rec_internal( ABR );
+  }
+
+  // ** m x n with m >= n, halves the columns ( Toledo )
+  static void lu_piv_rec_internal( FLA_Obj A, FLA_Obj p ) {
+    int n = FLA_Obj_width( A );
+    if (n <= recursive_base) {
+      FLA_LU_piv( A, p );
+      return;
+    }
+
+    FLA_Obj AL, AR, ATL, ATR,
+                    ABL, ABR;
+    FLA_Obj pt, pb;
+
+    FLA_Part_1x2( A, &AL, &AR, n/2, FLA_LEFT );
+    FLA_Part_2x2( A, &ATL, &ATR,
+                     &ABL, &ABR, n/2, n/2, FLA_TL );
+    FLA_Part_2x1( p, &pt,
+                     &pb, n/2, FLA_TOP );
+
+    lu_piv_rec_internal( AL, pt );
+
+    FLA_Apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, pt, AR );
+    FLA_Trsm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+              FLA_UNIT_DIAG, FLA_ONE, ATL, ATR );
+    FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, 
+              FLA_MINUS_ONE, ABL, ATR, FLA_ONE, ABR );
+
+    lu_piv_rec_internal( ABR, pb );
+
+    // pivots of the lower half are relative to its first row
+    FLA_Apply_pivots( FLA_LEFT, FLA_NO_TRANSPOSE, pb, ABL );
+  }
+
+  int chol_rec( int uplo, Flat_ A ) {
+    if (!A.get_m()) return true;
+    LINAL_ERROR(A.get_m() == A.get_n(),
+                ">> Flat_ A is not square matrix");
+    chol_rec_internal( uplo, ~A );
+    return true;
+  }
+
+  int lu_nopiv_rec( Flat_ A ) {
+    if (!A.get_m()) return true;
+    LINAL_ERROR(A.get_m() == A.get_n(),
+                ">> Flat_ A is not square matrix");
+    lu_nopiv_rec_internal( ~A );
+    return true;
+  }
+
+  int lu_piv_rec( Flat_ A, Flat_ p ) {
+    if (!A.get_m() || !A.get_n()) return true;
+    LINAL_ERROR(A.get_m() >= A.get_n(),
+                ">> Flat_ A should have m >= n");
+    lu_piv_rec_internal( ~A, ~p );
+    return true;
+  }
+}
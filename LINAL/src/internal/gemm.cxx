@@ -90,8 +90,10 @@ namespace linal {
         int thread   = omp_get_thread_num();
         int n_thread = get_n_thread(); 
 
-        if ( thread >= n_thread ) 
-          FLA_Gemm( transa, transb, alpha, A, B, beta,  C );
+        if ( thread >= n_thread ) {
+          if ( !gemm_kernel( transa, transb, alpha, A, B, beta,  C ) )
+            FLA_Gemm( transa, transb, alpha, A, B, beta,  C );
+        }
         else 
           gemm_internal_gpu( transa, transb, alpha, A, B, beta,  C );
       }
@@ -99,7 +101,9 @@ namespace linal {
 #endif
 
     default: 
-      FLA_Gemm( transa, transb, alpha, A, B, beta,  C );
+      // ** small blocks skip the FLA_Gemm checks and dispatch
+      if ( !gemm_kernel( transa, transb, alpha, A, B, beta,  C ) )
+        FLA_Gemm( transa, transb, alpha, A, B, beta,  C );
       break;
     }
     return true;
@@ -0,0 +1,431 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+// ** SIMD kernels need target attributes and avx512f detection (gcc 5)
+#if defined(__GNUC__) && !defined(__clang__) && \
+  (defined(__x86_64__) || defined(__i386__)) && __GNUC__ >= 5
+#define LINAL_GEMM_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+// ** loop unroll pragma (gcc 8), a hint only
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 8
+#define LINAL_GEMM_KERNEL_UNROLL _Pragma("GCC unroll 8")
+#else
+#define LINAL_GEMM_KERNEL_UNROLL
+#endif
+
+namespace linal {
+
+  /*!
+    Packed, register blocked gemm for double real and double complex.
+
+    op(A) is packed into row panels of mr and op(B) into column panels
+    of nr (zero padded). A micro-kernel accumulates one mr x nr tile
+    over the full k in registers and the tile is merged into C with
+    alpha and beta. Complex values are packed in split real/imag
+    planes so that the same broadcast/fma structure is used. Blocks
+    are bounded by the threshold, so k is never split.
+  */
+
+  typedef void (*gemm_micro_t)( int k, const double *ap, const double *bp, 
+                                double *t );
+
+  static int gemm_kernel_threshold = LINAL_GEMM_KERNEL_THRESHOLD;
+  static int gemm_kernel_isa       = -1;
+
+  // ** packing workspace of a thread, grown on demand and kept for the
+  //    next call; it is not cleared, gemm_pack writes every packed entry
+  static double *gemm_kernel_work      = NULL;
+  static size_t  gemm_kernel_work_size = 0;
+#pragma omp threadprivate ( gemm_kernel_work, gemm_kernel_work_size )
+
+  static double* gemm_kernel_workspace( size_t size ) {
+    if (size > gemm_kernel_work_size) {
+      free( gemm_kernel_work );
+      gemm_kernel_work      = (double*)malloc( size*sizeof(double) );
+      gemm_kernel_work_size = (gemm_kernel_work != NULL ? size : 0);
+      LINAL_ERROR( gemm_kernel_work != NULL,
+                   ">> Failed to allocate the gemm kernel workspace" );
+    }
+    return gemm_kernel_work;
+  }
+
+  // --------------------------------------------------------------
+  // ** Scalar kernels, 4x4
+  static void gemm_micro_d_scalar( int k, const double *ap, const double *bp,
+                                   double *t ) {
+    double acc[16];
+    for (int i=0;i<16;++i) acc[i] = 0.0;
+
+    for (int p=0;p<k;++p,ap+=4,bp+=4) 
+      for (int c=0;c<4;++c) {
+        double b = bp[c];
+        for (int r=0;r<4;++r) 
+          acc[c*4+r] += ap[r]*b;
+      }
+
+    for (int i=0;i<16;++i) t[i] = acc[i];
+  }
+
+  static void gemm_micro_z_scalar( int k, const double *ap, const double *bp,
+                                   double *t ) {
+    double re[16], im[16];
+    for (int i=0;i<16;++i) re[i] = im[i] = 0.0;
+
+    for (int p=0;p<k;++p,ap+=8,bp+=8) 
+      for (int c=0;c<4;++c) {
+        double br = bp[c], bi = bp[4+c];
+        for (int r=0;r<4;++r) {
+          double ar = ap[r], ai = ap[4+r];
+          re[c*4+r] += ar*br - ai*bi;
+          im[c*4+r] += ar*bi + ai*br;
+        }
+      }
+
+    for (int i=0;i<16;++i) {
+      t[i]    = re[i];
+      t[16+i] = im[i];
+    }
+  }
+
+#ifdef LINAL_GEMM_KERNEL_X86
+  // --------------------------------------------------------------
+  // ** AVX2 kernels, real 8x4, complex 4x4
+  __attribute__((target("avx2,fma")))
+  static void gemm_micro_d_avx2( int k, const double *ap, const double *bp,
+                                 double *t ) {
+    __m256d 
+      c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(),
+      c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd(),
+      c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd(),
+      c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int p=0;p<k;++p,ap+=8,bp+=4) {
+      __m256d a0 = _mm256_loadu_pd(ap), a1 = _mm256_loadu_pd(ap+4), b;
+      b = _mm256_broadcast_sd(bp+0);
+      c00 = _mm256_fmadd_pd(a0, b, c00); c01 = _mm256_fmadd_pd(a1, b, c01);
+      b = _mm256_broadcast_sd(bp+1);
+      c10 = _mm256_fmadd_pd(a0, b, c10); c11 = _mm256_fmadd_pd(a1, b, c11);
+      b = _mm256_broadcast_sd(bp+2);
+      c20 = _mm256_fmadd_pd(a0, b, c20); c21 = _mm256_fmadd_pd(a1, b, c21);
+      b = _mm256_broadcast_sd(bp+3);
+      c30 = _mm256_fmadd_pd(a0, b, c30); c31 = _mm256_fmadd_pd(a1, b, c31);
+    }
+
+    _mm256_storeu_pd(t+ 0, c00); _mm256_storeu_pd(t+ 4, c01);
+    _mm256_storeu_pd(t+ 8, c10); _mm256_storeu_pd(t+12, c11);
+    _mm256_storeu_pd(t+16, c20); _mm256_storeu_pd(t+20, c21);
+    _mm256_storeu_pd(t+24, c30); _mm256_storeu_pd(t+28, c31);
+  }
+
+  __attribute__((target("avx2,fma")))
+  static void gemm_micro_z_avx2( int k, const double *ap, const double *bp,
+                                 double *t ) {
+    __m256d 
+      r0 = _mm256_setzero_pd(), i0 = _mm256_setzero_pd(),
+      r1 = _mm256_setzero_pd(), i1 = _mm256_setzero_pd(),
+      r2 = _mm256_setzero_pd(), i2 = _mm256_setzero_pd(),
+      r3 = _mm256_setzero_pd(), i3 = _mm256_setzero_pd();
+
+    for (int p=0;p<k;++p,ap+=8,bp+=8) {
+      __m256d ar = _mm256_loadu_pd(ap), ai = _mm256_loadu_pd(ap+4), br, bi;
+#define LINAL_GEMM_MICRO_Z_AVX2(c, re, im)                              \
+      br = _mm256_broadcast_sd(bp+(c)); bi = _mm256_broadcast_sd(bp+4+(c)); \
+      re = _mm256_fmadd_pd (ar, br, re); re = _mm256_fnmadd_pd(ai, bi, re); \
+      im = _mm256_fmadd_pd (ar, bi, im); im = _mm256_fmadd_pd (ai, br, im);
+      LINAL_GEMM_MICRO_Z_AVX2(0, r0, i0);
+      LINAL_GEMM_MICRO_Z_AVX2(1, r1, i1);
+      LINAL_GEMM_MICRO_Z_AVX2(2, r2, i2);
+      LINAL_GEMM_MICRO_Z_AVX2(3, r3, i3);
+#undef LINAL_GEMM_MICRO_Z_AVX2
+    }
+
+    _mm256_storeu_pd(t+ 0, r0); _mm256_storeu_pd(t+16, i0);
+    _mm256_storeu_pd(t+ 4, r1); _mm256_storeu_pd(t+20, i1);
+    _mm256_storeu_pd(t+ 8, r2); _mm256_storeu_pd(t+24, i2);
+    _mm256_storeu_pd(t+12, r3); _mm256_storeu_pd(t+28, i3);
+  }
+
+  // --------------------------------------------------------------
+  // ** AVX-512 kernels, real 16x8, complex 8x8
+  __attribute__((target("avx512f")))
+  static void gemm_micro_d_avx512( int k, const double *ap, const double *bp,
+                                   double *t ) {
+    __m512d c0[8], c1[8];
+    for (int c=0;c<8;++c) 
+      c0[c] = c1[c] = _mm512_setzero_pd();
+
+    for (int p=0;p<k;++p,ap+=16,bp+=8) {
+      __m512d a0 = _mm512_loadu_pd(ap), a1 = _mm512_loadu_pd(ap+8);
+      LINAL_GEMM_KERNEL_UNROLL
+      for (int c=0;c<8;++c) {
+        __m512d b = _mm512_set1_pd(bp[c]);
+        c0[c] = _mm512_fmadd_pd(a0, b, c0[c]); 
+        c1[c] = _mm512_fmadd_pd(a1, b, c1[c]);
+      }
+    }
+
+    for (int c=0;c<8;++c) {
+      _mm512_storeu_pd(t+c*16,   c0[c]);
+      _mm512_storeu_pd(t+c*16+8, c1[c]);
+    }
+  }
+
+  __attribute__((target("avx512f")))
+  static void gemm_micro_z_avx512( int k, const double *ap, const double *bp,
+                                   double *t ) {
+    __m512d re[8], im[8];
+    for (int c=0;c<8;++c) 
+      re[c] = im[c] = _mm512_setzero_pd();
+
+    for (int p=0;p<k;++p,ap+=16,bp+=16) {
+      __m512d ar = _mm512_loadu_pd(ap), ai = _mm512_loadu_pd(ap+8);
+      LINAL_GEMM_KERNEL_UNROLL
+      for (int c=0;c<8;++c) {
+        __m512d br = _mm512_set1_pd(bp[c]), bi = _mm512_set1_pd(bp[8+c]);
+        re[c] = _mm512_fmadd_pd (ar, br, re[c]); 
+        re[c] = _mm512_fnmadd_pd(ai, bi, re[c]);
+        im[c] = _mm512_fmadd_pd (ar, bi, im[c]); 
+        im[c] = _mm512_fmadd_pd (ai, br, im[c]);
+      }
+    }
+
+    for (int c=0;c<8;++c) {
+      _mm512_storeu_pd(t+c*8,    re[c]);
+      _mm512_storeu_pd(t+64+c*8, im[c]);
+    }
+  }
+#endif
+
+  // --------------------------------------------------------------
+  // ** Packing, element (i,p) of op(A) is at a + nv*(i*rs + p*cs)
+  static void gemm_pack( int nv, int conj, int mr, int m, int k,
+                         const double *a, int rs, int cs, double *ap ) {
+    for (int i0=0;i0<m;i0+=mr) {
+      for (int p=0;p<k;++p,ap+=nv*mr) {
+        for (int r=0;r<mr;++r) {
+          int i = i0 + r;
+          if (i < m) {
+            const double *s = a + nv*(i*rs + p*cs);
+            ap[r] = s[0];
+            if (nv == 2) ap[mr+r] = (conj ? -s[1] : s[1]);
+          } else {
+            ap[r] = 0.0;
+            if (nv == 2) ap[mr+r] = 0.0;
+          }
+        }
+      }
+    }
+  }
+
+  // ** C(i0:,j0:) = alpha T + beta C on the valid part of the tile
+  static void gemm_merge( int nv, int mr, int nr, int m, int n, 
+                          const double *t, const double *alpha, 
+                          const double *beta, int beta_zero,
+                          double *c, int rs, int cs ) {
+    for (int j=0;j<n;++j) {
+      for (int i=0;i<m;++i) {
+        double *cc = c + nv*(i*rs + j*cs);
+        if (nv == 1) {
+          double v = alpha[0]*t[j*mr+i];
+          cc[0] = (beta_zero ? v : v + beta[0]*cc[0]);
+        } else {
+          double tr = t[j*mr+i], ti = t[mr*nr + j*mr+i];
+          double vr = alpha[0]*tr - alpha[1]*ti;
+          double vi = alpha[0]*ti + alpha[1]*tr;
+          if (!beta_zero) {
+            vr += beta[0]*cc[0] - beta[1]*cc[1];
+            vi += beta[0]*cc[1] + beta[1]*cc[0];
+          }
+          cc[0] = vr; cc[1] = vi;
+        }
+      }
+    }
+  }
+
+  // --------------------------------------------------------------
+  // ** ISA selection
+  static int gemm_kernel_detect() {
+#ifdef LINAL_GEMM_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) 
+      return LINAL_GEMM_KERNEL_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) 
+      return LINAL_GEMM_KERNEL_AVX2;
+#endif
+    return LINAL_GEMM_KERNEL_SCALAR;
+  }
+
+  static void gemm_kernel_select( int isa, int is_complex, 
+                                  int &mr, int &nr, gemm_micro_t &micro ) {
+    switch (isa) {
+#ifdef LINAL_GEMM_KERNEL_X86
+    case LINAL_GEMM_KERNEL_AVX512:
+      mr = (is_complex ? 8 : 16); nr = 8;
+      micro = (is_complex ? gemm_micro_z_avx512 : gemm_micro_d_avx512);
+      break;
+    case LINAL_GEMM_KERNEL_AVX2:
+      mr = (is_complex ? 4 : 8);  nr = 4;
+      micro = (is_complex ? gemm_micro_z_avx2 : gemm_micro_d_avx2);
+      break;
+#endif
+    default:
+      mr = 4; nr = 4;
+      micro = (is_complex ? gemm_micro_z_scalar : gemm_micro_d_scalar);
+      break;
+    }
+  }
+
+  void set_gemm_kernel_threshold( int threshold ) { 
+    gemm_kernel_threshold = threshold; 
+  }
+  int  get_gemm_kernel_threshold() { 
+    return gemm_kernel_threshold; 
+  }
+
+  // ** detected once, gemm tasks only read it
+  static int gemm_kernel_detected() {
+    static const int isa = gemm_kernel_detect();
+    return isa;
+  }
+
+  // ** an isa the cpu does not support falls back to the detected one
+  void set_gemm_kernel_isa( int isa ) {
+    int detect = gemm_kernel_detected();
+    gemm_kernel_isa = (isa > detect ? detect : isa);
+  }
+  int  get_gemm_kernel_isa() {
+    return (gemm_kernel_isa < 0 ? gemm_kernel_detected() : gemm_kernel_isa);
+  }
+
+  // --------------------------------------------------------------
+  // ** Packed core, strides are of op(A) and op(B) in elements
+  void gemm_kernel_packed( int is_complex, int conj_a, int conj_b,
+                           int m, int n, int k, const double *alpha,
+                           const double *a, int rs_a, int cs_a,
+                           const double *b, int rs_b, int cs_b,
+                           const double *beta, 
+                           double *c, int rs_c, int cs_c ) {
+    if (!m || !n || !k) return;
+
+    int nv = (is_complex ? 2 : 1);
+    int beta_zero = (beta[0] == 0.0 && (!is_complex || beta[1] == 0.0));
+
+    int mr, nr;
+    gemm_micro_t micro;
+    gemm_kernel_select( get_gemm_kernel_isa(), is_complex, mr, nr, micro );
+
+    int m_pad = ((m + mr - 1)/mr)*mr, n_pad = ((n + nr - 1)/nr)*nr;
+
+    // ** op(B) is packed as k x n with panels of nr columns, 
+    //    i.e. op(B)^T packed in panels of nr rows
+    size_t n_ap = (size_t)nv*m_pad*k, n_bp = (size_t)nv*n_pad*k;
+    double *ap = gemm_kernel_workspace( n_ap + n_bp + nv*mr*nr );
+    double *bp = ap + n_ap, *t = bp + n_bp;
+    gemm_pack( nv, conj_a, mr, m, k, a, rs_a, cs_a, ap );
+    gemm_pack( nv, conj_b, nr, n, k, b, cs_b, rs_b, bp );
+
+    for (int j0=0;j0<n;j0+=nr) {
+      const double *bj = bp + nv*j0*k;
+      for (int i0=0;i0<m;i0+=mr) {
+        micro( k, ap + nv*i0*k, bj, t );
+        gemm_merge( nv, mr, nr, 
+                    (m - i0 < mr ? m - i0 : mr), (n - j0 < nr ? n - j0 : nr),
+                    t, alpha, beta, beta_zero,
+                    c + nv*(i0*rs_c + j0*cs_c), rs_c, cs_c );
+      }
+    }
+  }
+
+  // --------------------------------------------------------------
+  // ** Entry
+  int gemm_kernel( int transa, int transb,
+                   FLA_Obj alpha, FLA_Obj A, FLA_Obj B,
+                   FLA_Obj beta,  FLA_Obj C ) {
+
+    int datatype = FLA_Obj_datatype( C );
+    if ( (datatype != FLA_DOUBLE && datatype != FLA_DOUBLE_COMPLEX) ||
+         FLA_Obj_datatype( A ) != datatype ||
+         FLA_Obj_datatype( B ) != datatype ) 
+      return false;
+
+    int is_trans_a = (transa == FLA_TRANSPOSE || transa == FLA_CONJ_TRANSPOSE);
+    int is_trans_b = (transb == FLA_TRANSPOSE || transb == FLA_CONJ_TRANSPOSE);
+
+    int m = FLA_Obj_length( C ), n = FLA_Obj_width( C );
+    int k = (is_trans_a ? FLA_Obj_length( A ) : FLA_Obj_width( A ));
+
+    int mnk = (m > n ? m : n); mnk = (mnk > k ? mnk : k);
+    if (!k || mnk > gemm_kernel_threshold) 
+      return false;
+    if (!m || !n) 
+      return true;
+
+    int is_complex = (datatype == FLA_DOUBLE_COMPLEX);
+    int conj_a = (transa == FLA_CONJ_TRANSPOSE || transa == FLA_CONJ_NO_TRANSPOSE);
+    int conj_b = (transb == FLA_CONJ_TRANSPOSE || transb == FLA_CONJ_NO_TRANSPOSE);
+
+    // ** scalars, constants such as FLA_ONE are resolved by the macros
+    double alpha_v[2], beta_v[2];
+    if (is_complex) {
+      dcomplex *al = FLA_DOUBLE_COMPLEX_PTR( alpha ), *be = FLA_DOUBLE_COMPLEX_PTR( beta );
+      alpha_v[0] = al->real; alpha_v[1] = al->imag;
+      beta_v[0]  = be->real; beta_v[1]  = be->imag;
+    } else {
+      alpha_v[0] = *FLA_DOUBLE_PTR( alpha ); alpha_v[1] = 0.0;
+      beta_v[0]  = *FLA_DOUBLE_PTR( beta );  beta_v[1]  = 0.0;
+    }
+
+    // ** strides of op(A), op(B)
+    int rs_a = FLA_Obj_row_stride( A ), cs_a = FLA_Obj_col_stride( A );
+    int rs_b = FLA_Obj_row_stride( B ), cs_b = FLA_Obj_col_stride( B );
+    int rs_c = FLA_Obj_row_stride( C ), cs_c = FLA_Obj_col_stride( C );
+    if (is_trans_a) std::swap(rs_a, cs_a);
+    if (is_trans_b) std::swap(rs_b, cs_b);
+
+    gemm_kernel_packed( is_complex, conj_a, conj_b, m, n, k, alpha_v,
+                        (double*)FLA_Obj_buffer_at_view( A ), rs_a, cs_a,
+                        (double*)FLA_Obj_buffer_at_view( B ), rs_b, cs_b,
+                        beta_v,
+                        (double*)FLA_Obj_buffer_at_view( C ), rs_c, cs_c );
+    return true;
+  }
+}
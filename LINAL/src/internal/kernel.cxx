@@ -0,0 +1,72 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "linal/common.hxx"
+#include "linal/const.hxx"
+#include "linal/util.hxx"
+#include "linal/matrix.hxx"
+#include "linal/flat.hxx"
+#include "linal/hier.hxx"
+#include "linal/operation.hxx"
+
+namespace linal {
+
+  static int typed_kernel_threshold = LINAL_TYPED_KERNEL_THRESHOLD;
+
+  void set_typed_kernel_threshold( int threshold ) {
+    typed_kernel_threshold = (threshold > 0 ? threshold : 0);
+  }
+  int  get_typed_kernel_threshold() {
+    return typed_kernel_threshold;
+  }
+
+  // ** the first block is the largest one of a block grid
+  int is_typed_kernel( Hier_ A ) {
+    switch ( get_computing_model() ) {
+    case LINAL_GPU: 
+    case LINAL_CPU_GPU: 
+      return false;
+    }
+    if (!typed_kernel_threshold || !A.get_m() || !A.get_n()) 
+      return false;
+
+    FLA_Obj &a = A(0,0);
+    switch ( FLA_Obj_datatype( a ) ) {
+    case FLA_FLOAT: case FLA_DOUBLE: 
+    case FLA_COMPLEX: case FLA_DOUBLE_COMPLEX: break;
+    default: return false;
+    }
+    return ( FLA_Obj_row_stride( a ) == 1 &&
+             FLA_Obj_length( a ) <= typed_kernel_threshold &&
+             FLA_Obj_width( a )  <= typed_kernel_threshold );
+  }
+}
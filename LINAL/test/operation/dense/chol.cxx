@@ -38,8 +38,11 @@ int main(int argc, char **argv) {
   linal::Flat_  A,  B, norm;
   linal::Hier_ hA;
 
-  if (argc != 3) {
-    printf("Try :: trsm [thread] [uplo]\n");
+  if (argc != 3 && argc != 7) {
+    printf("Try :: chol [thread] [uplo] ([variant] [n] [bmn] [param])\n");
+    printf(" - variant 0 (dense), 1 (dense recursive), 2 (flat recursive),\n");
+    printf("           3 (dense with lookahead)\n");
+    printf(" - param   recursive base (1, 2), lookahead depth (3)\n");
     return -1;
   }
 
@@ -48,6 +51,20 @@ int main(int argc, char **argv) {
 
   int datatype = TEST_DATATYPE;
 
+  // ** optional :: 0 - dense, 1 - dense recursive, 2 - flat recursive,
+  //                3 - dense with lookahead of param block columns
+  int variant = 0, n = N, bmn = BMN, param = 0;
+  if (argc == 7) {
+    variant = atoi( (argv[3]) );
+    n       = atoi( (argv[4]) );
+    bmn     = atoi( (argv[5]) );
+    param   = atoi( (argv[6]) );
+  }
+  if (variant == 1 || variant == 2) 
+    linal::set_recursive_base( param );
+  if (variant == 3) 
+    linal::dense::set_lookahead( param );
+
   // ---------------------------------------
   // ** Initialization   
   FLA_Init();
@@ -57,13 +74,13 @@ int main(int argc, char **argv) {
 
   // ---------------------------------------
   // ** Matrices
-  A.create   (datatype, N, N);
-  B.create   (datatype, N, N);
+  A.create   (datatype, n, n);
+  B.create   (datatype, n, n);
   norm.create(datatype, 1, 1);
 
   FLA_Random_spd_matrix(uplo, ~A);
 
-  hA.create(A, BMN, BMN);
+  hA.create(A, bmn, bmn);
 
   FLA_Copy( ~A, ~B );
 
@@ -77,7 +94,11 @@ int main(int argc, char **argv) {
 #pragma omp parallel
   {
 #pragma omp single nowait
-    linal::dense::chol( uplo, hA );
+    switch (variant) {
+    case 1:  linal::dense::chol_rec( uplo, hA ); break;
+    case 2:  linal::chol_rec( uplo, A );         break;
+    default: linal::dense::chol( uplo, hA );     break;
+    }
   }
 
   // ---------------------------------------
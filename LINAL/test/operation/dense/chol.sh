@@ -46,4 +46,36 @@ n_fail=0;
 ./chol 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 ./chol 4 1 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 
+# ** small sizes around the block and the recursive base
+./chol 1 0 0 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 0 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 0 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 0 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./chol 1 0 1 1 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 1 7 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 1 9 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 1 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 1 1 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 1 7 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 1 9 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 1 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./chol 1 0 2 1 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 2 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 2 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 2 33 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 2 1 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 2 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 2 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 2 33 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+# ** lookahead of 1, 2 and 3 block columns
+./chol 1 0 3 1000 192 1 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 3 1000 192 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 4 1 3 33 4 1 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 1 0 3 33 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 2 1 3 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./chol 4 1 3 9 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
 exit $n_fail
@@ -45,4 +45,84 @@
 //#define TEST_DATATYPE  LINAL_SINGLE_COMPLEX
 //#define TEST_DATATYPE  LINAL_DOUBLE_COMPLEX
 
+// ** small size cases :: any datatype, compared element by element
+
+// 0 - TEST_DATATYPE, 1 - single, 2 - double, 3 - complex, 4 - double complex
+inline int test_datatype(int arg) {
+  switch (arg) {
+  case 1: return LINAL_SINGLE_REAL;
+  case 2: return LINAL_DOUBLE_REAL;
+  case 3: return LINAL_SINGLE_COMPLEX;
+  case 4: return LINAL_DOUBLE_COMPLEX;
+  }
+  return TEST_DATATYPE;
+}
+
+// 0 - no, 1 - transpose, 2 - conj transpose, 3 - conj no transpose
+inline int test_trans(int arg) {
+  switch (arg) {
+  case 1: return FLA_TRANSPOSE;
+  case 2: return FLA_CONJ_TRANSPOSE;
+  case 3: return FLA_CONJ_NO_TRANSPOSE;
+  }
+  return FLA_NO_TRANSPOSE;
+}
+
+inline int test_is_complex(int datatype) {
+  return (datatype == LINAL_SINGLE_COMPLEX || datatype == LINAL_DOUBLE_COMPLEX);
+}
+
+// relative tolerance of the precision
+inline double test_tol(int datatype) {
+  return ((datatype == LINAL_SINGLE_REAL || datatype == LINAL_SINGLE_COMPLEX) ? 
+          1.0e-4 : 1.0e-10);
+}
+
+// real and imaginary part of A(i,j)
+inline void test_get(FLA_Obj A, int i, int j, double &re, double &im) {
+  int datatype = FLA_Obj_datatype( A ), nv = (test_is_complex(datatype) ? 2 : 1);
+  int offs = nv*(i*FLA_Obj_row_stride( A ) + j*FLA_Obj_col_stride( A ));
+
+  im = 0.0;
+  if (datatype == LINAL_SINGLE_REAL || datatype == LINAL_SINGLE_COMPLEX) {
+    float *a = (float*)FLA_Obj_buffer_at_view( A ) + offs;
+    re = a[0]; if (nv == 2) im = a[1];
+  } else {
+    double *a = (double*)FLA_Obj_buffer_at_view( A ) + offs;
+    re = a[0]; if (nv == 2) im = a[1];
+  }
+}
+
+// C is not read when beta is zero, nan makes it visible
+inline void test_set_nan(FLA_Obj A) {
+  int datatype = FLA_Obj_datatype( A ), nv = (test_is_complex(datatype) ? 2 : 1);
+  double nan = sqrt(-1.0);
+  for (int j=0;j<FLA_Obj_width( A );++j) 
+    for (int i=0;i<FLA_Obj_length( A );++i) {
+      int offs = nv*(i*FLA_Obj_row_stride( A ) + j*FLA_Obj_col_stride( A ));
+      for (int l=0;l<nv;++l) 
+        if (datatype == LINAL_SINGLE_REAL || datatype == LINAL_SINGLE_COMPLEX)
+          ((float*)FLA_Obj_buffer_at_view( A ))[offs+l]  = (float)nan;
+        else
+          ((double*)FLA_Obj_buffer_at_view( A ))[offs+l] = nan;
+    }
+}
+
+// max | A - B | / max( max | B |, 1 ), nan gives nan
+inline double test_diff(FLA_Obj A, FLA_Obj B) {
+  double diff = 0.0, scale = 1.0;
+  for (int j=0;j<FLA_Obj_width( B );++j) 
+    for (int i=0;i<FLA_Obj_length( B );++i) {
+      double ar, ai, br, bi;
+      test_get( A, i, j, ar, ai );
+      test_get( B, i, j, br, bi );
+
+      double d = fabs(ar - br) + fabs(ai - bi), b = fabs(br) + fabs(bi);
+      if (d != d) return d;
+      if (d > diff)  diff  = d;
+      if (b > scale) scale = b;
+    }
+  return diff/scale;
+}
+
 #endif
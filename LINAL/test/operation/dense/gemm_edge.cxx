@@ -0,0 +1,148 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_test.hxx"
+
+// ** tile gemm on sizes around the block size; every block row, column
+//    and k step is a partial block at least once
+
+static double gemm_edge(int datatype, int transa, int transb, int is_beta,
+                        int bmn, int m, int n, int k) {
+  linal::Flat_    A,  B,  C, D;
+  linal::Hier_   hA, hB, hC;
+
+  FLA_Obj beta = (is_beta ? FLA_ONE : FLA_ZERO);
+
+  if (transa == FLA_NO_TRANSPOSE) A.create(datatype, m, k);
+  else                            A.create(datatype, k, m);
+  if (transb == FLA_NO_TRANSPOSE) B.create(datatype, k, n);
+  else                            B.create(datatype, n, k);
+  C.create(datatype, m, n);
+  D.create(datatype, m, n);
+
+  FLA_Random_matrix(~A);
+  FLA_Random_matrix(~B);
+  FLA_Random_matrix(~C);
+
+  // ** beta zero must not read C
+  if (is_beta) {
+    FLA_Copy( ~C, ~D );
+  } else {
+    FLA_Set( FLA_ZERO, ~C );
+    test_set_nan( ~D );
+  }
+
+  hA.create(A, bmn, bmn);
+  hB.create(B, bmn, bmn);
+  hC.create(D, bmn, bmn);
+
+  FLA_Gemm( transa, transb, FLA_MINUS_ONE, ~A, ~B, beta, ~C );
+
+#pragma omp parallel
+  {
+#pragma omp single nowait
+    {
+#pragma omp task 
+      linal::dense::gemm( transa, transb, FLA_MINUS_ONE,
+                          hA, hB, beta, hC);
+    }
+  }
+
+  double diff = test_diff( ~D, ~C );
+
+  A.free(); hA.free();
+  B.free(); hB.free();
+  C.free(); hC.free();
+  D.free();
+
+  return diff;
+}
+
+int main(int argc, char **argv) {
+
+  if (argc != 7 && argc != 8) {
+    printf("Try :: gemm_edge [thread] [datatype] [transa] [transb] [beta] [bmn] ([typed])\n");
+    printf(" - datatype 1 (s), 2 (d), 3 (c), 4 (z), trans 0 (N), 1 (T), 2 (C)\n");
+    printf(" - typed kernel threshold, 0 is off\n");
+    return -1;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  FLA_Init();
+
+  int nthread  = atoi( (argv[1]) );
+  int datatype = test_datatype( atoi( (argv[2]) ) );
+  int transa   = test_trans( atoi( (argv[3]) ) );
+  int transb   = test_trans( atoi( (argv[4]) ) );
+  int is_beta  = atoi( (argv[5]) );
+  int bmn      = atoi( (argv[6]) );
+
+  if (argc == 8) 
+    linal::set_typed_kernel_threshold( atoi( (argv[7]) ) );
+
+  omp_set_num_threads( nthread );
+
+  // ---------------------------------------
+  // ** m, n, k in { 1, bmn-1, bmn+1 }
+  int size[3] = { 1, bmn-1, bmn+1 };
+  double diff = 0.0;
+
+  for (int i=0;i<3;++i)
+    for (int j=0;j<3;++j)
+      for (int l=0;l<3;++l) {
+        if (size[i] < 1 || size[j] < 1 || size[l] < 1) continue;
+        double d = gemm_edge( datatype, transa, transb, is_beta, bmn,
+                              size[i], size[j], size[l] );
+        if (!(d <= diff)) diff = d;
+      }
+
+  // ---------------------------------------
+  // ** Check
+  int rval;
+
+  printf("- TEST::");
+  for (int i=0;i<argc;++i)
+    printf(" %s ", argv[i] );
+  printf("\n");
+
+  if (diff < test_tol(datatype)) {
+    printf("PASS::Diff :: %E \n", diff);   rval = 0;
+  } else {
+    printf("FAIL::Diff :: %E \n", diff);   rval = -1;
+  }
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return rval;
+}
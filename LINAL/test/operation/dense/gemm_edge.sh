@@ -0,0 +1,132 @@
+#!/bin/bash  
+
+#
+#   Copyright © 2011, Kyungjoo Kim
+#   All rights reserved.
+#  
+#   This file is part of LINAL.
+#  
+#   Redistribution and use in source and binary forms, with or without
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2. Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3. Neither the name of the owner nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#   ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#   CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#   POSSIBILITY OF SUCH DAMAGE.
+#
+
+
+n_fail=0;
+
+./gemm_edge 1 1 0 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 2 2 0 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 3 3 0 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 4 4 0 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 0 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 0 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 1 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 1 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 2 0 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 2 1 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+# ** typed block kernel on, the default threshold is 0 ( off )
+./gemm_edge 1 1 0 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 0 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 1 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 1 1 2 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 2 2 0 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 0 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 1 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 2 2 2 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 3 3 0 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 0 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 1 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 3 3 2 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./gemm_edge 4 4 0 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 0 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 0 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 1 1 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./gemm_edge 4 4 2 2 0 8 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+exit $n_fail
\ No newline at end of file
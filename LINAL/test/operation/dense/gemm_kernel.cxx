@@ -0,0 +1,145 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_test.hxx"
+
+// ** packed gemm kernel on sizes around the micro tile mr x nr,
+//    every trans and conj combination, beta zero reads no C
+
+static void micro_tile(int isa, int is_complex, int &mr, int &nr) {
+  switch (isa) {
+  case LINAL_GEMM_KERNEL_AVX512: mr = (is_complex ? 8 : 16); nr = 8; break;
+  case LINAL_GEMM_KERNEL_AVX2:   mr = (is_complex ? 4 :  8); nr = 4; break;
+  default:                       mr = 4;                     nr = 4; break;
+  }
+}
+
+static double gemm_kernel_case(int datatype, int transa, int transb, 
+                               int is_beta, int m, int n, int k, 
+                               int &is_done) {
+  linal::Flat_ A, B, C, D;
+
+  FLA_Obj beta = (is_beta ? FLA_ONE : FLA_ZERO);
+
+  int is_trans_a = (transa == FLA_TRANSPOSE || transa == FLA_CONJ_TRANSPOSE);
+  int is_trans_b = (transb == FLA_TRANSPOSE || transb == FLA_CONJ_TRANSPOSE);
+
+  if (is_trans_a) A.create(datatype, k, m);
+  else            A.create(datatype, m, k);
+  if (is_trans_b) B.create(datatype, n, k);
+  else            B.create(datatype, k, n);
+  C.create(datatype, m, n);
+  D.create(datatype, m, n);
+
+  FLA_Random_matrix(~A);
+  FLA_Random_matrix(~B);
+  FLA_Random_matrix(~C);
+
+  if (is_beta) {
+    FLA_Copy( ~C, ~D );
+  } else {
+    FLA_Set( FLA_ZERO, ~C );
+    test_set_nan( ~D );
+  }
+
+  FLA_Gemm( transa, transb, FLA_MINUS_ONE, ~A, ~B, beta, ~C );
+  is_done = linal::gemm_kernel( transa, transb, FLA_MINUS_ONE, 
+                                ~A, ~B, beta, ~D );
+
+  double diff = test_diff( ~D, ~C );
+
+  A.free(); B.free(); C.free(); D.free();
+
+  return diff;
+}
+
+int main(int argc, char **argv) {
+
+  if (argc != 3) {
+    printf("Try :: gemm_kernel [isa] [datatype]\n");
+    printf(" - isa 0 (scalar), 1 (avx2), 2 (avx512), datatype 2 (d), 4 (z)\n");
+    return -1;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  FLA_Init();
+
+  int datatype = test_datatype( atoi( (argv[2]) ) );
+  int mr, nr;
+
+  // ** an isa the cpu does not have falls back, the tile follows it
+  linal::set_gemm_kernel_isa( atoi( (argv[1]) ) );
+  micro_tile( linal::get_gemm_kernel_isa(), test_is_complex(datatype), mr, nr );
+
+  // ---------------------------------------
+  // ** m in { 1, mr-1, mr+1 }, n in { 1, nr-1, nr+1 }, k in { 1, 3, 17 }
+  int m[3] = { 1, mr-1, mr+1 }, n[3] = { 1, nr-1, nr+1 }, k[3] = { 1, 3, 17 };
+  int is_done = true;
+  double diff = 0.0;
+
+  for (int ta=0;ta<4;++ta)
+    for (int tb=0;tb<4;++tb)
+      for (int is_beta=0;is_beta<2;++is_beta)
+        for (int i=0;i<3;++i)
+          for (int j=0;j<3;++j)
+            for (int l=0;l<3;++l) {
+              int done;
+              double d = gemm_kernel_case( datatype, test_trans(ta), test_trans(tb), 
+                                           is_beta, m[i], n[j], k[l], done );
+              if (!done || !(d < test_tol(datatype))) 
+                printf(" - transa %d, transb %d, beta %d, m %d, n %d, k %d :: %E\n",
+                       ta, tb, is_beta, m[i], n[j], k[l], d);
+              if (!(d <= diff)) diff = d;
+              is_done = (is_done && done);
+            }
+
+  // ---------------------------------------
+  // ** Check
+  int rval;
+
+  printf("- TEST::");
+  for (int i=0;i<argc;++i)
+    printf(" %s ", argv[i] );
+  printf("\n");
+
+  if (is_done && diff < test_tol(datatype)) {
+    printf("PASS::Diff :: %E \n", diff);   rval = 0;
+  } else {
+    printf("FAIL::Diff :: %E \n", diff);   rval = -1;
+  }
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return rval;
+}
@@ -0,0 +1,268 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_test.hxx"
+#include "linal/kernel.hxx"
+
+// ** compile time kernels of kernel.hxx against FLAME on small sizes,
+//    every trans and conj combination and beta zero on a nan C
+
+using namespace linal::kernel;
+
+// ** well conditioned triangle, off diagonals scaled by 1/m
+static void diag_dominant(FLA_Obj A) {
+  int datatype = FLA_Obj_datatype( A ), m = FLA_Obj_length( A );
+  int nv = (test_is_complex(datatype) ? 2 : 1), cs = FLA_Obj_col_stride( A );
+  for (int j=0;j<m;++j)
+    for (int i=0;i<m;++i) 
+      for (int l=0;l<nv;++l) {
+        int offs = nv*(i + j*cs) + l;
+        double s = 1.0/m, d = ((i == j && !l) ? 1.0 : 0.0);
+        if (datatype == LINAL_SINGLE_REAL || datatype == LINAL_SINGLE_COMPLEX) {
+          float *a = (float*)FLA_Obj_buffer_at_view( A ) + offs;
+          *a = *a*s + d;
+        } else {
+          double *a = (double*)FLA_Obj_buffer_at_view( A ) + offs;
+          *a = *a*s + d;
+        }
+      }
+}
+
+// ---------------------------------------
+// ** Gemm_
+template<typename T, int TA, int TB>
+static double gemm_case(int datatype, int is_beta, int m, int n, int k) {
+  linal::Flat_ A, B, C, D;
+
+  int is_trans_a = (TA == FLA_TRANSPOSE || TA == FLA_CONJ_TRANSPOSE);
+  int is_trans_b = (TB == FLA_TRANSPOSE || TB == FLA_CONJ_TRANSPOSE);
+
+  if (is_trans_a) A.create(datatype, k, m);
+  else            A.create(datatype, m, k);
+  if (is_trans_b) B.create(datatype, n, k);
+  else            B.create(datatype, k, n);
+  C.create(datatype, m, n);
+  D.create(datatype, m, n);
+
+  FLA_Random_matrix(~A);
+  FLA_Random_matrix(~B);
+  FLA_Random_matrix(~C);
+
+  if (is_beta) {
+    FLA_Copy( ~C, ~D );
+  } else {
+    FLA_Set( FLA_ZERO, ~C );
+    test_set_nan( ~D );
+  }
+
+  FLA_Gemm( TA, TB, FLA_MINUS_ONE, ~A, ~B, (is_beta ? FLA_ONE : FLA_ZERO), ~C );
+  Gemm_<T,TA,TB>::run( T(-1), View_<T>(~A), View_<T>(~B), 
+                       (is_beta ? T(1) : T(0)), View_<T>(~D) );
+
+  double diff = test_diff( ~D, ~C );
+
+  A.free(); B.free(); C.free(); D.free();
+
+  return diff;
+}
+
+template<typename T, int TA>
+static double gemm_tb(int tb, int datatype, int is_beta, int m, int n, int k) {
+  switch (tb) {
+  case FLA_TRANSPOSE:         
+    return gemm_case<T,TA,FLA_TRANSPOSE>        ( datatype, is_beta, m, n, k );
+  case FLA_CONJ_TRANSPOSE:    
+    return gemm_case<T,TA,FLA_CONJ_TRANSPOSE>   ( datatype, is_beta, m, n, k );
+  case FLA_CONJ_NO_TRANSPOSE: 
+    return gemm_case<T,TA,FLA_CONJ_NO_TRANSPOSE>( datatype, is_beta, m, n, k );
+  }
+  return gemm_case<T,TA,FLA_NO_TRANSPOSE>( datatype, is_beta, m, n, k );
+}
+
+template<typename T>
+static double gemm_ta(int ta, int tb, int datatype, int is_beta, 
+                      int m, int n, int k) {
+  switch (ta) {
+  case FLA_TRANSPOSE:         
+    return gemm_tb<T,FLA_TRANSPOSE>        ( tb, datatype, is_beta, m, n, k );
+  case FLA_CONJ_TRANSPOSE:    
+    return gemm_tb<T,FLA_CONJ_TRANSPOSE>   ( tb, datatype, is_beta, m, n, k );
+  case FLA_CONJ_NO_TRANSPOSE: 
+    return gemm_tb<T,FLA_CONJ_NO_TRANSPOSE>( tb, datatype, is_beta, m, n, k );
+  }
+  return gemm_tb<T,FLA_NO_TRANSPOSE>( tb, datatype, is_beta, m, n, k );
+}
+
+// ---------------------------------------
+// ** Trsm_
+template<typename T, int Side, int Uplo, int Trans, int Diag>
+static double trsm_case(int datatype, int m, int n) {
+  linal::Flat_ A, B, C;
+
+  int mn = (Side == FLA_LEFT ? m : n);
+
+  A.create(datatype, mn, mn);
+  B.create(datatype, m, n);
+  C.create(datatype, m, n);
+
+  FLA_Random_matrix(~A);
+  diag_dominant(~A);
+  FLA_Random_matrix(~B);
+  FLA_Copy( ~B, ~C );
+
+  FLA_Trsm( Side, Uplo, Trans, Diag, FLA_MINUS_ONE, ~A, ~C );
+  Trsm_<T,Side,Uplo,Trans,Diag>::run( T(-1), View_<T>(~A), View_<T>(~B) );
+
+  double diff = test_diff( ~B, ~C );
+
+  A.free(); B.free(); C.free();
+
+  return diff;
+}
+
+template<typename T, int Side, int Uplo, int Trans>
+static double trsm_diag(int diag, int datatype, int m, int n) {
+  if (diag == FLA_UNIT_DIAG)
+    return trsm_case<T,Side,Uplo,Trans,FLA_UNIT_DIAG>   ( datatype, m, n );
+  return   trsm_case<T,Side,Uplo,Trans,FLA_NONUNIT_DIAG>( datatype, m, n );
+}
+
+template<typename T, int Side, int Uplo>
+static double trsm_trans(int trans, int diag, int datatype, int m, int n) {
+  switch (trans) {
+  case FLA_TRANSPOSE:         
+    return trsm_diag<T,Side,Uplo,FLA_TRANSPOSE>        ( diag, datatype, m, n );
+  case FLA_CONJ_TRANSPOSE:    
+    return trsm_diag<T,Side,Uplo,FLA_CONJ_TRANSPOSE>   ( diag, datatype, m, n );
+  case FLA_CONJ_NO_TRANSPOSE: 
+    return trsm_diag<T,Side,Uplo,FLA_CONJ_NO_TRANSPOSE>( diag, datatype, m, n );
+  }
+  return trsm_diag<T,Side,Uplo,FLA_NO_TRANSPOSE>( diag, datatype, m, n );
+}
+
+template<typename T>
+static double trsm_side(int side, int uplo, int trans, int diag, 
+                        int datatype, int m, int n) {
+  if (side == FLA_LEFT) {
+    if (uplo == FLA_LOWER_TRIANGULAR) 
+      return trsm_trans<T,FLA_LEFT,FLA_LOWER_TRIANGULAR> ( trans, diag, datatype, m, n );
+    return   trsm_trans<T,FLA_LEFT,FLA_UPPER_TRIANGULAR> ( trans, diag, datatype, m, n );
+  }
+  if (uplo == FLA_LOWER_TRIANGULAR) 
+    return trsm_trans<T,FLA_RIGHT,FLA_LOWER_TRIANGULAR>( trans, diag, datatype, m, n );
+  return   trsm_trans<T,FLA_RIGHT,FLA_UPPER_TRIANGULAR>( trans, diag, datatype, m, n );
+}
+
+// ---------------------------------------
+template<typename T>
+static double kernel_test(int datatype) {
+  // ** around the packed micro tiles, mr and nr are 4, 8 or 16
+  int size[7] = { 1, 3, 5, 7, 9, 15, 17 }, k[3] = { 1, 5, 17 };
+  double diff = 0.0, d;
+
+  for (int ta=0;ta<4;++ta)
+    for (int tb=0;tb<4;++tb)
+      for (int is_beta=0;is_beta<2;++is_beta)
+        for (int i=0;i<7;++i)
+          for (int j=0;j<7;++j)
+            for (int l=0;l<3;++l) {
+              d = gemm_ta<T>( test_trans(ta), test_trans(tb), datatype, is_beta, 
+                              size[i], size[j], k[l] );
+              if (!(d < test_tol(datatype)))
+                printf(" - gemm transa %d, transb %d, beta %d, m %d, n %d, k %d :: %E\n",
+                       ta, tb, is_beta, size[i], size[j], k[l], d);
+              if (!(d <= diff)) diff = d;
+            }
+
+  int side[2] = { FLA_LEFT, FLA_RIGHT };
+  int uplo[2] = { FLA_LOWER_TRIANGULAR, FLA_UPPER_TRIANGULAR };
+  int diag[2] = { FLA_NONUNIT_DIAG, FLA_UNIT_DIAG };
+
+  for (int s=0;s<2;++s)
+    for (int u=0;u<2;++u)
+      for (int t=0;t<4;++t)
+        for (int g=0;g<2;++g)
+          for (int i=0;i<7;++i)
+            for (int j=0;j<7;++j) {
+              d = trsm_side<T>( side[s], uplo[u], test_trans(t), diag[g],
+                                datatype, size[i], size[j] );
+              if (!(d < test_tol(datatype)))
+                printf(" - trsm side %d, uplo %d, trans %d, diag %d, m %d, n %d :: %E\n",
+                       s, u, t, g, size[i], size[j], d);
+              if (!(d <= diff)) diff = d;
+            }
+
+  return diff;
+}
+
+int main(int argc, char **argv) {
+
+  if (argc != 2) {
+    printf("Try :: kernel [datatype]\n");
+    printf(" - datatype 1 (s), 2 (d), 3 (c), 4 (z)\n");
+    return -1;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  FLA_Init();
+
+  int datatype = test_datatype( atoi( (argv[1]) ) );
+  double diff = 0.0;
+
+  switch (datatype) {
+  case LINAL_SINGLE_REAL:    diff = kernel_test< float >( datatype );                break;
+  case LINAL_DOUBLE_REAL:    diff = kernel_test< double >( datatype );               break;
+  case LINAL_SINGLE_COMPLEX: diff = kernel_test< std::complex<float> >( datatype );  break;
+  case LINAL_DOUBLE_COMPLEX: diff = kernel_test< std::complex<double> >( datatype ); break;
+  }
+
+  // ---------------------------------------
+  // ** Check
+  int rval;
+
+  printf("- TEST::");
+  for (int i=0;i<argc;++i)
+    printf(" %s ", argv[i] );
+  printf("\n");
+
+  if (diff < test_tol(datatype)) {
+    printf("PASS::Diff :: %E \n", diff);   rval = 0;
+  } else {
+    printf("FAIL::Diff :: %E \n", diff);   rval = -1;
+  }
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return rval;
+}
@@ -37,27 +37,44 @@ int main(int argc, char **argv) {
   linal::Flat_  A,  B, norm;
   linal::Hier_ hA;
 
-  if (argc != 2) {
-    printf("Try :: lu_nopiv [thread]\n");
+  if (argc != 2 && argc != 6) {
+    printf("Try :: lu_nopiv [thread] ([variant] [n] [bmn] [param])\n");
+    printf(" - variant 0 (dense), 1 (dense recursive), 2 (flat recursive),\n");
+    printf("           3 (dense with lookahead)\n");
+    printf(" - param   recursive base (1, 2), lookahead depth (3)\n");
     return -1;
   }
 
   int datatype = TEST_DATATYPE;
   int nthread = atoi( (argv[1]) );
 
+  // ** optional :: 0 - dense, 1 - dense recursive, 2 - flat recursive,
+  //                3 - dense with lookahead of param block columns
+  int variant = 0, n = N, bmn = BMN, param = 0;
+  if (argc == 6) {
+    variant = atoi( (argv[2]) );
+    n       = atoi( (argv[3]) );
+    bmn     = atoi( (argv[4]) );
+    param   = atoi( (argv[5]) );
+  }
+  if (variant == 1 || variant == 2) 
+    linal::set_recursive_base( param );
+  if (variant == 3) 
+    linal::dense::set_lookahead( param );
+
   // ---------------------------------------
   // ** Initialization 
   FLA_Init();
 
   // ---------------------------------------
   // ** Matrices
-  A.create   (datatype, N, N);
-  B.create   (datatype, N, N);
+  A.create   (datatype, n, n);
+  B.create   (datatype, n, n);
   norm.create(datatype, 1, 1);
 
   FLA_Random_spd_matrix( FLA_LOWER_TRIANGULAR, ~A);
 
-  hA.create(A, BMN, BMN);
+  hA.create(A, bmn, bmn);
 
   FLA_Copy(~A, ~B);
 
@@ -71,7 +88,11 @@ int main(int argc, char **argv) {
 #pragma omp parallel
   {
 #pragma omp single nowait
-    linal::dense::lu_nopiv( hA );
+    switch (variant) {
+    case 1:  linal::dense::lu_nopiv_rec( hA ); break;
+    case 2:  linal::lu_nopiv_rec( A );         break;
+    default: linal::dense::lu_nopiv( hA );     break;
+    }
   }
 
   // ---------------------------------------
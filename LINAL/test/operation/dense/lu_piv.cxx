@@ -32,38 +32,108 @@
 */
 #include "dense_test.hxx"
 
+// ** tournament pivoting may not lose more than this factor in
+//    backward error and growth against partial pivoting
+#define LU_PIV_PANEL_FACTOR 10.0
+
+static double norm1(FLA_Obj A) {
+  linal::Flat_ norm;
+  double re, im;
+
+  norm.create(FLA_Obj_datatype( A ), 1, 1);
+  FLA_Norm1( A, ~norm );
+  test_get( ~norm, 0, 0, re, im );
+  norm.free();
+
+  return re;
+}
+
+// ** || A x - b || / ( || A || || x || ) 
+static double lu_piv_residual(FLA_Obj A, FLA_Obj LU, FLA_Obj p, FLA_Obj B) {
+  linal::Flat_ X, R;
+
+  X.create(FLA_Obj_datatype( B ), FLA_Obj_length( B ), FLA_Obj_width( B ));
+  R.create(FLA_Obj_datatype( B ), FLA_Obj_length( B ), FLA_Obj_width( B ));
+
+  FLA_LU_piv_solve( LU, p, B, ~X );
+  FLA_Copy( B, ~R );
+  FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, 
+            FLA_ONE, A, ~X, FLA_MINUS_ONE, ~R );
+
+  double residual = norm1( ~R )/(norm1( A )*norm1( ~X ));
+
+  X.free(); R.free();
+
+  return residual;
+}
+
+// ** || U || / || A ||
+static double lu_piv_growth(FLA_Obj A, FLA_Obj LU) {
+  linal::Flat_ U;
+
+  U.create(FLA_Obj_datatype( LU ), FLA_Obj_length( LU ), FLA_Obj_width( LU ));
+  FLA_Copy( LU, ~U );
+  FLA_Triangularize( FLA_UPPER_TRIANGULAR, FLA_NONUNIT_DIAG, ~U );
+
+  double growth = norm1( ~U )/norm1( A );
+
+  U.free();
+
+  return growth;
+}
+
 int main(int argc, char **argv) {
 
 
-  linal::Flat_ A1, A2, B, X1, X2, p1, p2, norm;
-  linal::Hier_ hA2, hp2;;
+  linal::Flat_ A0, A1, A2, B, X1, X2, p1, p2, norm;
+  linal::Hier_ hA1, hp1, hA2, hp2;
 
-  if (argc != 2) {
-    printf("Try :: lu_piv [thread]\n");
+  if (argc != 2 && argc != 6) {
+    printf("Try :: lu_piv [thread] ([variant] [n] [bmn] [param])\n");
+    printf(" - variant 0 (dense), 1 (dense recursive), 2 (flat recursive),\n");
+    printf("           3 (tournament pivoting against partial pivoting),\n");
+    printf("           4 (dense with lookahead)\n");
+    printf(" - param   recursive base (1, 2), panel threshold (3),\n");
+    printf("           lookahead depth (4)\n");
     return -1;
   }
 
   int datatype = TEST_DATATYPE;
   int nthread = atoi( (argv[1]) );
 
+  // ** optional :: 0 - dense, 1 - dense recursive, 2 - flat recursive,
+  //                3 - dense with panels of param block rows,
+  //                4 - dense with lookahead of param block columns
+  int variant = 0, n = N, bmn = BMN, param = 0;
+  if (argc == 6) {
+    variant = atoi( (argv[2]) );
+    n       = atoi( (argv[3]) );
+    bmn     = atoi( (argv[4]) );
+    param   = atoi( (argv[5]) );
+  }
+  if (variant == 1 || variant == 2) 
+    linal::set_recursive_base( param );
+  if (variant == 4) 
+    linal::dense::set_lookahead( param );
+
   // ---------------------------------------
   // ** Initialization 
   FLA_Init();
 
   // ---------------------------------------
   // ** Matrices
-  A1.create   (datatype, N, N);
-  A2.create   (datatype, N, N);
-  hA2.create  (A2, BMN, BMN);
+  A1.create   (datatype, n, n);
+  A2.create   (datatype, n, n);
+  hA2.create  (A2, bmn, bmn);
 
-  B.create    (datatype, N, 1);
+  B.create    (datatype, n, 1);
 
-  X1.create   (datatype, N, 1);
-  X2.create   (datatype, N, 1);
+  X1.create   (datatype, n, 1);
+  X2.create   (datatype, n, 1);
 
-  p1.create   (LINAL_INT,  N, 1);
-  p2.create   (LINAL_INT,  N, 1);
-  hp2.create  (p2, BMN, BMN);
+  p1.create   (LINAL_INT,  n, 1);
+  p2.create   (LINAL_INT,  n, 1);
+  hp2.create  (p2, bmn, bmn);
 
   norm.create(datatype, 1, 1);
 
@@ -72,8 +142,16 @@ int main(int argc, char **argv) {
   FLA_Random_matrix(~B);
 
   // ---------------------------------------
-  // ** FLAME
-  FLA_LU_piv(~A1,~p1);
+  // ** FLAME, tournament pivoting is compared with dense lu_piv
+  if (variant == 3) {
+    A0.create   (datatype, n, n);
+    FLA_Copy(~A1, ~A0);
+
+    hA1.create  (A1, bmn, bmn);
+    hp1.create  (p1, bmn, bmn);
+  } else {
+    FLA_LU_piv(~A1,~p1);
+  }
 
   // ---------------------------------------
   // ** LINAL
@@ -81,11 +159,50 @@ int main(int argc, char **argv) {
 #pragma omp parallel
   {
 #pragma omp single nowait
-    linal::dense::lu_piv( hA2, hp2 );
+    switch (variant) {
+    case 1:  linal::dense::lu_piv_rec( hA2, hp2 ); break;
+    case 2:  linal::lu_piv_rec( A2, p2 );          break;
+    case 3:  
+      linal::dense::set_lu_piv_panel_threshold( 0 );
+      linal::dense::lu_piv( hA1, hp1 );
+      linal::dense::set_lu_piv_panel_threshold( param );
+      linal::dense::lu_piv( hA2, hp2 );
+      break;
+    default: linal::dense::lu_piv( hA2, hp2 );     break;
+    }
   }
 
   // ---------------------------------------
   // ** Check
+  if (variant == 3) {
+    double res1 = lu_piv_residual( ~A0, ~A1, ~p1, ~B );
+    double res2 = lu_piv_residual( ~A0, ~A2, ~p2, ~B );
+    double gro1 = lu_piv_growth( ~A0, ~A1 );
+    double gro2 = lu_piv_growth( ~A0, ~A2 );
+
+    printf("- TEST::");
+    for (int i=0;i<argc;++i)
+      printf(" %s ", argv[i] );
+    printf("\n");
+    printf("Residual :: %E ( panel 0 ), %E ( panel %d )\n", res1, res2, param);
+    printf("Growth   :: %E ( panel 0 ), %E ( panel %d )\n", gro1, gro2, param);
+
+    int rval;
+    if (res2 <= LU_PIV_PANEL_FACTOR*res1 && gro2 <= LU_PIV_PANEL_FACTOR*gro1) {
+      printf("PASS::Residual :: %E \n", res2);   rval = 0;
+    } else {
+      printf("FAIL::Residual :: %E \n", res2);   rval = -1;
+    }
+
+    A0.free();
+    A1.free();  A2.free();   hA1.free();  hA2.free(); 
+    p1.free();  p2.free();   hp1.free();  hp2.free();
+    B.free();   X1.free();   X2.free();   norm.free();
+
+    FLA_Finalize();
+    return rval;
+  }
+
   FLA_LU_piv_solve(~A1, ~p1, ~B, ~X1);
   FLA_LU_piv_solve(~A2, ~p2, ~B, ~X2);
 
@@ -41,5 +41,44 @@ n_fail=0;
 ./lu_piv 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 ./lu_piv 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 
+# ** small sizes around the block and the recursive base
+./lu_piv 1 0 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 0 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 0 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 0 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./lu_piv 1 1 1 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 1 7 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 1 9 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 1 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 1 1 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 1 7 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 1 9 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 1 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./lu_piv 1 2 1 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 2 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 2 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 2 33 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 2 1 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 2 7 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 2 9 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 2 33 4 8 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+# ** tournament pivoting, residual and growth against partial pivoting
+./lu_piv 1 3 1000 192 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 3 1000 192 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 3 33 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 3 33 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 3 9 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+# ** lookahead of 1, 2 and 3 block columns
+./lu_piv 1 4 1000 192 1 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 4 1000 192 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 4 4 33 4 1 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 1 4 33 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 2 4 33 4 3 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./lu_piv 4 4 9 4 2 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
 exit $n_fail
 
@@ -0,0 +1,235 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_test.hxx"
+
+// ** dense qr with TSQR panels against FLA_QR_UT panels ( threshold 0 ).
+//    Q and R may differ in signs, so Q R and the projection Q Q^H C
+//    are compared. A panel whose T is not n x n has to fall back to
+//    FLA_QR_UT and is checked by Q R as well.
+
+static void qr_apply(int trans, linal::Hier_ &hA, linal::Hier_ &hT, 
+                     linal::Flat_ &B, int bmn) {
+  linal::Flat_ W;
+  linal::Hier_ hB, hW;
+
+  W.create  ( B.get_data_type(), hT.flat().get_m(), B.get_n() );
+  hW.create ( W, bmn, bmn );
+  hB.create ( B, bmn, bmn );
+
+#pragma omp parallel
+  {
+#pragma omp single nowait
+    linal::dense::apply_q( FLA_LEFT, trans, FLA_FORWARD, FLA_COLUMNWISE,
+                           hA, hT, hW, hB );
+  }
+
+  hB.free();
+  hW.free(); W.free();
+}
+
+// ** max | Q R - A | relative to A
+static double qr_residual(linal::Hier_ &hA, linal::Hier_ &hT, 
+                          linal::Flat_ &A, linal::Flat_ &A0, int bmn) {
+  linal::Flat_ B;
+  FLA_Obj AT, AB, BT, BB;
+
+  B.create( A.get_data_type(), A.get_m(), A.get_n() );
+  FLA_Set( FLA_ZERO, ~B );
+
+  FLA_Part_2x1( ~A, &AT, 
+                    &AB, A.get_n(), FLA_TOP );
+  FLA_Part_2x1( ~B, &BT, 
+                    &BB, A.get_n(), FLA_TOP );
+  FLA_Copyr( FLA_UPPER_TRIANGULAR, AT, BT );
+
+  qr_apply( FLA_NO_TRANSPOSE, hA, hT, B, bmn );
+
+  double diff = test_diff( ~B, ~A0 );
+  B.free();
+
+  return diff;
+}
+
+// ** max | Q R - A | relative to A for a single panel, flat T of any length
+static double qr_residual_flat(linal::Flat_ &A, linal::Flat_ &T, 
+                               linal::Flat_ &A0) {
+  linal::Flat_ B, W;
+  FLA_Obj AT, AB, BT, BB;
+
+  B.create( A.get_data_type(), A.get_m(), A.get_n() );
+  W.create( A.get_data_type(), T.get_m(), A.get_n() );
+  FLA_Set( FLA_ZERO, ~B );
+
+  FLA_Part_2x1( ~A, &AT, 
+                    &AB, A.get_n(), FLA_TOP );
+  FLA_Part_2x1( ~B, &BT, 
+                    &BB, A.get_n(), FLA_TOP );
+  FLA_Copyr( FLA_UPPER_TRIANGULAR, AT, BT );
+
+  FLA_Apply_Q_UT( FLA_LEFT, FLA_NO_TRANSPOSE, FLA_FORWARD, FLA_COLUMNWISE,
+                  ~A, ~T, ~W, ~B );
+
+  double diff = test_diff( ~B, ~A0 );
+  B.free();
+  W.free();
+
+  return diff;
+}
+
+// ** C := Q Q^H C
+static void qr_project(linal::Hier_ &hA, linal::Hier_ &hT, 
+                       linal::Flat_ &C, int n, int bmn) {
+  FLA_Obj CT, CB;
+
+  qr_apply( FLA_CONJ_TRANSPOSE, hA, hT, C, bmn );
+  FLA_Part_2x1( ~C, &CT, 
+                    &CB, n, FLA_TOP );
+  FLA_Set( FLA_ZERO, CB );
+  qr_apply( FLA_NO_TRANSPOSE, hA, hT, C, bmn );
+}
+
+int main(int argc, char **argv) {
+
+  linal::Flat_  A0, A1, A2, A3, T1, T2, T3, C1, C2;
+  linal::Hier_ hA1, hA2, hA3, hT1, hT2, hT3;
+
+  if (argc != 7) {
+    printf("Try :: qr_panel [thread] [datatype] [m] [n] [bmn] [threshold]\n");
+    printf(" - datatype 2 (d), 4 (z), threshold in block rows\n");
+    return -1;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  FLA_Init();
+
+  int nthread   = atoi( (argv[1]) );
+  int datatype  = test_datatype( atoi( (argv[2]) ) );
+  int m         = atoi( (argv[3]) );
+  int n         = atoi( (argv[4]) );
+  int bmn       = atoi( (argv[5]) );
+  int threshold = atoi( (argv[6]) );
+
+  omp_set_num_threads( nthread );
+
+  // ---------------------------------------
+  // ** Matrices
+  A0.create(datatype, m, n);
+  A1.create(datatype, m, n);
+  A2.create(datatype, m, n);
+  A3.create(datatype, m, n);
+  T1.create(datatype, n, n);
+  T2.create(datatype, n, n);
+
+  // ** T shorter than the panel width, FLA_QR_UT blocks by its length
+  int tb = max(n/2, 1);
+  T3.create(datatype, tb, n);
+  C1.create(datatype, m, 3);
+  C2.create(datatype, m, 3);
+
+  FLA_Random_matrix(~A0);
+  FLA_Copy(~A0, ~A1);
+  FLA_Copy(~A0, ~A2);
+  FLA_Copy(~A0, ~A3);
+  FLA_Random_matrix(~C1);
+  FLA_Copy(~C1, ~C2);
+
+  hA1.create(A1, bmn, bmn);
+  hA2.create(A2, bmn, bmn);
+  hT1.create(T1, bmn, bmn);
+  hT2.create(T2, bmn, bmn);
+
+  // ** one block column, qr_panel directly
+  hA3.create(A3, bmn, n);
+  hT3.create(T3, tb, n);
+
+  // ---------------------------------------
+  // ** LINAL
+#pragma omp parallel
+  {
+#pragma omp single nowait
+    {
+      linal::dense::set_qr_panel_threshold( 0 );
+      linal::dense::qr( hA1, hT1 );
+
+      linal::dense::set_qr_panel_threshold( threshold );
+      linal::dense::qr( hA2, hT2 );
+
+      linal::dense::qr_panel( hA3, hT3 );
+    }
+  }
+
+  // ---------------------------------------
+  // ** Check
+  double res1 = qr_residual( hA1, hT1, A1, A0, bmn );
+  double res2 = qr_residual( hA2, hT2, A2, A0, bmn );
+  double res3 = qr_residual_flat( A3, T3, A0 );
+
+  qr_project( hA1, hT1, C1, n, bmn );
+  qr_project( hA2, hT2, C2, n, bmn );
+
+  double diff = test_diff( ~C2, ~C1 );
+
+  int rval;
+
+  printf("- TEST::");
+  for (int i=0;i<argc;++i)
+    printf(" %s ", argv[i] );
+  printf("\n");
+  printf("QR - A   :: %E ( panel 0 ), %E ( panel %d )\n", res1, res2, threshold);
+  printf("QR - A   :: %E ( T %d x %d )\n", res3, tb, n);
+  printf("Q Q^H C  :: %E \n", diff);
+
+  if (res1 < test_tol(datatype) && res2 < test_tol(datatype) && 
+      res3 < test_tol(datatype) && diff < test_tol(datatype)) {
+    printf("PASS::Diff :: %E \n", diff);   rval = 0;
+  } else {
+    printf("FAIL::Diff :: %E \n", diff);   rval = -1;
+  }
+
+  // ---------------------------------------
+  // ** Matrices
+  A0.free(); 
+  A1.free(); hA1.free(); 
+  A2.free(); hA2.free(); 
+  A3.free(); hA3.free(); 
+  T1.free(); hT1.free();
+  T2.free(); hT2.free();
+  T3.free(); hT3.free();
+  C1.free(); C2.free();
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return rval;
+}
@@ -36,9 +36,13 @@
 
 ./chol.sh
 ./gemm.sh
+./gemm_edge.sh
+./gemm_kernel.sh
+./kernel.sh
 ./lu_incpiv.sh
 ./lu_nopiv.sh
 ./lu_piv.sh
+./qr_panel.sh
 ./syrk.sh
 ./trmm.sh
 ./trsm.sh
@@ -40,8 +40,9 @@ int main(int argc, char **argv) {
 
   FLA_Obj *alpha, *beta;
 
-  if (argc != 6) {
-    printf("Try :: syrk [thread] [uplo] [trans] [alpha] [beta]\n");
+  if (argc != 6 && argc != 7) {
+    printf("Try :: syrk [thread] [uplo] [trans] [alpha] [beta] ([typed])\n");
+    printf(" - typed kernel threshold, 0 is off\n");
     return -1;
   }
 
@@ -49,6 +50,9 @@ int main(int argc, char **argv) {
   int nthread = atoi( (argv[1]) );
   int datatype = TEST_DATATYPE;
 
+  if (argc == 7)
+    linal::set_typed_kernel_threshold( atoi( (argv[6]) ) );
+
   // ---------------------------------------
   // ** Initialization
   FLA_Init();
@@ -56,5 +56,14 @@ n_fail=0;
 ./syrk 4 0 1 1 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 ./syrk 4 1 1 0 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 
+# ** typed block kernel on, the default threshold is 0 ( off )
+./syrk 2 0 0 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./syrk 2 1 0 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./syrk 2 0 1 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./syrk 2 1 1 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./syrk 3 0 0 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./syrk 3 1 1 1 1 64 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
 exit $n_fail
 
@@ -40,8 +40,9 @@ int main(int argc, char **argv) {
 
   FLA_Obj *alpha;
 
-  if (argc != 7) {
-    printf("Try :: trsm [thread] [side] [uplo] [trans] [diag] [alpha]\n");
+  if (argc != 7 && argc != 10) {
+    printf("Try :: trsm [thread] [side] [uplo] [trans] [diag] [alpha] ([n] [bmn] [typed])\n");
+    printf(" - typed kernel threshold, 0 is off\n");
     return -1;
   }
 
@@ -50,6 +51,14 @@ int main(int argc, char **argv) {
 
   int datatype = TEST_DATATYPE;
 
+  // ** optional :: small sizes on the typed block kernel
+  int n = N, bmn = BMN;
+  if (argc == 10) {
+    n   = atoi( (argv[7]) );
+    bmn = atoi( (argv[8]) );
+    linal::set_typed_kernel_threshold( atoi( (argv[9]) ) );
+  }
+
   // ---------------------------------------
   // ** Initialization 
   FLA_Init();
@@ -67,16 +76,16 @@ int main(int argc, char **argv) {
 
   // ---------------------------------------
   // ** Matrices
-  A.create   (datatype, N, N);
-  B.create   (datatype, N, N);
-  C.create   (datatype, N, N);
+  A.create   (datatype, n, n);
+  B.create   (datatype, n, n);
+  C.create   (datatype, n, n);
   norm.create(datatype, 1, 1);
 
   FLA_Random_spd_matrix(uplo, ~A);
   FLA_Random_matrix(~B);
 
-  hA.create(A, BMN, BMN);
-  hB.create(B, BMN, BMN);
+  hA.create(A, bmn, bmn);
+  hB.create(B, bmn, bmn);
 
   FLA_Copy(~B, ~C);
 
@@ -76,6 +76,41 @@ n_fail=0;
 ./trsm 4 0 1 1 1 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 ./trsm 4 1 1 1 1 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
 
+# ** small sizes, typed block kernel on ( 4 ) and off ( 0 )
+./trsm 2 0 0 0 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 0 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 1 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 1 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 0 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 0 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 1 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 1 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 0 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 0 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 1 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 1 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 0 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 0 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 1 0 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 1 1 0 9 4 4 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
+./trsm 2 0 0 0 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 0 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 1 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 0 1 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 0 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 0 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 1 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 0 1 1 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 0 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 0 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 1 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 0 1 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 0 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 0 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 1 0 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+./trsm 2 1 1 1 1 0 9 4 0 ;if [ $? -ne 0 ]; then n_fail=$(( n_fail + 1 ));fi;
+
 exit $n_fail 
 
 
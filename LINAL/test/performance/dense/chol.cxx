@@ -34,8 +34,8 @@
 
 int main(int argc, char **argv) {
 
-  if (argc != 5) {
-    printf("Try :: chol [thread] [blocksize] [ndof] [nitr]\n");
+  if (argc < 5 || argc > 6) {
+    printf("Try :: chol [thread] [blocksize] [ndof] [nitr] [lookahead]\n");
     return 0;
   }
 
@@ -47,11 +47,16 @@ int main(int argc, char **argv) {
   ndof      = atoi( (argv[3]) );
   nitr      = atoi( (argv[4]) );
 
+  // ** block columns of lookahead, 0 is the plain right-looking loop
+  if (argc == 6) 
+    linal::dense::set_lookahead( atoi( (argv[5]) ) );
+
   printf("** TEST ENVIRONMENT **\n");
   printf("NDOF      = %d\n", ndof);
   printf("Blocksize = %d\n", blocksize);
   printf("N thread  = %d\n", nthread);
   printf("Iteration = %d\n", nitr);
+  printf("Lookahead = %d\n", linal::dense::get_lookahead());
 
   int b_mn[2];
   b_mn[0] = b_mn[1] = blocksize;
@@ -70,3 +70,9 @@ done ;
 
 
 
+
+echo '****** Test for lookahead depth *******'
+
+for i in 0 1 2 4 ; do \
+./chol 24 256 8000 3 $i
+done ;
@@ -0,0 +1,222 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_perform.hxx"
+
+// ** previous linal::dense::gemm ( nt nt ) : beta is applied in a separate
+//    pass and every inner block p is followed by a taskwait
+static void gemm_per_k(FLA_Obj alpha, linal::Hier_ A, linal::Hier_ B,
+                       FLA_Obj beta,  linal::Hier_ C) {
+  linal::dense::scal( beta, C );
+  for (int p=0;p<A.get_n();++p) {
+    for (int k2=0;k2<C.get_n();++k2) {
+      for (int k1=0;k1<C.get_m();++k1) {
+
+#pragma omp task firstprivate ( k1, k2, p )
+        {
+          linal::gemm_internal( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                                alpha,   A(k1,p), B(p,k2),
+                                FLA_ONE, C(k1,k2) );
+        }
+      }
+    }
+#pragma omp taskwait
+  }
+}
+
+int main(int argc, char **argv) {
+
+  if (argc < 5 || argc > 6) {
+    printf("Try :: gemm [thread] [blocksize] [ndof] [nitr] [typed]\n");
+    return 0;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  int ndof, blocksize, nthread, nitr;
+  nthread   = atoi( (argv[1]) );
+  blocksize = atoi( (argv[2]) );
+  ndof      = atoi( (argv[3]) );
+  nitr      = atoi( (argv[4]) );
+
+  // ** largest block for the typed kernels, 0 is gemm_internal
+  if (argc == 6) 
+    linal::set_typed_kernel_threshold( atoi( (argv[5]) ) );
+
+  printf("** TEST ENVIRONMENT **\n");
+  printf("NDOF      = %d\n", ndof);
+  printf("Blocksize = %d\n", blocksize);
+  printf("N thread  = %d\n", nthread);
+  printf("Iteration = %d\n", nitr);
+  printf("Typed     = %d\n", linal::get_typed_kernel_threshold());
+
+  int b_mn[2];
+  b_mn[0] = b_mn[1] = blocksize;
+
+  FLA_Init();
+
+  // ---------------------------------------
+  // ** Environment setting
+  double flop = linal::get_flop_gemm( 0, ndof, ndof, ndof );
+  FLASH_Queue_set_num_threads(nthread);
+  FLASH_Queue_set_sorting(TRUE);
+  FLASH_Queue_set_caching(TRUE);
+
+  omp_set_num_threads(nthread);
+
+  // ---------------------------------------
+  // ** Matrices
+  double 
+    t_base, t_flash_repack, t_linal_repack, t_temp, 
+    t_flash_gemm, t_linal_gemm, t_per_k_gemm;
+
+  linal::Flat_ A, B, C;
+  A.create(TEST_DATATYPE, ndof, ndof);
+  B.create(TEST_DATATYPE, ndof, ndof);
+  C.create(TEST_DATATYPE, ndof, ndof);
+  FLA_Random_matrix( ~A );
+  FLA_Random_matrix( ~B );
+  FLA_Random_matrix( ~C );
+
+  FLA_Obj hA_fla, hB_fla, hC_fla;
+  t_base = FLA_Clock();
+  FLASH_Obj_create_hier_copy_of_flat(~A, 1, (dim_t*)b_mn, &hA_fla);
+  FLASH_Obj_create_hier_copy_of_flat(~B, 1, (dim_t*)b_mn, &hB_fla);
+  FLASH_Obj_create_hier_copy_of_flat(~C, 1, (dim_t*)b_mn, &hC_fla);
+  t_flash_repack = FLA_Clock()-t_base;
+
+  linal::Hier_ hA_linal, hB_linal, hC_linal;
+  t_base = FLA_Clock();
+  hA_linal.create(A, blocksize, blocksize);
+  hB_linal.create(B, blocksize, blocksize);
+  hC_linal.create(C, blocksize, blocksize);
+  t_linal_repack = FLA_Clock()-t_base;
+
+  // ---------------------------------------
+  // ** FLASH
+  t_flash_gemm = MAX_TIME;
+  for (int q=0;q<nitr;++q) {
+    printf("*** FLASH::GEMM BEGIN ***\n");
+    t_base = FLA_Clock();
+    FLASH_Queue_begin();
+    FLASH_Gemm(FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, 
+               FLA_MINUS_ONE, hA_fla, hB_fla, FLA_ONE, hC_fla);
+    FLASH_Queue_end();
+    t_temp = FLA_Clock()-t_base;
+    printf("*** FLASH::GEMM END ***\n");
+
+    t_flash_gemm = min(t_temp, t_flash_gemm);
+  }
+
+  // ---------------------------------------
+  // ** LINAL before the change, same blocks and kernels
+  t_per_k_gemm = MAX_TIME;
+  for (int q=0;q<nitr;++q) {
+    printf("*** LINAL::GEMM PER K BEGIN ***\n");
+    t_base = FLA_Clock();
+#pragma omp parallel 
+    {
+#pragma omp single nowait
+      gemm_per_k(FLA_MINUS_ONE, hA_linal, hB_linal, 
+                 FLA_ONE, hC_linal);
+    }
+    t_temp = FLA_Clock()-t_base;
+    printf("*** LINAL::GEMM PER K END ***\n");
+
+    t_per_k_gemm = min(t_temp, t_per_k_gemm);
+  }
+
+  // ---------------------------------------
+  // ** LINAL
+  t_linal_gemm = MAX_TIME;
+  for (int q=0;q<nitr;++q) {
+    printf("*** LINAL::GEMM BEGIN ***\n");
+    t_base = FLA_Clock();
+#pragma omp parallel 
+    {
+#pragma omp single nowait
+      linal::dense::gemm(FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, 
+                         FLA_MINUS_ONE, hA_linal, hB_linal, 
+                         FLA_ONE, hC_linal);
+    }
+    t_temp = FLA_Clock()-t_base;
+    printf("*** LINAL::GEMM END ***\n");
+
+    t_linal_gemm = min(t_temp, t_linal_gemm);
+  }
+
+  printf("----------------------------------------------\n");
+  printf("*** Report Gemm ***\n");
+  printf("Ndof       = %d\n", ndof);
+  printf("Blocksize  = %d\n", blocksize);
+  printf("Nthread    = %d\n", nthread);
+  printf("Niteration = %d\n", nitr);
+  printf("----------------------------------------------\n");
+  printf("Time Supermatrix   = %6.3lf [sec]\n", t_flash_gemm);
+  printf("Time LINAL per k   = %6.3lf [sec]\n", t_per_k_gemm);
+  printf("Time LINAL         = %6.3lf [sec]\n", t_linal_gemm);
+  printf("----------------------------------------------\n");
+  printf("FLOPS Supermatrix  = %6.3lf [Gflops]\n", 
+	 flop/t_flash_gemm/1.0e9);
+  printf("FLOPS LINAL per k  = %6.3lf [Gflops]\n", 
+	 flop/t_per_k_gemm/1.0e9);
+  printf("FLOPS LINAL        = %6.3lf [Gflops]\n", 
+	 flop/t_linal_gemm/1.0e9);
+  printf("Speedup over per k = %6.3lf\n", 
+	 t_per_k_gemm/t_linal_gemm);
+  printf("----------------------------------------------\n");
+  printf("With repacking cost \n");
+  printf("FLOPS Supermatrix  = %6.3lf [Gflops]\n", 
+	 flop/(t_flash_gemm+t_flash_repack)/1.0e9);
+  printf("FLOPS LINAL        = %6.3lf [Gflops]\n", 
+	 flop/(t_linal_gemm+t_linal_repack)/1.0e9);
+  printf("----------------------------------------------\n");
+  
+  // ---------------------------------------
+  // ** Matrix
+  FLASH_Obj_free(&hA_fla);
+  FLASH_Obj_free(&hB_fla);
+  FLASH_Obj_free(&hC_fla);
+  hA_linal.free();
+  hB_linal.free();
+  hC_linal.free();
+  A.free();
+  B.free();
+  C.free();
+
+  printf("*** TEST FINISHED ***\n");
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return 0;
+}
@@ -0,0 +1,79 @@
+#!/bin/bash
+
+#
+#   Copyright © 2011, Kyungjoo Kim
+#   All rights reserved.
+#  
+#   This file is part of LINAL.
+#  
+#   Redistribution and use in source and binary forms, with or without
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1. Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2. Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3. Neither the name of the owner nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#   ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#   CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#   POSSIBILITY OF SUCH DAMAGE.
+#
+#!/bin/bash
+
+echo '****** Test for various matrix size *******'
+
+for i in 1000 2000 3000 4000 5000 6000 7000 8000 9000 10000 \
+    15000 20000 25000; do \
+./gemm 24 256 $i 3
+done ;
+
+
+echo '****** Test for various thread size *******'
+
+for i in 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 ; do \
+./gemm $i 256 8000 3
+done ;
+
+echo '****** Test for various matrix size *******'
+
+for i in 1000 2000 3000 4000 5000 6000 7000 8000 9000 10000 \
+    15000 20000 ; do \
+./gemm 24 256 $i 3
+done ;
+
+echo '****** Test for various block size *******'
+
+for i in 96 128 192 256 512 1024 ; do \
+./gemm 24 $i 8000 3
+done ;
+
+
+
+
+
+
+
+
+
+
+
+echo '****** Test for typed kernels on small blocks *******'
+
+for i in 0 64 ; do \
+./gemm 24 32 4000 3 $i
+./gemm 24 64 4000 3 $i
+done ;
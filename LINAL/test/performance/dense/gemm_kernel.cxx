@@ -0,0 +1,127 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of LINAL.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "dense_perform.hxx"
+
+static void run_gemm_kernel(int datatype, int blocksize, int nitr) {
+  int is_complex = (datatype == LINAL_DOUBLE_COMPLEX);
+  double flop = linal::get_flop_gemm( is_complex, 
+                                      blocksize, blocksize, blocksize );
+
+  // ---------------------------------------
+  // ** Matrices
+  linal::Flat_ A, B, C, C_ref;
+  A.create(datatype, blocksize, blocksize);
+  B.create(datatype, blocksize, blocksize);
+  C.create(datatype, blocksize, blocksize);
+  C_ref.create(datatype, blocksize, blocksize);
+  FLA_Random_matrix( ~A );
+  FLA_Random_matrix( ~B );
+  FLA_Random_matrix( ~C_ref );
+
+  double t_base, t_flame, t_kernel[3];
+
+  // ---------------------------------------
+  // ** FLA_Gemm
+  FLA_Copy( ~C_ref, ~C );
+  t_base = FLA_Clock();
+  for (int q=0;q<nitr;++q) 
+    FLA_Gemm(FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+             FLA_MINUS_ONE, ~A, ~B, FLA_ONE, ~C);
+  t_flame = (FLA_Clock()-t_base)/nitr;
+
+  // ---------------------------------------
+  // ** LINAL kernel for each isa available
+  int isa = linal::get_gemm_kernel_isa();
+  for (int i=LINAL_GEMM_KERNEL_SCALAR;i<=isa;++i) {
+    linal::set_gemm_kernel_isa(i);
+    FLA_Copy( ~C_ref, ~C );
+    t_base = FLA_Clock();
+    for (int q=0;q<nitr;++q) 
+      linal::gemm_kernel(FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                         FLA_MINUS_ONE, ~A, ~B, FLA_ONE, ~C);
+    t_kernel[i] = (FLA_Clock()-t_base)/nitr;
+  }
+  linal::set_gemm_kernel_isa(isa);
+
+  const char *name[3] = { "Scalar", "AVX2  ", "AVX512" };
+
+  printf("----------------------------------------------\n");
+  printf("*** Report Gemm Kernel, %s ***\n", 
+         (is_complex ? "double complex" : "double real"));
+  printf("Blocksize  = %d\n", blocksize);
+  printf("Niteration = %d\n", nitr);
+  printf("----------------------------------------------\n");
+  printf("FLOPS FLA_Gemm     = %6.3lf [Gflops]\n", flop/t_flame/1.0e9);
+  for (int i=LINAL_GEMM_KERNEL_SCALAR;i<=isa;++i) 
+    printf("FLOPS %s       = %6.3lf [Gflops]\n", name[i], 
+           flop/t_kernel[i]/1.0e9);
+  printf("----------------------------------------------\n");
+
+  A.free();
+  B.free();
+  C.free();
+  C_ref.free();
+}
+
+int main(int argc, char **argv) {
+
+  if (argc != 3) {
+    printf("Try :: gemm_kernel [blocksize] [nitr]\n");
+    return 0;
+  }
+
+  // ---------------------------------------
+  // ** Initialization
+  int blocksize, nitr;
+  blocksize = atoi( (argv[1]) );
+  nitr      = atoi( (argv[2]) );
+
+  printf("** TEST ENVIRONMENT **\n");
+  printf("Blocksize = %d\n", blocksize);
+  printf("Iteration = %d\n", nitr);
+
+  FLA_Init();
+
+  // ** every size tested goes to the kernel
+  linal::set_gemm_kernel_threshold(blocksize);
+
+  run_gemm_kernel(LINAL_DOUBLE_REAL,    blocksize, nitr);
+  run_gemm_kernel(LINAL_DOUBLE_COMPLEX, blocksize, nitr);
+
+  printf("*** TEST FINISHED ***\n");
+
+  // ---------------------------------------
+  // ** Finalization
+  FLA_Finalize();
+  return 0;
+}
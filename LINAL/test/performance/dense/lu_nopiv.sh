@@ -69,3 +69,9 @@ done ;
 
 
 
+
+echo '****** Test for lookahead depth *******'
+
+for i in 0 1 2 4 ; do \
+./lu_nopiv 24 256 8000 3 $i
+done ;
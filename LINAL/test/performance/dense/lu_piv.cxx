@@ -34,8 +34,8 @@
 
 int main(int argc, char **argv) {
 
-  if (argc != 5) {
-    printf("Try :: lu_piv [thread] [blocksize] [ndof] [nitr]\n");
+  if (argc < 5 || argc > 7) {
+    printf("Try :: lu_piv [thread] [blocksize] [ndof] [nitr] [panel] [lookahead]\n");
     return 0;
   }
 
@@ -47,11 +47,21 @@ int main(int argc, char **argv) {
   ndof      = atoi( (argv[3]) );
   nitr      = atoi( (argv[4]) );
 
+  // ** block rows for tournament pivoting on a panel, 0 is FLA_LU_piv
+  if (argc >= 6) 
+    linal::dense::set_lu_piv_panel_threshold( atoi( (argv[5]) ) );
+
+  // ** block columns of lookahead, 0 is the plain right-looking loop
+  if (argc == 7) 
+    linal::dense::set_lookahead( atoi( (argv[6]) ) );
+
   printf("** TEST ENVIRONMENT **\n");
   printf("NDOF      = %d\n", ndof);
   printf("Blocksize = %d\n", blocksize);
   printf("N thread  = %d\n", nthread);
   printf("Iteration = %d\n", nitr);
+  printf("Panel     = %d\n", linal::dense::get_lu_piv_panel_threshold());
+  printf("Lookahead = %d\n", linal::dense::get_lookahead());
 
   int b_mn[2];
   b_mn[0] = b_mn[1] = blocksize;
@@ -70,3 +70,15 @@ done ;
 
 
 
+
+echo '****** Test for tournament pivoting panel *******'
+
+for i in 0 2 4 8 ; do \
+./lu_piv 24 256 8000 3 $i
+done ;
+
+echo '****** Test for lookahead depth *******'
+
+for i in 0 1 2 4 ; do \
+./lu_piv 24 256 8000 3 4 $i
+done ;
@@ -34,8 +34,8 @@
 
 int main(int argc, char **argv) {
 
-  if (argc != 5) {
-    printf("Try :: qr [thread] [blocksize] [ndof] [nitr]\n");
+  if (argc < 5 || argc > 6) {
+    printf("Try :: qr [thread] [blocksize] [ndof] [nitr] [panel]\n");
     return 0;
   }
 
@@ -47,15 +47,27 @@ int main(int argc, char **argv) {
   ndof      = atoi( (argv[3]) );
   nitr      = atoi( (argv[4]) );
 
+  // ** with panel, LINAL runs qr ( var1 ) and panels of at least this 
+  //    many block rows use TSQR, 0 is FLA_QR_UT; without it qr_inc
+  int is_inc = (argc == 5);
+  if (!is_inc)
+    linal::dense::set_qr_panel_threshold( atoi( (argv[5]) ) );
+
   printf("** TEST ENVIRONMENT **\n");
   printf("NDOF      = %d\n", ndof);
   printf("Blocksize = %d\n", blocksize);
   printf("N thread  = %d\n", nthread);
   printf("Iteration = %d\n", nitr);
+  if (is_inc)
+    printf("Panel     = inc\n");
+  else
+    printf("Panel     = %d\n", linal::dense::get_qr_panel_threshold());
 
   int b_mn[2], t_ndof;
   b_mn[0] = b_mn[1] = blocksize;
   t_ndof = (ndof/blocksize+(ndof%blocksize!=0))*blocksize;
+  if (!is_inc) 
+    t_ndof = ndof;
 
   FLA_Init();
 
@@ -115,7 +127,10 @@ int main(int argc, char **argv) {
 #pragma omp parallel 
     {
 #pragma omp single nowait
-      linal::dense::qr_inc(hA_linal, hT_linal);
+      if (is_inc)
+        linal::dense::qr_inc(hA_linal, hT_linal);
+      else
+        linal::dense::qr(hA_linal, hT_linal);
     }
     t_temp = FLA_Clock()-t_base;
     printf("*** LINAL::QR END ***\n");
@@ -35,6 +35,8 @@
 
 
 ./chol.sh
+./gemm.sh
+./gemm_kernel.sh
 ./lu_nopiv.sh
 ./lu_incpiv.sh
 ./lu_piv.sh
@@ -42,6 +42,7 @@
 #include "uhm/operation/scheduler.hxx"
 #include "uhm/operation/mesh.hxx"
 #include "uhm/operation/element.hxx"
+#include "uhm/operation/graph.hxx"
 
 
 #include "uhm/mesh/node.hxx"
@@ -51,6 +51,7 @@
 #include <fstream>
 #include <vector>
 #include <list>
+#include <queue>
 #include <set>
 #include <map>
 #include <algorithm>
@@ -46,7 +46,16 @@
 
 // control variable
 #define UHM_DISSECTION_TASK_SIZE 2000
+#define UHM_VERTEX_WEIGHT_SCALE   100
+#define UHM_VERTEX_WEIGHT_MAX     536870912
+#define UHM_BISECTION_COARSEN_TO  100
+#define UHM_BISECTION_N_TRIALS      4
+#define UHM_BISECTION_N_PASSES      8
+#define UHM_BISECTION_UBFACTOR   1.03
 #define UHM_UNROLL_N                8
+#define UHM_BATCH_WIDTH             8
+#define UHM_HIER_MATRIX_THRESHOLD 512
+#define UHM_RECURSIVE_MATRIX_THRESHOLD 0
 
 // should be re-defined 
 #define UHM_INT            LINAL_INT
@@ -71,6 +80,7 @@ enum { UHM_PHYSICS_SINGLE=1,     UHM_PHYSICS_MULTI };
 enum { UHM_NODE_KIND_DEFAULT=0, UHM_NODE_KIND_BOUNDARY };
 enum { UHM_DISP_ALL=1, UHM_DISP_NODE, UHM_DISP_ELEMENT, UHM_DISP_MATRIX };
 enum { UHM_LHS=1, UHM_RHS };
+enum { UHM_MATRIX_FLAT=0, UHM_MATRIX_HIER, UHM_MATRIX_AUTO };
 enum { UHM_ATL=1, UHM_ATR, UHM_ABL, UHM_ABR, UHM_P, UHM_T,
        UHM_XT, UHM_XB, UHM_BT, UHM_BB, UHM_RT, UHM_RB, UHM_END };
 enum { UHM_CHOL=1,   UHM_LU_NOPIV,     UHM_LU_PIV,     UHM_LU_INCPIV,     
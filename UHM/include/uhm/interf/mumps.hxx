@@ -51,17 +51,21 @@ namespace uhm {
     std::vector<int> ia, ja;
     std::vector<double> a, b, x;
 
+    // cached sparse object keeps the pattern for numeric re-assembly
+    Sparse sp;
+
     void _init(int datatype) {
       assert(datatype == UHM_REAL ||
              datatype == UHM_COMPLEX);
       this->datatype = datatype;
       this->show_n_rhs = 0;
+      this->sp = NULL;
     }
 
   public:
     Mumps_() { _init(UHM_REAL); }
     Mumps_(int datatype) { _init(datatype); }
-    virtual ~Mumps_() { }
+    virtual ~Mumps_();
 
     bool   export_matrix(Mesh m);
 
@@ -80,7 +84,12 @@ namespace uhm {
     void   set_icntl  (int idx, int val);
     void   set_cntl   (int idx, double val);
 
+    // ** takes ownership of sp : the previous sparse object is deleted
+    //    and sp is deleted with the interface, so callers must not
+    //    delete it; get_sparse_matrix returns a borrowed pointer
     void   set_sparse_matrix(Sparse sp, int is_sym);
+    bool   update_sparse_matrix(Mesh m);
+    Sparse get_sparse_matrix();
 
     int    get_par();
     int    get_sym();
@@ -35,6 +35,7 @@
 
 namespace uhm {
   typedef class Element_* Element;
+  typedef class Mesh_*    Mesh;
 
   typedef class Sparse_*  Sparse;
   typedef class DSparse_* DSparse;
@@ -46,8 +47,47 @@ namespace uhm {
   private:
   protected:
     int fort, datatype, cs, n_dof, n_rhs, axpy;
+
+    // COO entries ( major, minor ), complex value takes two doubles
+    std::vector< int > a_major, a_minor, b_major, b_minor;
+    std::vector< double > a_val, b_val;
+    int n_a_sorted, n_b_sorted;
+    double t_assemble, m_assemble;
+
+    // pattern cache :: leaf ids and their ranges in the raw entries, 
+    // raw entry to assembled entry, assembled entry to the output slot 
+    // ( -1 dropped ); valid for one connectivity and numbering version
+    std::vector< int > elts, elt_a, elt_b, a_slot, b_slot, a_out;
+    int n_a_raw, n_b_raw, pattern_sym, pattern_version;
+    unsigned long long pattern_hash;
+
     void _init(int datatype, int fort, int cs,
                int n_dof, int n_rhs);
+
+    void _reset_coo();
+    void _assemble_coo();
+    void _disp_assemble(FILE *stream);
+
+    void _add_element(Element e, int n_a, int n_b);
+    void _set_pattern(int is_sym, std::vector<int> &out);
+
+    // values of the element in the order import_element pushes them
+    virtual void _export_values(Element e, 
+                                std::vector<double> &a,
+                                std::vector<double> &b)=0;
+
+    bool _triplet (int is_sym, 
+                   int &n_dof, int &n_rhs, int &n_nz,
+                   std::vector<int> &ia, 
+                   std::vector<int> &ja,
+                   std::vector<double> &a,
+                   std::vector<double> &b);
+    bool _compress(int is_sym, 
+                   int &n_dof, int &n_rhs, int &n_nz,
+                   std::vector<int> &ia, 
+                   std::vector<int> &ja,
+                   std::vector<double> &a,
+                   std::vector<double> &b);
       
   public:
     Sparse_() { }
@@ -60,6 +100,12 @@ namespace uhm {
 
     virtual void set_axpy(int axpy);
 
+    bool is_pattern(int is_sym, unsigned long long hash, int version);
+    void set_pattern_key(unsigned long long hash, int version);
+
+    // numeric re-assembly into the output of the last triplet/compress
+    bool update(Mesh m, std::vector<double> &a, std::vector<double> &b);
+
     virtual bool import_element(Element e)=0;
 
 
@@ -99,7 +145,9 @@ namespace uhm {
   class DSparse_ : public Sparse_ {
   private:
   protected:
-    std::map< std::pair<int,int>, double > a_ij_val, b_ij_val;
+    virtual void _export_values(Element e, 
+                                std::vector<double> &a,
+                                std::vector<double> &b);
   public:
     DSparse_() { }
     DSparse_(int fort, int cs, int n_rhs) { _init(UHM_REAL, fort, cs, 0, n_rhs); }
@@ -131,7 +179,9 @@ namespace uhm {
   class ZSparse_ : public Sparse_ {
   private:
   protected:
-    std::map< std::pair<int,int>, std::complex<double> > a_ij_val, b_ij_val;
+    virtual void _export_values(Element e, 
+                                std::vector<double> &a,
+                                std::vector<double> &b);
   public:
     ZSparse_() { }
     ZSparse_(int fort, int cs, int n_rhs) { _init(UHM_COMPLEX, fort, cs, 0, n_rhs); }
@@ -55,11 +55,15 @@ namespace uhm {
     std::vector<int> ia, ja, perm, invp;
     std::vector<double> a, b, r, x;
 
+    // cached sparse object keeps the pattern for numeric re-assembly
+    Sparse sp;
+
     void _init(int datatype) {
       assert(datatype == UHM_REAL ||
              datatype == UHM_COMPLEX);
       this->datatype = datatype;
       this->show_n_rhs = 0;
+      this->sp = NULL;
     }
     
   public:
@@ -67,7 +71,7 @@ namespace uhm {
     // methods
     WSMP_() { _init(UHM_REAL); }
     WSMP_(int datatype) { _init(datatype); }
-    virtual ~WSMP_() { }
+    virtual ~WSMP_();
 
     bool export_matrix(Mesh m);
 
@@ -79,7 +83,13 @@ namespace uhm {
     void set_show_n_rhs(int show_n_rhs);
     void set_iparm(int idx, int val);
     void set_dparm(int idx, double val);
+    // ** takes ownership of sp : the previous sparse object is deleted
+    //    and sp is deleted with the interface, so callers must not
+    //    delete it; get_sparse_matrix returns a borrowed pointer
     void set_sparse_matrix(Sparse sp);
+    bool update_sparse_matrix(Mesh m);
+
+    Sparse get_sparse_matrix();
 
     int    get_iparm(int idx);
     double get_dparm(int idx);
@@ -67,6 +67,16 @@ namespace uhm {
     int cookie;
   protected:
     int fs, ss, n_rhs, datatype, cm; 
+
+    // block size of this front from the profile, 0 is flat
+    int bs;
+    int _get_block_size();
+
+    // dispatch of this front to the flat or hier path
+    int use_hier;
+
+    // recursive factorization of ATL
+    int use_rec;
     
     Mat_FLA_<linal::Flat_> flat;
     linal::Flat_& _get_flat( int mat );
@@ -148,6 +158,7 @@ namespace uhm {
     virtual double get_lower_triangular_norm();
     virtual void   check_solution();
     virtual void   improve_solution();
+    virtual void   multiply( int n_rhs, void *x, void *y );
 
     // for checking lu_piv
     virtual void backup( int mat );
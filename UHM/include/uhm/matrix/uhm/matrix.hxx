@@ -40,6 +40,39 @@ namespace uhm {
   extern void   set_hier_block_size(int size);
   extern int    get_hier_block_size();
 
+  // ** flat, hier or auto; auto sends a front to the hier path when
+  //    fs+ss reaches the threshold and its profile block is not flat
+  extern void   set_hier_matrix_mode(int mode);
+  extern int    get_hier_matrix_mode();
+  extern void   set_hier_matrix_threshold(int size);
+  extern int    get_hier_matrix_threshold();
+  extern bool   is_hier_matrix(int fs, int ss);
+
+  // ** recursive factorization of the pivot block when fs reaches
+  //    the threshold, 0 is off
+  extern void   set_recursive_matrix_threshold(int size);
+  extern int    get_recursive_matrix_threshold();
+  extern bool   is_recursive_matrix(int fs, int ss);
+
+  // ** block size of a front from the tuned profile of ( fs, ss ) 
+  //    shapes, the nearest shape is taken, 0 is flat
+  extern int    get_hier_block_size(int fs, int ss);
+  extern void   set_hier_block_profile(std::vector< std::pair< std::pair<int,int>, int > > &profile);
+  extern void   get_hier_block_profile(std::vector< std::pair< std::pair<int,int>, int > > &profile);
+  extern void   clear_hier_block_profile();
+  extern bool   import_hier_block_profile(char *full_path);
+  extern bool   export_hier_block_profile(char *full_path);
+
+  // ** time the front factorization of method on each ( fs, ss ) shape
+  //    for each block size (0 is flat) and keep the fastest; fronts do
+  //    not know their method when they are created, so the profile is
+  //    applied to every front and should be tuned with the method the
+  //    mesh is factored with
+  extern void   tune_hier_block_size(int method, int datatype, 
+                                     std::vector< std::pair<int,int> > &front,
+                                     std::vector<int> &block,
+                                     int n_itr);
+
   extern double matrix_buffer_used();
   extern double matrix_max_buffer_used();
   extern double matrix_flop();
@@ -114,6 +147,9 @@ namespace uhm {
     virtual void   check_solution()=0;
     virtual void   improve_solution()=0;
 
+    // y += A x, local ( fs+ss ) x n_rhs column major buffers
+    virtual void   multiply( int n_rhs, void *x, void *y )=0;
+
     // for checkin routine internally need
     virtual void backup( int mat )=0;
     virtual void restore( int mat, int is_merge )=0;
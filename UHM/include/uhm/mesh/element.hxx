@@ -66,6 +66,9 @@ namespace uhm {
     bool   reuse;         // reuse flag
     int    marker[2];     // build_tree_var_2 need marker
 
+    bool   is_centroid;   // centroid is given, otherwise node average
+    double centroid[3];   // build_tree_var_7 need position
+
     void _init(int id, int gen);
     
   public:
@@ -95,6 +98,7 @@ namespace uhm {
     void set_reuse(int flag);
     void set_marker(int index, int marker);
     void set_parent(Element p);
+    void set_centroid(double x, double y, double z);
 
     int  get_generation();
     int  get_height();
@@ -103,6 +107,7 @@ namespace uhm {
     Element get_child(int loc);
     Matrix  get_matrix();
     int     get_marker(int index);
+    void    get_centroid(double *xyz);
 
     int  get_n_children();
     int  get_n_nodes();
@@ -158,6 +163,7 @@ namespace uhm {
 			     std::vector< int > *adjwgt);
 
     friend bool build_tree_var_1(Mesh m);
+    friend bool update_tree(Mesh m, Element e);
 
     friend bool element_valid(Element e);
   };
@@ -176,6 +182,11 @@ namespace uhm {
     for (int i=0;i<2;++i) {
       this->marker[i] = 0;
     }
+
+    this->is_centroid = false;
+    for (int i=0;i<3;++i) {
+      this->centroid[i] = 0.0;
+    }
   }
   inline bool Element_::operator<(const Element_ &b) const { 
     return (this->id < b.id); 
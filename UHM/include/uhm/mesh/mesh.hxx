@@ -53,6 +53,9 @@ namespace uhm {
   // internal inline functions
   bool   mesh_valid( Mesh m );
 
+  // file starts with the binary mesh format tag
+  bool   is_binary_mesh( char *full_path );
+
   // ----------------------------------------------------------------
   // ** Mesh class
   class Mesh_ : public Object_<int> {
@@ -65,8 +68,42 @@ namespace uhm {
 
     Scheduler_ scheduler;
 
+    // leaves grouped by colors, a color does not share any node
+    std::vector< std::vector< Element > > colors;
+
+    // statistics of the last krylov solve
+    int    krylov_iter;
+    double krylov_residual, t_krylov, t_precond, t_multiply;
+
+    // minimum number of same shape leaves factored as a batch, 0 is off
+    int    leaf_batch;
+
+    // elements refined or unrefined since the last lock, nodes numbered
+    // by the last lock that are gone ( offset, n_dof ), and the end of
+    // the numbering; relock uses these to renumber locally
+    std::set< int > updated;
+    std::vector< std::pair<int,int> > vanished;
+    int    offset_end;
+
+    // leaf matrices hold factors after a decomposition until all of
+    // them are created again
+    int    decomposed;
+
+    // changes on every unlock, dofs are numbered again by the next lock
+    int    numbering;
+
     void _init( int id, int id_element );
     void _random_matrix( int is_spd );
+    void _color_leaves();
+    void _solve_block( int method, 
+                       std::vector<double> &b, 
+                       std::vector<double> &x );
+    void _precondition( int method, int n_rhs,
+                        std::vector<double> &r, 
+                        std::vector<double> &z );
+    void _decompose_leaves( int type, std::vector< Element > &batched );
+    void _release_leaves( std::vector< Element > &batched );
+    void _relock( Element e );
 
   public:
     Mesh_();
@@ -80,11 +117,23 @@ namespace uhm {
     virtual bool disp( FILE *stream, int mode );
 
     bool import_file(char *full_path);
+    bool import_binary(char *full_path);
+    bool export_binary(char *full_path);
     bool export_graphviz_hier(char *full_path, int is_leaf2root);
     bool export_sparse_pattern(char *full_path, char *ss, int is_fill_in);
     bool export_connectivity(char *full_path, int n_rhs);
     bool export_matrix(char *full_path, int n_rhs);
 
+    // leaf matrices, rhs and solutions before decomposition; import
+    // feeds copy_in
+    bool export_matrix_binary(char *full_path);
+    bool import_matrix_binary(char *full_path);
+
+    // snapshot of the locked tree, import returns false on mismatch
+    unsigned long long get_connectivity_hash();
+    bool export_tree(char *full_path);
+    bool import_tree(char *full_path);
+
     bool export_matrix(Sparse sp, int n_rhs);
     bool export_matrix(Sparse sp, int generation, int n_rhs);
     bool import_matrix(Sparse sp, int assemble,
@@ -149,8 +198,11 @@ namespace uhm {
 
     // solving sequence
     void lock();
+    void relock();
     void unlock();
     int  is_locked();
+    int  is_decomposed();
+    int  get_numbering_version();
 
     void create_matrix_without_buffer( int datatype, int n_rhs );
 
@@ -198,6 +250,38 @@ namespace uhm {
 
     void         set_rhs();
     double       get_residual();
+
+    // y = A x with unassembled leaf matrices, ( n_dof x n_rhs ) vectors
+    bool         multiply( int n_rhs, 
+                           std::vector<double> &x, 
+                           std::vector<double> &y );
+
+    // solve with the factorization for rhs of any width, streamed in
+    // blocks of n_rhs given to the matrix creation
+    bool         solve( int method, int n_rhs,
+                        std::vector<double> &b, std::vector<double> &x );
+
+    // sweeps pruned to the root paths of rhs leaves and output elements
+    bool         solve_selective( int method,
+                                  std::vector< Element > &rhs,
+                                  std::vector< Element > &out );
+
+    // krylov solvers preconditioned by the factorization of this mesh,
+    // A x is given by the leaf matrices of op numbered as this mesh
+    int          pcg  ( Mesh op, int method, int n_rhs,
+                        std::vector<double> &b, std::vector<double> &x,
+                        double tol, int max_iter );
+    int          gmres( Mesh op, int method, int n_rhs,
+                        std::vector<double> &b, std::vector<double> &x,
+                        double tol, int max_iter, int restart );
+    void         get_krylov_stat( int &n_iter, double &residual,
+                                  double &t_total, double &t_precond,
+                                  double &t_multiply );
+    // leaves of the same shape are factored in interleaved batches 
+    // before the tree pass when a group has at least min_group leaves
+    void         set_leaf_batch( int min_group );
+    int          get_leaf_batch();
+
     double       get_lower_triangular_norm();
     unsigned int get_n_dof();
     unsigned int get_n_nonzero_factor();
@@ -296,7 +380,11 @@ namespace uhm {
     friend bool build_tree_var_2( Mesh m, int nparts );
     friend bool build_tree_var_3( Mesh m );
     friend bool build_tree_var_4( Mesh m );
-    friend bool build_tree_var_5( Mesh m );
+    friend bool build_tree_var_4_weighted( Mesh m, int is_weighted,
+					   int decomposition, int datatype, 
+					   int n_rhs );
+    friend bool build_tree_var_6( Mesh m );
+    friend bool build_tree_var_7( Mesh m );
     friend class Scheduler_;
   };
   // ----------------------------------------------------------------
@@ -305,6 +393,17 @@ namespace uhm {
     this->cookie     = UHM_MESH_COOKIE;
     this->id         = id;
     this->id_element = id_element;
+
+    this->krylov_iter     = 0;
+    this->krylov_residual = 0.0;
+    this->t_krylov        = 0.0;
+    this->t_precond       = 0.0;
+    this->t_multiply      = 0.0;
+
+    this->leaf_batch      = 0;
+    this->offset_end      = 0;
+    this->decomposed      = false;
+    this->numbering       = 0;
   }
   inline bool Mesh_::operator<(const Mesh_ &b) const { 
     return (this->id < b.id); 
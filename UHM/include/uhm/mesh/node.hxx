@@ -54,6 +54,12 @@ namespace uhm {
     int n_dof, p, kind, offset;
     int marker;
 
+    // numbered - offset is assigned by the last lock ( see relock )
+    int numbered;
+
+    // coord  - optional position used by geometric tree construction
+    double coord[3];
+
     void _init(std::pair<int,int> id, int n_dof, int p,int kind);
 
   public:
@@ -73,6 +79,8 @@ namespace uhm {
     void set_p      (int p);
     void set_offset (int offset);
     void set_marker (int marker);
+    void set_numbered(int flag);
+    void set_coord  (double x, double y, double z);
     
     int  get_kind();
     int  get_n_dof();
@@ -80,6 +88,8 @@ namespace uhm {
     int  get_n_owner();
     int  get_offset();
     int  get_marker();
+    int  is_numbered();
+    void get_coord  (double *xyz);
 
     bool is_owned_by  (Element e);
     bool is_same_as   (Node n);
@@ -110,6 +120,10 @@ namespace uhm {
     this->kind = kind;
     this->offset = 0;
     this->marker = -1;
+    this->numbered = false;
+
+    for (int i=0;i<3;++i) 
+      this->coord[i] = 0.0;
   }
   inline bool Node_::operator<(const Node_ &b) const { 
     return (this->id < b.id); 
@@ -0,0 +1,82 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef UHM_OPERATION_GRAPH_HXX
+#define UHM_OPERATION_GRAPH_HXX
+
+namespace uhm {
+  typedef class Graph_* Graph;
+
+  // ----------------------------------------------------------------
+  // ** Graph in CSR format with vertex and edge weights
+  // label maps vertices back to the original graph after splitting
+  class Graph_ {
+  public:
+    std::vector< int > xadj, adjncy, adjwgt, vwgt, label;
+
+    Graph_() { }
+    virtual ~Graph_() { }
+
+    void reset();
+
+    int  get_n_vertices();
+    int  get_total_weight();
+    int  get_max_weight();
+  };
+
+  // multilevel bisection :: heavy edge matching, greedy growing and 
+  // FM refinement; where[v] is 0 or 1 and the edge cut is returned
+  extern int  graph_bisection(Graph g, std::vector< int > &where);
+  extern bool graph_split(Graph g, std::vector< int > &where, 
+			  Graph g0, Graph g1);
+
+  // recursive bisection of orphans ( labeled by graph ) under parent;
+  // parts larger than 3 become new elements
+  extern bool graph_dissection(std::vector< Element > *orphan,
+			       Mesh m, Element parent, int is_parallel,
+			       Graph graph);
+
+  // ----------------------------------------------------------------
+  // ** Definition
+  inline void Graph_::reset() {
+    std::vector< int >().swap(this->xadj);
+    std::vector< int >().swap(this->adjncy);
+    std::vector< int >().swap(this->adjwgt);
+    std::vector< int >().swap(this->vwgt);
+    std::vector< int >().swap(this->label);
+  }
+  inline int Graph_::get_n_vertices() { 
+    return (this->xadj.size() ? (this->xadj.size() - 1) : 0); 
+  }
+}
+
+#endif
@@ -37,12 +37,19 @@ namespace uhm {
   // Var 1 :: Heavy edge matching
   // Var 2 :: Metis graph partitioning
   // Var 3 :: Metis nested dissection
+  // Var 4 :: Metis bisection with parallel recursion
+  // Var 5 :: Var 4 with vertices weighted by elimination cost
+  // Var 6 :: Var 4 with built-in multilevel bisection ( no METIS )
+  // Var 7 :: Recursive coordinate bisection ( needs coordinates )
   extern bool orphan_graph(std::vector< Element > *orphan,
 			   Element parent,
 			   //                         
 			   std::vector< int > *xadj,
 			   std::vector< int > *adjncy,
 			   std::vector< int > *adjwgt);
+  extern bool orphan_weight(std::vector< Element > *orphan,
+			    int decomposition, int datatype, int n_rhs,
+			    std::vector< int > *vwgt);
 
   // ** front end
   extern bool build_tree(Mesh m);
@@ -57,7 +64,15 @@ namespace uhm {
 
   extern bool build_tree_var_4(Mesh m);
 
-  extern bool build_tree_var_5(Mesh m);
+  extern bool build_tree_var_5(Mesh m, 
+			       int decomposition, int datatype, int n_rhs);
+
+  extern bool build_tree_var_6(Mesh m);
+
+  extern bool build_tree_var_7(Mesh m);
+
+  // ** local rebuild below a refined element
+  extern bool update_tree(Mesh m, Element e);
 }
 
 
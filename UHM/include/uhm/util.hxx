@@ -75,6 +75,8 @@ namespace uhm {
   extern bool delete_file(char *fullpath);
   extern bool write_buffer_to_file(FILE *fp, long buf_size, char *buf);
   extern bool read_buffer_from_file(FILE *fp, long buf_size, char *buf);
+  extern bool map_file(char *fullpath, size_t *size, char **buf);
+  extern bool unmap_file(size_t size, char *buf);
 
 
 
@@ -56,6 +56,11 @@ extern "C" {
 
   void UHM_C2F(uhm_set_hier_block_size)         ( uhm_fort_int *size );
   void UHM_C2F(uhm_get_hier_block_size)         ( uhm_fort_int *size );
+  void UHM_C2F(uhm_import_hier_block_profile)   ( uhm_fort_char *filename,
+                                                  uhm_fort_int  *is_loaded );
+  void UHM_C2F(uhm_set_hier_matrix_mode)        ( uhm_fort_int *mode );
+  void UHM_C2F(uhm_set_hier_matrix_threshold)   ( uhm_fort_int *size );
+  void UHM_C2F(uhm_set_recursive_matrix_threshold)( uhm_fort_int *size );
 
   void UHM_C2F(set_svd_relative_threshold)      ( uhm_fort_double *val);
   void UHM_C2F(set_svd_absolute_threshold)      ( uhm_fort_double *val);
@@ -92,6 +97,12 @@ extern "C" {
   void UHM_C2F(uhm_element_add_node)            ( uhm_fort_p   *elt,
                                                   uhm_fort_p   *nod );
 
+  void UHM_C2F(uhm_node_set_coord)              ( uhm_fort_p   *nod,
+                                                  uhm_fort_double *xyz );
+
+  void UHM_C2F(uhm_element_set_centroid)        ( uhm_fort_p   *elt,
+                                                  uhm_fort_double *xyz );
+
   void UHM_C2F(uhm_copy_in)                     ( uhm_fort_p   *mesh,
                                                   uhm_fort_p   *elt,
                                                   uhm_fort_int *datatype,
@@ -132,8 +143,18 @@ extern "C" {
 
   void UHM_C2F(uhm_mesh_import)                 ( uhm_fort_p    *mesh,
                                                   uhm_fort_char *filename);
+  void UHM_C2F(uhm_mesh_export_tree)            ( uhm_fort_p    *mesh,
+                                                  uhm_fort_char *filename);
+  void UHM_C2F(uhm_mesh_import_tree)            ( uhm_fort_p    *mesh,
+                                                  uhm_fort_char *filename,
+                                                  uhm_fort_int  *is_loaded);
 
   void UHM_C2F(uhm_build_tree)                  ( uhm_fort_p   *mesh );
+  void UHM_C2F(uhm_build_tree_geometry)         ( uhm_fort_p   *mesh );
+  void UHM_C2F(uhm_build_tree_weighted)         ( uhm_fort_p   *mesh,
+                                                  uhm_fort_int *decomposition,
+                                                  uhm_fort_int *datatype,
+                                                  uhm_fort_int *n_rhs );
 
   void UHM_C2F(uhm_create_matrix_without_buffer)( uhm_fort_p   *mesh,
                                                   uhm_fort_int *datatype,
@@ -187,6 +208,40 @@ extern "C" {
 
   void UHM_C2F(uhm_get_residual)                ( uhm_fort_p   *mesh,
                                                   uhm_fort_double *res );
+  void UHM_C2F(uhm_mesh_multiply)               ( uhm_fort_p   *mesh,
+                                                  uhm_fort_int *datatype,
+                                                  uhm_fort_int *n_rhs,
+                                                  uhm_fort_double *x,
+                                                  uhm_fort_double *y );
+
+  // ** krylov solvers, real datatype; x is the initial guess
+  //----------------------------------------------------------------------
+
+  void UHM_C2F(uhm_mesh_pcg)                    ( uhm_fort_p   *mesh,
+                                                  uhm_fort_p   *op,
+                                                  uhm_fort_int *method,
+                                                  uhm_fort_int *n_rhs,
+                                                  uhm_fort_double *b,
+                                                  uhm_fort_double *x,
+                                                  uhm_fort_double *tol,
+                                                  uhm_fort_int *max_iter,
+                                                  uhm_fort_int *n_iter );
+  void UHM_C2F(uhm_mesh_gmres)                  ( uhm_fort_p   *mesh,
+                                                  uhm_fort_p   *op,
+                                                  uhm_fort_int *method,
+                                                  uhm_fort_int *n_rhs,
+                                                  uhm_fort_double *b,
+                                                  uhm_fort_double *x,
+                                                  uhm_fort_double *tol,
+                                                  uhm_fort_int *max_iter,
+                                                  uhm_fort_int *restart,
+                                                  uhm_fort_int *n_iter );
+  void UHM_C2F(uhm_get_krylov_stat)             ( uhm_fort_p   *mesh,
+                                                  uhm_fort_int *n_iter,
+                                                  uhm_fort_double *residual,
+                                                  uhm_fort_double *t_total,
+                                                  uhm_fort_double *t_precond,
+                                                  uhm_fort_double *t_multiply );
 }
 
 
@@ -60,17 +60,27 @@ namespace uhm {
     int fort=1, cs=0;
 
     // sparse object
-    Sparse sp;
-
-    // easy setting
-    if (mumps->is_complex()) 
-      sp = new ZSparse_(fort, cs, n_rhs);
-    else 
-      sp = new DSparse_(fort, cs, n_rhs);
-    
-    this->export_matrix(sp, n_rhs);
-    
-    mumps->set_sparse_matrix(sp, is_sym);
+    Sparse sp = mumps->get_sparse_matrix();
+    unsigned long long hash = this->get_connectivity_hash();
+    int version = this->get_numbering_version();
+
+    // same mesh and format : numeric values only
+    if (sp != NULL && 
+        sp->is_pattern(is_sym, hash, version) && 
+        n_rhs == mumps->get_n_rhs()) {
+      mumps->update_sparse_matrix(this);
+    } else {
+      // easy setting
+      if (mumps->is_complex()) 
+        sp = new ZSparse_(fort, cs, n_rhs);
+      else 
+        sp = new DSparse_(fort, cs, n_rhs);
+      
+      this->export_matrix(sp, n_rhs);
+      sp->set_pattern_key(hash, version);
+      
+      mumps->set_sparse_matrix(sp, is_sym);
+    }
 
     printf("- MUMPS INTERFACED -\n");
     printf("n_dof       : %d\n", (int)mumps->get_n_dof());
@@ -164,7 +174,19 @@ namespace uhm {
 #endif
   }
 
+  Mumps_::~Mumps_() {
+    if (this->sp != NULL) delete this->sp;
+  }
+
+  Sparse Mumps_::get_sparse_matrix() { return this->sp; }
+
   void Mumps_::set_sparse_matrix(Sparse sp, int is_sym)   {
+    // the interface owns the sparse object to re-assemble numerics
+    if (this->sp != sp) {
+      if (this->sp != NULL) delete this->sp;
+      this->sp = sp;
+    }
+
     sp->triplet( is_sym,
                  this->n_dof, this->n_rhs, this->n_nz,
                  this->ia, this->ja,
@@ -211,6 +233,17 @@ namespace uhm {
              i, this->b.at(i) );
   }
 
+  bool Mumps_::update_sparse_matrix(Mesh m) {
+    if (this->sp == NULL ||
+        !this->sp->update(m, this->a, this->b)) 
+      return false;
+
+    // rhs is overwritten by the solution; buffers given to mumps stay
+    std::copy(this->b.begin(), this->b.end(), this->x.begin());
+
+    return true;
+  }
+
   int Mumps_::get_par() {
     int r_val = 0;
 #ifdef UHM_INTERF_MUMPS_ENABLE
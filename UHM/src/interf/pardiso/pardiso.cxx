@@ -68,11 +68,19 @@ namespace uhm {
     int mtype, solver, maxfct, mnum, msglvl;
 
     // sparse object
-    Sparse sp;
+    Sparse sp = pardiso->get_sparse_matrix();
+    unsigned long long hash = this->get_connectivity_hash();
+    int version = this->get_numbering_version();
+
+    // same mesh and format : numeric values only
+    bool is_update = (sp != NULL && 
+                      sp->is_pattern(is_sym, hash, version) &&
+                      n_rhs == pardiso->get_n_rhs());
 
     // easy setting
     if (pardiso->is_complex()) {
-      sp = new ZSparse_(fort, cs, n_rhs);
+      if (!is_update)
+        sp = new ZSparse_(fort, cs, n_rhs);
 
       // here I do not assume Hermitian PD
       if (is_sym)
@@ -86,7 +94,8 @@ namespace uhm {
       msglvl =  1; // show statistics
 
     } else {
-      sp = new DSparse_(fort, cs, n_rhs);
+      if (!is_update)
+        sp = new DSparse_(fort, cs, n_rhs);
 
       // here I do not assume SPD case
       if (is_sym)
@@ -101,13 +110,18 @@ namespace uhm {
 
     }
 
-    this->export_matrix(sp, n_rhs);
-
     // default setting
     pardiso->set_env( mtype, solver, maxfct, mnum, msglvl);
     pardiso->set_iparm( 1, 0);
     
-    pardiso->set_sparse_matrix(sp, is_sym);
+    if (is_update) {
+      pardiso->update_sparse_matrix(this);
+    } else {
+      this->export_matrix(sp, n_rhs);
+      sp->set_pattern_key(hash, version);
+
+      pardiso->set_sparse_matrix(sp, is_sym);
+    }
 
     printf("- PARDISO INTERFACED -\n");
     printf("mtype       : % d\n", mtype);
@@ -161,7 +175,19 @@ namespace uhm {
   void Pardiso_::set_phase(int phase)           { this->phase = phase; }
   void Pardiso_::set_iparm(int idx, int val)    { this->iparm[idx-1] = val; }
   void Pardiso_::set_dparm(int idx, double val) { this->dparm[idx-1] = val; }
+  Pardiso_::~Pardiso_() {
+    if (this->sp != NULL) delete this->sp;
+  }
+
+  Sparse Pardiso_::get_sparse_matrix() { return this->sp; }
+
   void Pardiso_::set_sparse_matrix(Sparse sp, int is_sym)   {
+    // the interface owns the sparse object to re-assemble numerics
+    if (this->sp != sp) {
+      if (this->sp != NULL) delete this->sp;
+      this->sp = sp;
+    }
+
     sp->compress( is_sym,
                   this->n_dof, this->n_rhs, this->n_nz,
 		  this->ia, this->ja,
@@ -184,6 +210,16 @@ namespace uhm {
 	     i, this->b.at(i) );
   }
 
+  bool Pardiso_::update_sparse_matrix(Mesh m) {
+    if (this->sp == NULL ||
+        !this->sp->update(m, this->a, this->b)) 
+      return false;
+
+    std::fill(this->x.begin(), this->x.end(), 0.0);
+
+    return true;
+  }
+
   int    Pardiso_::get_iparm(int idx)  { return this->iparm[idx-1]; }
   double Pardiso_::get_dparm(int idx)  { return this->dparm[idx-1]; }
 
@@ -34,11 +34,16 @@
 #include "uhm/const.hxx"
 
 #include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+
 #include "uhm/mesh/node.hxx"
 #include "uhm/mesh/element.hxx"
 
 #include "uhm/matrix/uhm/matrix.hxx"
 
+#include "uhm/mesh/mesh.hxx"
+
 #include "uhm/util.hxx"
 
 #include "uhm/interf/sparse.hxx"
@@ -59,6 +64,7 @@ namespace uhm {
     this->n_dof     = n_dof;
     this->n_rhs     = n_rhs;
     this->axpy      = 1;
+    this->_reset_coo();
   }
 
   bool Sparse_::is_complex()        { return (this->datatype == UHM_COMPLEX); }
@@ -184,89 +190,269 @@ namespace uhm {
   }
 
   // ----------------------------------------------------------------
-  // ** Sparse double format
-  void DSparse_::reset(int n_rhs) {
-    this->n_rhs = n_rhs;
-    this->n_dof = 0;
-    this->a_ij_val.clear();
-    this->b_ij_val.clear();
-    this->axpy = 1;
-  }
-
-  bool DSparse_::import_element(Element e) {
+  // ** COO assembly
+  // Entries are appended as ( major, minor, value ). Assembly sorts the
+  // 64 bit key ( major, minor ) with a stable parallel radix sort and
+  // reduces duplicated keys; with axpy off the first inserted value is
+  // kept as the map insertion did before. The assembled entry of each
+  // input is returned in slot ( -1 for a dropped duplicate ).
+  static void coo_radix_sort(std::vector< unsigned long long > &key,
+                             std::vector< int > &perm) {
+    int n = key.size();
+    unsigned long long diff = 0;
+    for (int i=1;i<n;++i) 
+      diff |= (key[i] ^ key[0]);
+
+    std::vector< unsigned long long > key_tmp(n);
+    std::vector< int > perm_tmp(n);
+
+    int nt = max(get_num_threads(), 1);
+    std::vector< int > cnt(nt*256);
+
+    for (int shift=0;shift<64;shift+=8) {
+      // skip the digit if all keys are same on it
+      if (!((diff >> shift) & 0xff)) continue;
+      
+      std::fill(cnt.begin(), cnt.end(), 0);
 
-    // workspace for the interface to UHM
-    std::vector< std::pair<int,int> > ij_a, ij_b;
-    std::vector< double > a, b;
+#pragma omp parallel for schedule(static, 1)
+      for (int t=0;t<nt;++t) {
+        int *c = &cnt[t*256];
+        for (int i=(long)n*t/nt;i<(long)n*(t+1)/nt;++i) 
+          ++c[ (key[i] >> shift) & 0xff ];
+      }
 
-    // leaf element only and real datatype
-    if (e->is_leaf() &&
-        !e->get_matrix()->is_complex_datatype()) {
-      int m, n;
-      for (int i=UHM_ATL;i<UHM_P;++i) {
-        if (e->get_matrix()->is_buffer(i)) {
-          e->export_matrix(this->n_rhs, m, n, ij_a, i);
-          e->get_matrix()->export_matrix(m, n, a, i);
+      // offsets ordered by digit, then thread for stability
+      int offs = 0;
+      for (int d=0;d<256;++d) 
+        for (int t=0;t<nt;++t) {
+          int tmp = cnt[t*256+d];
+          cnt[t*256+d] = offs;
+          offs += tmp;
         }
-      }
-      for (int i=UHM_XT;i<UHM_BT;++i) {
-        if (e->get_matrix()->is_buffer(i)) {
-          e->export_matrix(this->n_rhs, m, n, ij_b, i);
-          e->get_matrix()->export_matrix(m, n, b, i);
+      
+#pragma omp parallel for schedule(static, 1)
+      for (int t=0;t<nt;++t) {
+        int *c = &cnt[t*256];
+        for (int i=(long)n*t/nt;i<(long)n*(t+1)/nt;++i) {
+          int loc = c[ (key[i] >> shift) & 0xff ]++;
+          key_tmp[loc]  = key[i];
+          perm_tmp[loc] = perm[i];
         }
       }
+      key.swap(key_tmp);
+      perm.swap(perm_tmp);
     }
+  }
 
-    // fortran indexing 
-    int shift = this->is_fort_numbering();
+  static void coo_assemble(int is_axpy, int n_val,
+                           std::vector< int > &major,
+                           std::vector< int > &minor,
+                           std::vector< double > &val,
+                           std::vector< int > &slot,
+                           double &t_assemble, double &m_assemble) {
+    double t_base = timer();
+    int n = major.size();
+
+    double m_in = (double)( major.capacity()*sizeof(int)*2 +
+                            val.capacity()*sizeof(double) );
+
+    std::vector< unsigned long long > key(n);
+    std::vector< int > perm(n);
+
+#pragma omp parallel for 
+    for (int i=0;i<n;++i) {
+      key[i]  = ((unsigned long long)major[i] << 32) | (unsigned int)minor[i];
+      perm[i] = i;
+    }
     
-    // LHS assemble
-    for (int i=0;i<ij_a.size();++i) {
-
-      // change the index if it use fortran indexing
-      std::pair< int, int > idx;
-      if (!this->is_column_major()) {
-        idx.first  = ij_a.at(i).first  + shift;
-        idx.second = ij_a.at(i).second + shift;
+    coo_radix_sort(key, perm);
+
+    // gather values in the sorted order
+    std::vector< double > sorted(n*n_val);
+#pragma omp parallel for 
+    for (int i=0;i<n;++i) 
+      for (int k=0;k<n_val;++k)
+        sorted[i*n_val+k] = val[perm[i]*n_val+k];
+
+    // key, perm and their radix workspace, sorted values and input
+    m_assemble = max(m_assemble, 
+                     m_in + (double)( n*(sizeof(unsigned long long)+sizeof(int))*2 + 
+                                      sorted.size()*sizeof(double) ));
+
+    // segmented reduction of duplicated keys
+    int nnz = 0;
+    slot.assign(n, -1);
+    for (int i=0;i<n;++i) {
+      if (i && key[i] == key[i-1]) {
+        if (is_axpy) {
+          for (int k=0;k<n_val;++k)
+            val[(nnz-1)*n_val+k] += sorted[i*n_val+k];
+          slot[perm[i]] = nnz-1;
+        }
       } else {
-        idx.first  = ij_a.at(i).second + shift;
-        idx.second = ij_a.at(i).first  + shift;
+        slot[perm[i]] = nnz;
+        major[nnz] = (int)(key[i] >> 32);
+        minor[nnz] = (int)(key[i] & 0xffffffff);
+        for (int k=0;k<n_val;++k)
+          val[nnz*n_val+k] = sorted[i*n_val+k];
+        ++nnz;
       }
-      
-      // insert the entree 
-      std::pair< std::map< std::pair<int,int>, double >::iterator, bool > ret;
-      ret = this->a_ij_val.insert( std::pair< std::pair<int,int> , double >
-                                   (idx, a.at(i)) );
-      
-      // if exist, add it
-      if (ret.second == false && this->is_axpy()) 
-        ret.first->second += a.at(i);
+    }
+    major.resize(nnz);
+    minor.resize(nnz);
+    val.resize(nnz*n_val);
+
+    t_assemble += (timer() - t_base);
+  }
+
+  void Sparse_::_reset_coo() {
+    this->a_major.clear(); this->a_minor.clear(); this->a_val.clear(); 
+    this->b_major.clear(); this->b_minor.clear(); this->b_val.clear(); 
+    this->n_a_sorted = 0;
+    this->n_b_sorted = 0;
+    this->t_assemble = 0.0;
+    this->m_assemble = 0.0;
+
+    this->elts.clear();
+    this->elt_a.clear();  this->elt_b.clear();
+    this->a_slot.clear(); this->b_slot.clear(); this->a_out.clear();
+    this->n_a_raw      = 0;
+    this->n_b_raw      = 0;
+    this->pattern_sym     = -1;
+    this->pattern_hash    = 0;
+    this->pattern_version = 0;
+  }
+
+  // previously assembled entries come first in the input, so their
+  // raw entries follow the slot of the assembled entry they went in
+  static void coo_compose(int n_prev, 
+                          std::vector< int > &slot,
+                          std::vector< int > &raw) {
+    for (int i=0;i<raw.size();++i) 
+      if (raw[i] >= 0) 
+        raw[i] = slot[raw[i]];
+    for (int i=n_prev;i<slot.size();++i) 
+      raw.push_back(slot[i]);
+  }
+
+  void Sparse_::_assemble_coo() {
+    int n_val = (this->is_complex() ? 2 : 1);
 
+    std::vector< int > slot;
+    if (this->n_a_sorted != this->a_major.size()) {
+      coo_assemble(this->is_axpy(), n_val, 
+                   this->a_major, this->a_minor, this->a_val, slot,
+                   this->t_assemble, this->m_assemble);
+      coo_compose(this->n_a_sorted, slot, this->a_slot);
+      this->n_a_sorted = this->a_major.size();
+    }
+    if (this->n_b_sorted != this->b_major.size()) {
+      coo_assemble(this->is_axpy(), n_val, 
+                   this->b_major, this->b_minor, this->b_val, slot,
+                   this->t_assemble, this->m_assemble);
+      coo_compose(this->n_b_sorted, slot, this->b_slot);
+      this->n_b_sorted = this->b_major.size();
     }
+  }
 
-    // RHS assemble - column numbering only
-    for (int i=0;i<ij_b.size();++i) {
+  void Sparse_::_add_element(Element e, int n_a, int n_b) {
+    if (!n_a && !n_b) return;
 
-      // change the index if it use fortran indexing
-      std::pair< int, int > idx;
-      idx.first  = ij_b.at(i).second + shift;
-      idx.second = ij_b.at(i).first  + shift;
-      
-      // insert the entree 
-      std::pair< std::map< std::pair<int,int>, double >::iterator, bool > ret;
-      ret = this->b_ij_val.insert( std::pair< std::pair<int,int> , double >
-                                   (idx, b.at(i)) );
+    this->elts.push_back(e->get_id());
+    this->elt_a.push_back(this->n_a_raw);
+    this->elt_b.push_back(this->n_b_raw);
+    this->n_a_raw += n_a;
+    this->n_b_raw += n_b;
+
+    // new entries invalidate the pattern
+    this->pattern_sym = -1;
+  }
+
+  void Sparse_::_set_pattern(int is_sym, std::vector<int> &out) {
+    this->a_out.swap(out);
+    this->pattern_sym = (is_sym != 0);
+  }
+
+  bool Sparse_::is_pattern(int is_sym, unsigned long long hash, 
+                           int version) {
+    return (this->pattern_sym >= 0 && 
+            this->pattern_sym == (is_sym != 0) &&
+            this->pattern_hash == hash &&
+            this->pattern_version == version);
+  }
+
+  void Sparse_::set_pattern_key(unsigned long long hash, int version) {
+    this->pattern_hash    = hash;
+    this->pattern_version = version;
+  }
+
+  // ----------------------------------------------------------------
+  // ** Numeric re-assembly
+  // Element buffers are scattered straight into the slots recorded by
+  // the last triplet/compress; a and b keep their size and index arrays
+  // are not touched. Leaves are found by id in the mesh. Returns false 
+  // if there is no pattern or the mesh is numbered again.
+  bool Sparse_::update(Mesh m, 
+                       std::vector<double> &a, std::vector<double> &b) {
+    if (this->pattern_sym < 0 ||
+        this->pattern_version != m->get_numbering_version()) 
+      return false;
+
+    double t_base = timer();
+    int n_val = (this->is_complex() ? 2 : 1);
+
+    assert(this->a_slot.size() == this->n_a_raw &&
+           this->b_slot.size() == this->n_b_raw);
+    assert(b.size() == this->b_val.size());
+
+    std::fill(a.begin(), a.end(), 0.0);
+    std::fill(b.begin(), b.end(), 0.0);
+
+    int n_elts = this->elts.size();
+
+#pragma omp parallel for schedule(dynamic)
+    for (int k=0;k<n_elts;++k) {
+      std::vector< double > val_a, val_b;
+      Element e = m->find_element(this->elts[k]);
+      assert(e != nil_element && e->is_leaf());
+      this->_export_values(e, val_a, val_b);
+
+      int a_begin = this->elt_a[k], a_end = (k+1 < n_elts ? this->elt_a[k+1] : this->n_a_raw);
+      int b_begin = this->elt_b[k], b_end = (k+1 < n_elts ? this->elt_b[k+1] : this->n_b_raw);
       
-      // if exist, add it
-      if (ret.second == false && this->is_axpy()) 
-        ret.first->second += b.at(i);
+      assert(val_a.size() == (a_end - a_begin)*n_val &&
+             val_b.size() == (b_end - b_begin)*n_val);
 
+      for (int i=a_begin;i<a_end;++i) {
+        int s = this->a_slot[i];
+        if (s < 0 || this->a_out[s] < 0) continue;
+        
+        double *to   = &a[ this->a_out[s]*n_val ];
+        double *from = &val_a[ (i - a_begin)*n_val ];
+        for (int l=0;l<n_val;++l) {
+#pragma omp atomic
+          to[l] += from[l];
+        }
+      }
+      for (int i=b_begin;i<b_end;++i) {
+        int s = this->b_slot[i];
+        if (s < 0) continue;
+
+        double *to   = &b[ s*n_val ];
+        double *from = &val_b[ (i - b_begin)*n_val ];
+        for (int l=0;l<n_val;++l) {
+#pragma omp atomic
+          to[l] += from[l];
+        }
+      }
     }
+    this->t_assemble = timer() - t_base;
 
     return true;
   }
 
-  bool DSparse_::triplet(int is_sym,
+  bool Sparse_::_triplet(int is_sym,
                          int &n_dof, int &n_rhs, int &n_nz,
                          std::vector<int> &ia,
                          std::vector<int> &ja,
@@ -276,74 +462,49 @@ namespace uhm {
     ia.clear();  a.clear();   
     ja.clear();  b.clear();
 
-    std::map< std::pair<int,int>, double >::iterator it;
-    if (this->is_column_major()) {
+    this->_assemble_coo();
 
-      // ia - entree row number
-      // ja - start and end
-      if (is_sym)  // symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
+    int n_val = (this->is_complex() ? 2 : 1);
 
-          // store upper triangular only
-          if (it->first.second >= it->first.first) {
-            ia.push_back( it->first.second );
-            ja.push_back( it->first.first  );
-            a.push_back( it->second );
-          }
+    // column major - ia : entree row number, ja : entree column number
+    // row major    - ia : entree row number, ja : entree column number
+    std::vector<int> &idx_major = (this->is_column_major() ? ja : ia);
+    std::vector<int> &idx_minor = (this->is_column_major() ? ia : ja);
 
-        }
-      else         // non-symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          ia.push_back( it->first.second );
-          ja.push_back( it->first.first  );
-          a.push_back( it->second );
-        }
-      
-      this->n_dof = ja.at( ja.size() - 1 );
-      
-    } else {
-      
-      // ia - start and end
-      // ja - entree column number
-      if (is_sym)  // symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          // store upper triangular only
-          if (it->first.second >= it->first.first) {
-            ia.push_back( it->first.first  );
-            ja.push_back( it->first.second );
-            a.push_back( it->second );
-          }
+    idx_major.reserve(this->a_major.size());
+    idx_minor.reserve(this->a_major.size());
+    a.reserve(this->a_val.size());
 
-        }
-      else         // non-symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          ia.push_back( it->first.first  );
-          ja.push_back( it->first.second );
-          a.push_back( it->second );
-        }
-      
-      this->n_dof = ia.at( ia.size() - 1 );
+    std::vector<int> out(this->a_major.size(), -1);
+    for (int i=0;i<this->a_major.size();++i) {
 
+      // store upper triangular only when it is symmetric
+      if (!is_sym || this->a_minor[i] >= this->a_major[i]) {
+        out[i] = idx_major.size();
+        idx_major.push_back( this->a_major[i] );
+        idx_minor.push_back( this->a_minor[i] );
+        for (int k=0;k<n_val;++k)
+          a.push_back( this->a_val[i*n_val+k] );
+      }
     }
+    this->n_dof = idx_major.at( idx_major.size() - 1 );
 
     // columnmajor vector
-    for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it)
-      b.push_back( it->second );
+    b = this->b_val;
 
-    assert(this->n_rhs == (b.size() / this->n_dof));
+    assert(this->n_rhs == (b.size() / n_val / this->n_dof));
 
     // assign variable
     n_dof = this->n_dof;
     n_rhs = this->n_rhs;
-    n_nz  = a.size();
+    n_nz  = a.size() / n_val;
 
-    printf("ndof %d, nrhs %d, nz %d\n", n_dof, n_rhs, n_nz);
+    this->_set_pattern(is_sym, out);
 
     return true;
   }
 
-  bool DSparse_::compress(int is_sym, 
+  bool Sparse_::_compress(int is_sym,
                           int &n_dof, int &n_rhs, int &n_nz,
                           std::vector<int> &ia,
                           std::vector<int> &ja,
@@ -353,117 +514,166 @@ namespace uhm {
     ia.clear();  a.clear();   
     ja.clear();  b.clear();
 
-    std::map< std::pair<int,int>, double >::iterator it;
-    int prev, cnt;
-
-    if (this->is_column_major()) {
-
-      // ia - entree row number
-      // ja - start and end
-      prev = this->a_ij_val.begin()->first.first;
-
-      cnt = this->is_fort_numbering();
-      ja.push_back( cnt );
-
-      if (is_sym) { // symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          if (it->first.second >= it->first.first) {
-            
-            if (it->first.first != prev) {
-              ja.push_back( cnt );
-              prev = it->first.first;
-            }
-            
-            ++cnt;
-            ia.push_back( it->first.second );
-            a.push_back( it->second );
-            
-          }
-        }
-        this->n_dof = ja.size();
-        ja.push_back( cnt );
-      } else {     // non-symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          if (it->first.first != prev) {
-            ja.push_back( cnt );
-            prev = it->first.first;
-          }
-          
-          ++cnt;
-          ia.push_back( it->first.second );
-          a.push_back( it->second );
-        }
-        this->n_dof = ja.size();
-        ja.push_back( cnt );
-      }
-      
-    } else {
+    this->_assemble_coo();
 
-      // ia - start and end
-      // ja - entree column number
-      prev = this->a_ij_val.begin()->first.first;
-
-      cnt = this->is_fort_numbering();
-      ia.push_back( cnt );
-      if (is_sym) {
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          if (it->first.second >= it->first.first) {
-
-            if (it->first.first != prev) {
-              ia.push_back( cnt );
-              prev = it->first.first;
-            }
-            
-            ++cnt;
-            ja.push_back( it->first.second );
-            a.push_back( it->second );
+    int n_val = (this->is_complex() ? 2 : 1);
 
-          }
-        }
-        this->n_dof = ia.size();
-        ia.push_back( cnt );
-      } else {     // non-sym
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          if (it->first.first != prev) {
-            ia.push_back( cnt );
-            prev = it->first.first;
-          }
-          
-          ++cnt;
-          ja.push_back( it->first.second );
-          a.push_back( it->second );
+    // column major - ia : entree row number, ja : start and end
+    // row major    - ia : start and end, ja : entree column number
+    std::vector<int> &ptr = (this->is_column_major() ? ja : ia);
+    std::vector<int> &idx = (this->is_column_major() ? ia : ja);
+
+    idx.reserve(this->a_major.size());
+    a.reserve(this->a_val.size());
+
+    std::vector<int> out(this->a_major.size(), -1);
+    int prev = this->a_major.at(0);
+    int cnt  = this->is_fort_numbering();
+    ptr.push_back( cnt );
+
+    for (int i=0;i<this->a_major.size();++i) {
+      if (!is_sym || this->a_minor[i] >= this->a_major[i]) {
+
+        if (this->a_major[i] != prev) {
+          ptr.push_back( cnt );
+          prev = this->a_major[i];
         }
-        this->n_dof = ia.size();
-        ia.push_back( cnt );
+
+        out[i] = idx.size();
+        ++cnt;
+        idx.push_back( this->a_minor[i] );
+        for (int k=0;k<n_val;++k)
+          a.push_back( this->a_val[i*n_val+k] );
       }
     }
+    this->n_dof = ptr.size();
+    ptr.push_back( cnt );
 
     // columnmajor vector
-    for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it)
-      b.push_back( it->second );
+    b = this->b_val;
 
-    assert(this->n_rhs == (b.size() / this->n_dof));
+    assert(this->n_rhs == (b.size() / n_val / this->n_dof));
 
     // assign variable
     n_dof = this->n_dof;
     n_rhs = this->n_rhs;
-    n_nz  = a.size();
+    n_nz  = a.size() / n_val;
 
-    printf("ndof %d, nrhs %d, nz %d\n", n_dof, n_rhs, n_nz);
+    this->_set_pattern(is_sym, out);
+
+    return true;
+  }
+
+  void Sparse_::_disp_assemble(FILE *stream) {
+    fprintf(stream, "assemble time %E s, peak memory %E MB\n",
+            this->t_assemble, this->m_assemble/1.0e6);
+  }
+
+  // ----------------------------------------------------------------
+  // ** Sparse double format
+  void DSparse_::reset(int n_rhs) {
+    this->n_rhs = n_rhs;
+    this->n_dof = 0;
+    this->_reset_coo();
+    this->axpy = 1;
+  }
+
+  bool DSparse_::import_element(Element e) {
+
+    // workspace for the interface to UHM
+    std::vector< std::pair<int,int> > ij_a, ij_b;
+    std::vector< double > a, b;
+
+    // leaf element only and real datatype
+    if (e->is_leaf() &&
+        !e->get_matrix()->is_complex_datatype()) {
+      int m, n;
+      for (int i=UHM_ATL;i<UHM_P;++i) 
+        if (e->get_matrix()->is_buffer(i)) 
+          e->export_matrix(this->n_rhs, m, n, ij_a, i);
+      for (int i=UHM_XT;i<UHM_BT;++i) 
+        if (e->get_matrix()->is_buffer(i)) 
+          e->export_matrix(this->n_rhs, m, n, ij_b, i);
+    }
+    this->_export_values(e, a, b);
+
+    // fortran indexing 
+    int shift = this->is_fort_numbering();
     
+    // LHS assemble
+    for (int i=0;i<ij_a.size();++i) {
+
+      // change the index if it use fortran indexing
+      if (!this->is_column_major()) {
+        this->a_major.push_back( ij_a.at(i).first  + shift );
+        this->a_minor.push_back( ij_a.at(i).second + shift );
+      } else {
+        this->a_major.push_back( ij_a.at(i).second + shift );
+        this->a_minor.push_back( ij_a.at(i).first  + shift );
+      }
+      this->a_val.push_back( a.at(i) );
+    }
+
+    // RHS assemble - column numbering only
+    for (int i=0;i<ij_b.size();++i) {
+      this->b_major.push_back( ij_b.at(i).second + shift );
+      this->b_minor.push_back( ij_b.at(i).first  + shift );
+      this->b_val.push_back( b.at(i) );
+    }
+
+    this->_add_element(e, ij_a.size(), ij_b.size());
+
     return true;
   }
-                          
 
+  void DSparse_::_export_values(Element e,
+                                std::vector<double> &a,
+                                std::vector<double> &b) {
+    if (e->is_leaf() &&
+        !e->get_matrix()->is_complex_datatype()) {
+      int m, n;
+      for (int i=UHM_ATL;i<UHM_P;++i) 
+        if (e->get_matrix()->is_buffer(i)) 
+          e->get_matrix()->export_matrix(m, n, a, i);
+      for (int i=UHM_XT;i<UHM_BT;++i) 
+        if (e->get_matrix()->is_buffer(i)) 
+          e->get_matrix()->export_matrix(m, n, b, i);
+    }
+  }
+
+  bool DSparse_::triplet(int is_sym,
+                         int &n_dof, int &n_rhs, int &n_nz,
+                         std::vector<int> &ia,
+                         std::vector<int> &ja,
+                         std::vector<double> &a,
+                         std::vector<double> &b) {
+    this->_triplet(is_sym, n_dof, n_rhs, n_nz, ia, ja, a, b);
+
+    printf("ndof %d, nrhs %d, nz %d\n", n_dof, n_rhs, n_nz);
+    this->_disp_assemble(stdout);
+
+    return true;
+  }
+
+  bool DSparse_::compress(int is_sym, 
+                          int &n_dof, int &n_rhs, int &n_nz,
+                          std::vector<int> &ia,
+                          std::vector<int> &ja,
+                          std::vector<double> &a,
+                          std::vector<double> &b) {
+    this->_compress(is_sym, n_dof, n_rhs, n_nz, ia, ja, a, b);
+
+    printf("ndof %d, nrhs %d, nz %d\n", n_dof, n_rhs, n_nz);
+    this->_disp_assemble(stdout);
+    
+    return true;
+  }
 
   void DSparse_::disp(int ab) {
     this->disp(stdout, ab);
   }
   void DSparse_::disp(FILE *stream, int ab) {
-    std::map< std::pair<int,int>, double >::iterator it;
+    this->_assemble_coo();
 
     // fortran index :: matlab format
     int cnt = 1;
@@ -471,33 +681,33 @@ namespace uhm {
     switch (ab) {
     case UHM_LHS:
       fprintf(stream, "i_A = zeros( %d, 1 ); j_A = zeros( %d, 1 ); s_A = zeros( %d , 1);",
-              (int)a_ij_val.size(), (int)a_ij_val.size(), (int)a_ij_val.size());
+              (int)a_major.size(), (int)a_major.size(), (int)a_major.size());
       fprintf(stream, "m_A = %d; n_A = %d;", this->n_dof, this->n_dof);
              
       if (this->is_column_major()) 
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
+        for (int i=0;i<this->a_major.size();++i) {
           fprintf(stream, "i_A(%d)= %6d; j_A(%d) = %6d; s_A(%d) = % E ; \n", 
-                  cnt, it->first.second, cnt, it->first.first, 
-                  cnt, it->second);
+                  cnt, this->a_minor[i], cnt, this->a_major[i], 
+                  cnt, this->a_val[i]);
           ++cnt;
         }
       else 
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
+        for (int i=0;i<this->a_major.size();++i) {
           fprintf(stream, "i_A(%d)= %6d; j_A(%d)= %6d; s_A(%d)= % E ; \n", 
-                  cnt, it->first.first, cnt, it->first.second, 
-                  cnt, it->second);
+                  cnt, this->a_major[i], cnt, this->a_minor[i], 
+                  cnt, this->a_val[i]);
           ++cnt;
         }
       break;
     case UHM_RHS:
       fprintf(stream, "i_B = zeros( %d, 1 ); j_B = zeros( %d, 1 ); s_B = zeros( %d , 1);",
-              (int)b_ij_val.size(), (int)b_ij_val.size(), (int)b_ij_val.size());
+              (int)b_major.size(), (int)b_major.size(), (int)b_major.size());
       fprintf(stream, "m_B = %d; n_B = %d;", this->n_dof, this->n_dof);
 
-      for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it) {
+      for (int i=0;i<this->b_major.size();++i) {
         fprintf(stream, "i_B(%d)= %6d; j_B(%d) = %6d; s_B(%d)= % E; \n", 
-                cnt, it->first.second, cnt, it->first.first, 
-                cnt, it->second);
+                cnt, this->b_minor[i], cnt, this->b_major[i], 
+                cnt, this->b_val[i]);
         ++cnt;
       }
       break;
@@ -509,8 +719,7 @@ namespace uhm {
   void ZSparse_::reset(int n_rhs) {
     this->n_rhs = n_rhs;
     this->n_dof = 0;
-    this->a_ij_val.clear();
-    this->b_ij_val.clear();
+    this->_reset_coo();
     this->axpy = 1;
   }
 
@@ -528,15 +737,12 @@ namespace uhm {
     if (e->is_leaf() &&
         e->get_matrix()->is_complex_datatype()) {
       int m, n;
-      for (int i=UHM_ATL;i<UHM_P;++i) {
+      for (int i=UHM_ATL;i<UHM_P;++i) 
         e->export_matrix(this->n_rhs, m, n, ij_a, i);
-        e->get_matrix()->export_matrix(m, n, a, i);
-      }
-      for (int i=UHM_BT;i<UHM_RT;++i) {
+      for (int i=UHM_BT;i<UHM_RT;++i) 
         e->export_matrix(n_rhs, m, n, ij_b, i);
-        e->get_matrix()->export_matrix(m, n, b, i);
-      }
     }
+    this->_export_values(e, a, b);
 
     // fortran indexing 
     int shift = this->is_fort_numbering();
@@ -545,132 +751,51 @@ namespace uhm {
     for (int i=0;i<ij_a.size();++i) {
 
       // change the index if it use fortran indexing
-      std::pair< int, int > idx;
       if (!this->is_column_major()) {
-        idx.first  = ij_a.at(i).second + shift;
-        idx.second = ij_a.at(i).first  + shift;
-
+        this->a_major.push_back( ij_a.at(i).second + shift );
+        this->a_minor.push_back( ij_a.at(i).first  + shift );
       } else {
-        idx.first  = ij_a.at(i).first  + shift;
-        idx.second = ij_a.at(i).second + shift;
-
+        this->a_major.push_back( ij_a.at(i).first  + shift );
+        this->a_minor.push_back( ij_a.at(i).second + shift );
       }
-
-      // insert the entree 
-      std::pair< std::map< std::pair<int,int>, std::complex<double> >::iterator, bool > ret;
-      ret = this->a_ij_val.insert( std::pair< std::pair<int,int> , std::complex<double> >
-                                   (idx, std::complex<double>(a.at(2*i), a.at(2*i+1))));
-      
-      // if exist, add it
-      if (ret.second ==false) 
-        ret.first->second += a.at(i);
-
+      this->a_val.push_back( a.at(2*i)   );
+      this->a_val.push_back( a.at(2*i+1) );
     }
     
     // RHS : assemble
     for (int i=0;i<ij_b.size();++i) {
-      
-      // change the index if it use fortran indexing
-      std::pair< int, int > idx;
-      idx.first  = ij_b.at(i).second + shift;
-      idx.second = ij_b.at(i).first  + shift;
-      
-      // insert the entree 
-      std::pair< std::map< std::pair<int,int>, std::complex<double> >::iterator, bool > ret;
-      ret = this->b_ij_val.insert( std::pair< std::pair<int,int> , std::complex<double> >
-                                   (idx, std::complex<double>(b.at(2*i), b.at(2*i+1))));
-      
-      // if exist, add it
-      if (ret.second ==false) 
-        ret.first->second += b.at(i);
-      
+      this->b_major.push_back( ij_b.at(i).second + shift );
+      this->b_minor.push_back( ij_b.at(i).first  + shift );
+      this->b_val.push_back( b.at(2*i)   );
+      this->b_val.push_back( b.at(2*i+1) );
     }
+
+    this->_add_element(e, ij_a.size(), ij_b.size());
+
     return true;
   }
-  
 
+  void ZSparse_::_export_values(Element e,
+                                std::vector<double> &a,
+                                std::vector<double> &b) {
+    if (e->is_leaf() &&
+        e->get_matrix()->is_complex_datatype()) {
+      int m, n;
+      for (int i=UHM_ATL;i<UHM_P;++i) 
+        e->get_matrix()->export_matrix(m, n, a, i);
+      for (int i=UHM_BT;i<UHM_RT;++i) 
+        e->get_matrix()->export_matrix(m, n, b, i);
+    }
+  }
+  
   bool ZSparse_::triplet(int is_sym,
                          int &n_dof, int &n_rhs, int &n_nz,
                          std::vector<int> &ia,
                          std::vector<int> &ja,
                          std::vector<double> &a,
                          std::vector<double> &b) {
-    // clear the vector container
-    ia.clear();  a.clear();   
-    ja.clear();  b.clear();
-
-    std::map< std::pair<int,int>, std::complex<double> >::iterator it;
-    if (this->is_column_major()) {
-
-      // ia - entree row number
-      // ja - start and end
-      if (is_sym) // symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          // store upper triangular only
-          if (it->first.second >= it->first.first) {
-            ia.push_back( it->first.second );
-            ja.push_back( it->first.first  );
-          
-            a.push_back( it->second.real() );
-            a.push_back( it->second.imag() );
-          }
-        }
-      else       // non-symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          ia.push_back( it->first.second );
-          ja.push_back( it->first.first  );
-          
-          a.push_back( it->second.real() );
-          a.push_back( it->second.imag() );
-          
-        }
-
-      this->n_dof = ja.at( ja.size() - 1 );
-      
-    } else {
-      
-      // ia - start and end
-      // ja - entree column number
-      if (is_sym)
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-
-          if (it->first.second >= it->first.first) {
-            ia.push_back( it->first.first  );
-            ja.push_back( it->first.second );
-            
-            a.push_back( it->second.real() );
-            a.push_back( it->second.imag() );
-          }
-        }
-      else
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-
-          ia.push_back( it->first.first  );
-          ja.push_back( it->first.second );
-          
-          a.push_back( it->second.real() );
-          a.push_back( it->second.imag() );
-        }
-
-      this->n_dof = ia.at( ia.size() - 1 );
-
-    }
-
-    // columnmajor vector
-    for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it) {
-      b.push_back( it->second.real() );
-      b.push_back( it->second.imag() );
-    }
-
-    assert(this->n_rhs == (b.size()/2/this->n_dof));
-
-    // assign variable
-    n_dof = this->n_dof;
-    n_rhs = this->n_rhs;
-    n_nz  = a.size() / 2;
-
+    this->_triplet(is_sym, n_dof, n_rhs, n_nz, ia, ja, a, b);
+    this->_disp_assemble(stdout);
     return true;
   }
 
@@ -680,154 +805,37 @@ namespace uhm {
                           std::vector<int> &ja,
                           std::vector<double> &a,
                           std::vector<double> &b) {
-    // clear the vector container
-    ia.clear();  a.clear();   
-    ja.clear();  b.clear();
-
-    std::map< std::pair<int,int>, std::complex<double> >::iterator it;
-    int prev, cnt;
-
-    if (this->is_column_major()) {
-
-      // ia - entree row number
-      // ja - start and end
-      prev = this->a_ij_val.begin()->first.first;
-
-      cnt = this->is_fort_numbering();
-      ja.push_back( cnt );
-
-      if (is_sym) { // symmetric
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-
-          if (it->first.second >= it->first.first) {
-
-            if (it->first.first != prev) {
-              ja.push_back( cnt );
-              prev = it->first.first;
-            }
-
-            ++cnt;
-            ia.push_back( it->first.second );
-            
-            a.push_back( it->second.real() );
-            a.push_back( it->second.imag() );
-          }
-        }
-        this->n_dof = ja.size();
-        ja.push_back( cnt );
-
-      } else {     // non-symmetric
-
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-
-          if (it->first.first != prev) {
-            ja.push_back( cnt );
-            prev = it->first.first;
-          }
-          
-          ++cnt;
-          ia.push_back( it->first.second );
-          
-          a.push_back( it->second.real() );
-          a.push_back( it->second.imag() );
-        }
-        this->n_dof = ja.size();
-        ja.push_back( cnt );
-
-      }
-    } else {
-
-      // ia - start and end
-      // ja - entree column number
-      prev = this->a_ij_val.begin()->first.first;
-
-      cnt = this->is_fort_numbering();
-      ia.push_back( cnt );
-
-      if (is_sym) {
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-         
-          if (it->first.second >= it->first.first) {
-
-            if (it->first.first != prev) {
-              ia.push_back( cnt );
-              prev = it->first.first;
-            }
-            
-            ++cnt;
-            ja.push_back( it->first.second );
-            a.push_back( it->second.real() );
-            a.push_back( it->second.imag() );
-          }
-
-        }
-        this->n_dof = ia.size();
-        ia.push_back( cnt );
-
-      } else {
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) {
-          
-          if (it->first.first != prev) {
-            ia.push_back( cnt );
-            prev = it->first.first;
-          }
-          
-          ++cnt;
-          ja.push_back( it->first.second );
-          a.push_back( it->second.real() );
-          a.push_back( it->second.imag() );
-        }
-        this->n_dof = ia.size();
-        ia.push_back( cnt );
-
-      }
-    }
-
-
-    // columnmajor vector
-    for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it) {
-      b.push_back( it->second.real() );
-      b.push_back( it->second.imag() );
-    }
-
-    assert(this->n_rhs == (b.size()/2/this->n_dof));
-
-    n_dof = this->n_dof;
-    n_rhs = this->n_rhs;
-    n_nz  = a.size()/2;
-
+    this->_compress(is_sym, n_dof, n_rhs, n_nz, ia, ja, a, b);
+    this->_disp_assemble(stdout);
     return true;
   }
-
-
   
   void ZSparse_::disp(int ab) {
     this->disp(stdout, ab);
   }
 
   void ZSparse_::disp(FILE *stream, int ab) {
-    std::map< std::pair<int,int>, std::complex<double> >::iterator it;
-    
+    this->_assemble_coo();
+
     switch (ab) {
     case UHM_LHS:
       if (this->is_column_major()) 
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) 
+        for (int i=0;i<this->a_major.size();++i) 
           fprintf(stream, "( %6d, %6d )::val ( % E, % E ) \n", 
-                  it->first.second, it->first.first, 
-                  it->second.real(), it->second.imag() );
+                  this->a_minor[i], this->a_major[i], 
+                  this->a_val[2*i], this->a_val[2*i+1] );
       else
-        for (it=this->a_ij_val.begin();it!=this->a_ij_val.end();++it) 
+        for (int i=0;i<this->a_major.size();++i) 
           fprintf(stream, "( %6d, %6d )::val ( % E, % E ) \n", 
-                  it->first.first, it->first.second, 
-                  it->second.real(), it->second.imag() );
+                  this->a_major[i], this->a_minor[i], 
+                  this->a_val[2*i], this->a_val[2*i+1] );
       break;
     case UHM_RHS:
-      for (it=this->b_ij_val.begin();it!=this->b_ij_val.end();++it) 
+      for (int i=0;i<this->b_major.size();++i) 
         fprintf(stream, "( %6d, %6d )::val ( %8.3lf, %8.3lf ) \n", 
-                it->first.second, it->first.first, 
-                it->second.real(), it->second.imag() );
+                this->b_minor[i], this->b_major[i], 
+                this->b_val[2*i], this->b_val[2*i+1] );
       break;
     }
   }
 }
-
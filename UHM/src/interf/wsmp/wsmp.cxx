@@ -69,15 +69,9 @@ namespace uhm {
     int fort=1, cs=0;
 
     // sparse object
-    Sparse sp;
-
-    // easy setting
-    if (wsmp->is_complex()) 
-      sp = new ZSparse_(fort, cs, n_rhs);
-    else 
-      sp = new DSparse_(fort, cs, n_rhs);
-
-    this->export_matrix(sp, n_rhs);
+    Sparse sp = wsmp->get_sparse_matrix();
+    unsigned long long hash = this->get_connectivity_hash();
+    int version = this->get_numbering_version();
 
     // default setting
     for (int i = 1;i<65;++i) {
@@ -85,7 +79,23 @@ namespace uhm {
       wsmp->set_dparm( i, 0.0);
     }
 
-    wsmp->set_sparse_matrix(sp);
+    // same mesh and format : numeric values only
+    if (sp != NULL && 
+        sp->is_pattern(false, hash, version) && 
+        n_rhs == wsmp->get_n_rhs()) {
+      wsmp->update_sparse_matrix(this);
+    } else {
+      // easy setting
+      if (wsmp->is_complex()) 
+        sp = new ZSparse_(fort, cs, n_rhs);
+      else 
+        sp = new DSparse_(fort, cs, n_rhs);
+
+      this->export_matrix(sp, n_rhs);
+      sp->set_pattern_key(hash, version);
+
+      wsmp->set_sparse_matrix(sp);
+    }
 
     printf("- WSMP INTERFACED -\n");
     printf("n_dof       : %d\n", (int)wsmp->get_n_dof() );
@@ -93,8 +103,6 @@ namespace uhm {
     printf("n_rhs       : %d\n", (int)wsmp->get_n_rhs() );
     printf("is complex  : %d\n", (int)wsmp->is_complex() );
 
-    delete sp;
-
     return true;
   }
 
@@ -127,7 +135,19 @@ namespace uhm {
 
   void WSMP_::set_iparm(int idx, int val)    { this->iparm[idx-1] = val; }
   void WSMP_::set_dparm(int idx, double val) { this->dparm[idx-1] = val; }
+  WSMP_::~WSMP_() {
+    if (this->sp != NULL) delete this->sp;
+  }
+
+  Sparse WSMP_::get_sparse_matrix() { return this->sp; }
+
   void WSMP_::set_sparse_matrix(Sparse sp)   {
+    // the interface owns the sparse object to re-assemble numerics
+    if (this->sp != sp) {
+      if (this->sp != NULL) delete this->sp;
+      this->sp = sp;
+    }
+
 
     sp->compress( false,
                   this->n_dof, this->n_rhs, this->n_nz,
@@ -163,6 +183,17 @@ namespace uhm {
 
   }
 
+  bool WSMP_::update_sparse_matrix(Mesh m) {
+    if (this->sp == NULL ||
+        !this->sp->update(m, this->a, this->b)) 
+      return false;
+
+    std::copy(this->b.begin(), this->b.end(), this->x.begin());
+    std::fill(this->r.begin(), this->r.end(), 0.0);
+
+    return true;
+  }
+
   int    WSMP_::get_iparm(int idx)  { return this->iparm[idx-1]; }
   double WSMP_::get_dparm(int idx)  { return this->dparm[idx-1]; }
 
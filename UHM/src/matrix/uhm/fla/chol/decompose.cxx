@@ -41,36 +41,39 @@ namespace uhm {
 
   static inline int chol_flat( int fs, int ss, 
 			       linal::Flat_ ATL, linal::Flat_ ATR,
-			       linal::Flat_ ABL, linal::Flat_ ABR );
+			       linal::Flat_ ABL, linal::Flat_ ABR, int rec );
 
   static inline int chol_hier( int fs, int ss,
 			       linal::Hier_ ATL, linal::Hier_ ATR,
-			       linal::Hier_ ABL, linal::Hier_ ABR );
+			       linal::Hier_ ABL, linal::Hier_ ABR, int rec );
   
   void Matrix_FLA_::chol() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    chol_hier( this->fs, this->ss, 
-	       this->hier.ATL, this->hier.ATR,
-	       this->hier.ABL, this->hier.ABR );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix
-    // ----------------------------------------------------------
-    chol_flat( this->fs, this->ss, 
-	       this->flat.ATL, this->flat.ATR,
-	       this->flat.ABL, this->flat.ABR );
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      chol_hier( this->fs, this->ss, 
+		 this->hier.ATL, this->hier.ATR,
+		 this->hier.ABL, this->hier.ABR, this->use_rec );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix
+      // ----------------------------------------------------------
+      chol_flat( this->fs, this->ss, 
+		 this->flat.ATL, this->flat.ATR,
+		 this->flat.ABL, this->flat.ABR, this->use_rec );
+    }
   }
 
   static inline int chol_flat( int fs, int ss, 
 			       linal::Flat_ ATL, linal::Flat_ ATR,
-			       linal::Flat_ ABL, linal::Flat_ ABR ) {
+			       linal::Flat_ ABL, linal::Flat_ ABR, int rec ) {
     if (fs) { 
-      FLA_Chol( FLA_LOWER_TRIANGULAR, ~ATL );
+      if (rec)
+        linal::chol_rec( FLA_LOWER_TRIANGULAR, ATL );
+      else
+        FLA_Chol( FLA_LOWER_TRIANGULAR, ~ATL );
     }
   
     if (fs && ss) {
@@ -84,9 +87,13 @@ namespace uhm {
 
   static inline int chol_hier( int fs, int ss, 
 			       linal::Hier_ ATL, linal::Hier_ ATR,
-			       linal::Hier_ ABL, linal::Hier_ ABR ) {
-    if (fs) 
-      linal::dense::chol( FLA_LOWER_TRIANGULAR, ATL);
+			       linal::Hier_ ABL, linal::Hier_ ABR, int rec ) {
+    if (fs) {
+      if (rec)
+        linal::dense::chol_rec( FLA_LOWER_TRIANGULAR, ATL );
+      else
+        linal::dense::chol( FLA_LOWER_TRIANGULAR, ATL );
+    }
   
     if (fs && ss) {
       linal::dense::trsm( FLA_RIGHT, FLA_LOWER_TRIANGULAR, FLA_TRANSPOSE,
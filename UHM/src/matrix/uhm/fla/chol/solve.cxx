@@ -58,78 +58,78 @@ namespace uhm {
   
   void Matrix_FLA_::solve_chol_1_x() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_1_hier( this->fs, this->ss,
-		       this->hier.ATL, this->hier.ABL,
-		       this->hier.xt,  this->hier.xb );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_1_flat( this->fs, this->ss,
-		       this->flat.ATL, this->flat.ABL,
-		       this->flat.xt,  this->flat.xb );
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_1_hier( this->fs, this->ss,
+			 this->hier.ATL, this->hier.ABL,
+			 this->hier.xt,  this->hier.xb );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_1_flat( this->fs, this->ss,
+			 this->flat.ATL, this->flat.ABL,
+			 this->flat.xt,  this->flat.xb );
     
-#endif
+    }
   }
 
   void Matrix_FLA_::solve_chol_2_x() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    solve_chol_2_hier( this->fs, this->ss,
-		       this->hier.ATL, this->hier.ABL,
-		       this->hier.xt,  this->hier.xb);
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_2_flat( this->fs, this->ss,
-		       this->flat.ATL, this->flat.ABL,
-		       this->flat.xt,  this->flat.xb);
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      solve_chol_2_hier( this->fs, this->ss,
+			 this->hier.ATL, this->hier.ABL,
+			 this->hier.xt,  this->hier.xb);
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_2_flat( this->fs, this->ss,
+			 this->flat.ATL, this->flat.ABL,
+			 this->flat.xt,  this->flat.xb);
+    }
   }    
   
   void Matrix_FLA_::solve_chol_1_r() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_1_hier( this->fs, this->ss,
-		       this->hier.ATL, this->hier.ABL,
-		       this->hier.rt,  this->hier.rb );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_1_flat( this->fs, this->ss,
-		       this->flat.ATL, this->flat.ABL,
-		       this->flat.rt,  this->flat.rb );
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_1_hier( this->fs, this->ss,
+			 this->hier.ATL, this->hier.ABL,
+			 this->hier.rt,  this->hier.rb );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_1_flat( this->fs, this->ss,
+			 this->flat.ATL, this->flat.ABL,
+			 this->flat.rt,  this->flat.rb );
     
-#endif
+    }
   }
 
   void Matrix_FLA_::solve_chol_2_r() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    solve_chol_2_hier( this->fs, this->ss,
-		       this->hier.ATL, this->hier.ABL,
-		       this->hier.rt,  this->hier.rb);
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_chol_2_flat( this->fs, this->ss,
-		       this->flat.ATL, this->flat.ABL,
-		       this->flat.rt,  this->flat.rb);
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      solve_chol_2_hier( this->fs, this->ss,
+			 this->hier.ATL, this->hier.ABL,
+			 this->hier.rt,  this->hier.rb);
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_chol_2_flat( this->fs, this->ss,
+			 this->flat.ATL, this->flat.ABL,
+			 this->flat.rt,  this->flat.rb);
+    }
   }    
 
   static inline int solve_chol_1_flat( int fs, int ss,
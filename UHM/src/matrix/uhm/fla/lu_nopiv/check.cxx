@@ -39,75 +39,75 @@
 namespace uhm {
   void Matrix_FLA_::check_lu_nopiv_1() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs) {
-      FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
-      linal::dense::trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
-                          FLA_NONUNIT_DIAG, FLA_ONE, 
-                          this->hier.ATL, this->hier.rt ); 
-    }
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs) {
+        FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
+        linal::dense::trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                            FLA_NONUNIT_DIAG, FLA_ONE, 
+                            this->hier.ATL, this->hier.rt ); 
+      }
 
-    if (this->fs && this->ss) {
-      linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-                          this->hier.ATR, this->hier.xb, 
-                          FLA_ONE, this->hier.rt );
-    }
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs) {
-      FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
-      FLA_Trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
-		FLA_NONUNIT_DIAG, FLA_ONE, 
-		~(this->flat.ATL), ~(this->flat.rt) ); 
-    }
+      if (this->fs && this->ss) {
+        linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+                            this->hier.ATR, this->hier.xb, 
+                            FLA_ONE, this->hier.rt );
+      }
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs) {
+        FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
+        FLA_Trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+		  FLA_NONUNIT_DIAG, FLA_ONE, 
+		  ~(this->flat.ATL), ~(this->flat.rt) ); 
+      }
 
-    if (this->fs && this->ss) {
-      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-		~(this->flat.ATR), ~(this->flat.xb), 
-		FLA_ONE, ~(this->flat.rt) );
+      if (this->fs && this->ss) {
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+		  ~(this->flat.ATR), ~(this->flat.xb), 
+		  FLA_ONE, ~(this->flat.rt) );
+      }
     }
-#endif
   }
    
   // from leaf to root
   void Matrix_FLA_::check_lu_nopiv_2() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs && this->ss) {
-      linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-                          this->hier.ABL, this->hier.rt, 
-                          FLA_ONE, this->hier.rb );
-    }
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs && this->ss) {
+        linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+                            this->hier.ABL, this->hier.rt, 
+                            FLA_ONE, this->hier.rb );
+      }
     
-    if (this->fs) {
-      linal::dense::trmm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
-                          FLA_UNIT_DIAG, FLA_ONE, 
-                          this->hier.ATL, this->hier.rt ); 
-    }
-    // rb should be merged for upper hierarchy
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs && this->ss) {
-      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-		~(this->flat.ABL), ~(this->flat.rt), 
-		FLA_ONE, ~(this->flat.rb) );
-    }
+      if (this->fs) {
+        linal::dense::trmm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                            FLA_UNIT_DIAG, FLA_ONE, 
+                            this->hier.ATL, this->hier.rt ); 
+      }
+      // rb should be merged for upper hierarchy
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs && this->ss) {
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+		  ~(this->flat.ABL), ~(this->flat.rt), 
+		  FLA_ONE, ~(this->flat.rb) );
+      }
     
-    if (this->fs) {
-      FLA_Trmm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
-		FLA_UNIT_DIAG, FLA_ONE, 
-		~(this->flat.ATL), ~(this->flat.rt) ); 
+      if (this->fs) {
+        FLA_Trmm( FLA_LEFT, FLA_LOWER_TRIANGULAR, FLA_NO_TRANSPOSE,
+		  FLA_UNIT_DIAG, FLA_ONE, 
+		  ~(this->flat.ATL), ~(this->flat.rt) ); 
+      }
+      // rb should be merged for upper hierarchy
     }
-    // rb should be merged for upper hierarchy
-#endif
   }
 }
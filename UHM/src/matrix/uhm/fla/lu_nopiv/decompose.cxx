@@ -41,36 +41,40 @@ namespace uhm {
 
   static inline int lu_nopiv_flat( int fs, int ss, 
 				   linal::Flat_ ATL, linal::Flat_ ATR,
-				   linal::Flat_ ABL, linal::Flat_ ABR );
+				   linal::Flat_ ABL, linal::Flat_ ABR, int rec );
 
   static inline int lu_nopiv_hier( int fs, int ss,
 				   linal::Hier_ ATL, linal::Hier_ ATR,
-				   linal::Hier_ ABL, linal::Hier_ ABR );
+				   linal::Hier_ ABL, linal::Hier_ ABR, int rec );
   
   
   void Matrix_FLA_::lu_nopiv() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    lu_nopiv_hier( this->fs, this->ss, 
-		   this->hier.ATL, this->hier.ATR,
-		   this->hier.ABL, this->hier.ABR );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix
-    // ----------------------------------------------------------
-    lu_nopiv_flat( this->fs, this->ss, 
-		   this->flat.ATL, this->flat.ATR,
-		   this->flat.ABL, this->flat.ABR );
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      lu_nopiv_hier( this->fs, this->ss, 
+		     this->hier.ATL, this->hier.ATR,
+		     this->hier.ABL, this->hier.ABR, this->use_rec );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix
+      // ----------------------------------------------------------
+      lu_nopiv_flat( this->fs, this->ss, 
+		     this->flat.ATL, this->flat.ATR,
+		     this->flat.ABL, this->flat.ABR, this->use_rec );
+    }
   }
   static inline int lu_nopiv_flat( int fs, int ss, 
 				   linal::Flat_ ATL, linal::Flat_ ATR,
-				   linal::Flat_ ABL, linal::Flat_ ABR ) {
-    if (fs) 
-      FLA_LU_nopiv(~ATL);
+				   linal::Flat_ ABL, linal::Flat_ ABR, int rec ) {
+    if (fs) {
+      if (rec)
+        linal::lu_nopiv_rec(ATL);
+      else
+        FLA_LU_nopiv(~ATL);
+    }
   
     if (fs && ss) {
     
@@ -94,10 +98,13 @@ namespace uhm {
 
   static inline int lu_nopiv_hier( int fs, int ss, 
 				   linal::Hier_ ATL, linal::Hier_ ATR,
-				   linal::Hier_ ABL, linal::Hier_ ABR ) {
+				   linal::Hier_ ABL, linal::Hier_ ABR, int rec ) {
 
     if (fs) {
-      linal::dense::lu_nopiv(ATL);
+      if (rec)
+        linal::dense::lu_nopiv_rec(ATL);
+      else
+        linal::dense::lu_nopiv(ATL);
  
       if (ss) {
     
@@ -42,12 +42,12 @@ namespace uhm {
   static int lu_piv_flat( int fs, int ss,
                           linal::Flat_ ATL, linal::Flat_ ATR,
                           linal::Flat_ ABL, linal::Flat_ ABR,
-                          linal::Flat_ p );
+                          linal::Flat_ p, int rec );
   
   static int lu_piv_hier( int fs, int ss, 
 			  linal::Hier_ ATL, linal::Hier_ ATR,
 			  linal::Hier_ ABL, linal::Hier_ ABR,
-			  linal::Hier_ p );
+			  linal::Hier_ p, int rec );
   static int lu_incpiv_hier( int fs, int ss, 
 			     linal::Hier_ ATL, linal::Hier_ ATR,
 			     linal::Hier_ ABL, linal::Hier_ ABR,
@@ -55,47 +55,51 @@ namespace uhm {
   
   void Matrix_FLA_::lu_piv() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    lu_piv_hier( this->fs, this->ss, 
-		 this->hier.ATL, this->hier.ATR,
-		 this->hier.ABL, this->hier.ABR,
-		 this->hier.p );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix - Level Matrix
-    // ----------------------------------------------------------
-    lu_piv_flat( this->fs, this->ss, 
-		 this->flat.ATL, this->flat.ATR,
-		 this->flat.ABL, this->flat.ABR,
-		 this->flat.p );
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      lu_piv_hier( this->fs, this->ss, 
+		   this->hier.ATL, this->hier.ATR,
+		   this->hier.ABL, this->hier.ABR,
+		   this->hier.p, this->use_rec );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix - Level Matrix
+      // ----------------------------------------------------------
+      lu_piv_flat( this->fs, this->ss, 
+		   this->flat.ATL, this->flat.ATR,
+		   this->flat.ABL, this->flat.ABR,
+		   this->flat.p, this->use_rec );
+    }
   }
   
   void Matrix_FLA_::lu_incpiv() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    lu_incpiv_hier( this->fs, this->ss, 
-		    this->hier.ATL, this->hier.ATR,
-		    this->hier.ABL, this->hier.ABR,
-		    this->hier.p );
-#else
-    fprintf(stderr, "incremental pivoting is not supported in flat matrix\n");
-    abort();
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      lu_incpiv_hier( this->fs, this->ss, 
+		      this->hier.ATL, this->hier.ATR,
+		      this->hier.ABL, this->hier.ABR,
+		      this->hier.p );
+    } else {
+      fprintf(stderr, "incremental pivoting is not supported in flat matrix\n");
+      abort();
+    }
   }
   
   static inline int lu_piv_flat( int fs, int ss, 
 				 linal::Flat_ ATL, linal::Flat_ ATR,
 				 linal::Flat_ ABL, linal::Flat_ ABR,
-				 linal::Flat_ p ) {
-    if (fs) 
-      FLA_LU_piv( ~ATL, ~p );
+				 linal::Flat_ p, int rec ) {
+    if (fs) {
+      if (rec)
+        linal::lu_piv_rec( ATL, p );
+      else
+        FLA_LU_piv( ~ATL, ~p );
+    }
   
     if (fs && ss) {
     
@@ -124,9 +128,13 @@ namespace uhm {
   static inline int lu_piv_hier( int fs, int ss, 
 				 linal::Hier_ ATL, linal::Hier_ ATR,
 				 linal::Hier_ ABL, linal::Hier_ ABR,
-				 linal::Hier_ p ) {
-    if (fs) 
-      linal::dense::lu_piv( ATL, p );
+				 linal::Hier_ p, int rec ) {
+    if (fs) {
+      if (rec)
+        linal::dense::lu_piv_rec( ATL, p );
+      else
+        linal::dense::lu_piv( ATL, p );
+    }
   
     if (fs && ss) {
     
@@ -81,7 +81,7 @@ namespace uhm {
 
     flat.p.create_without_buffer(FLA_INT, this->fs, 1);
 
-    int b  = get_hier_block_size();
+    int b  = this->_get_block_size();
 
     flat.xt.create_without_buffer(type, this->fs, this->n_rhs);
     flat.xb.create_without_buffer(type, this->ss, this->n_rhs);
@@ -90,22 +90,21 @@ namespace uhm {
     flat.rt.create_without_buffer(type, this->fs, this->n_rhs);
     flat.rb.create_without_buffer(type, this->ss, this->n_rhs);
     
-#ifdef UHM_HIER_MATRIX_ENABLE
-    for (int i=UHM_ATL;i<UHM_T;++i) 
-      if (is_created(i))
-        _get_hier(i).create(_get_flat(i), b, b);
-
-    for (int i=UHM_XT;i<UHM_END;++i) 
-      if (is_created(i))
-        _get_hier(i).create(_get_flat(i), b, b);
-#endif
+    if (this->use_hier) {
+      for (int i=UHM_ATL;i<UHM_T;++i) 
+        if (is_created(i))
+          _get_hier(i).create(_get_flat(i), b, b);
+
+      for (int i=UHM_XT;i<UHM_END;++i) 
+        if (is_created(i))
+          _get_hier(i).create(_get_flat(i), b, b);
+    }
   }
 
   void Matrix_FLA_::free() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    for (int i=UHM_ATL;i<UHM_END;++i)
-      _get_hier(i).free();
-#endif
+    if (this->use_hier) 
+      for (int i=UHM_ATL;i<UHM_END;++i)
+        _get_hier(i).free();
 
     for (int i=UHM_ATL;i<UHM_END;++i)
       _get_flat(i).free();
@@ -219,6 +218,45 @@ namespace uhm {
       FLA_Axpy(FLA_MINUS_ONE, ~(this->flat.rb), ~(this->flat.xb) );
   }
 
+  void Matrix_FLA_::multiply(int n_rhs, void *x, void *y) {
+    // unassembled A of the leaf applied to the gathered vector
+    int m = this->fs + this->ss;
+    if (!m || !n_rhs) return;
+
+    int size = (this->is_complex_datatype() ? 2 : 1)*sizeof(double);
+
+    FLA_Obj XT, XB, YT, YB;
+    FLA_Obj_create_without_buffer( this->datatype, this->fs, n_rhs, &XT );
+    FLA_Obj_create_without_buffer( this->datatype, this->ss, n_rhs, &XB );
+    FLA_Obj_create_without_buffer( this->datatype, this->fs, n_rhs, &YT );
+    FLA_Obj_create_without_buffer( this->datatype, this->ss, n_rhs, &YB );
+
+    FLA_Obj_attach_buffer( x,                        1, m, &XT );
+    FLA_Obj_attach_buffer( (char*)x + this->fs*size, 1, m, &XB );
+    FLA_Obj_attach_buffer( y,                        1, m, &YT );
+    FLA_Obj_attach_buffer( (char*)y + this->fs*size, 1, m, &YB );
+
+    if (this->fs) {
+      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                FLA_ONE, ~(this->flat.ATL), XT, FLA_ONE, YT );
+      if (this->ss) 
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                  FLA_ONE, ~(this->flat.ATR), XB, FLA_ONE, YT );
+    }
+    if (this->ss) {
+      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                FLA_ONE, ~(this->flat.ABR), XB, FLA_ONE, YB );
+      if (this->fs) 
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE,
+                  FLA_ONE, ~(this->flat.ABL), XT, FLA_ONE, YB );
+    }
+
+    FLA_Obj_free_without_buffer( &XT );
+    FLA_Obj_free_without_buffer( &XB );
+    FLA_Obj_free_without_buffer( &YT );
+    FLA_Obj_free_without_buffer( &YB );
+  }
+
   double Matrix_FLA_::get_residual() {
     if (!this->fs) return 0.0;
 
@@ -478,6 +516,15 @@ namespace uhm {
     this->n_rhs      = n_rhs;
     this->datatype   = datatype;
     this->cm         = fs;
+    this->bs         = get_hier_block_size(fs, ss);
+    this->use_hier   = is_hier_matrix(fs, ss);
+    this->use_rec    = is_recursive_matrix(fs, ss);
+  }
+
+  // ** flat fronts are tiled as one block on the hier path
+  int Matrix_FLA_::_get_block_size() {
+    if (this->bs) return this->bs;
+    return max(max(this->fs, this->ss), 1);
   }
 
   void Matrix_FLA_::_create_buffer(linal::Matrix_ &obj) {
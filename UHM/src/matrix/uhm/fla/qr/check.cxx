@@ -40,121 +40,121 @@ namespace uhm {
 
   void Matrix_FLA_::check_qr_1() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs) {
-      FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
-      linal::dense::trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
-                          FLA_NONUNIT_DIAG, FLA_ONE, 
-                          this->hier.ATL, this->hier.rt ); 
-    }
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs) {
+        FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
+        linal::dense::trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+                            FLA_NONUNIT_DIAG, FLA_ONE, 
+                            this->hier.ATL, this->hier.rt ); 
+      }
 
-    if (this->fs && this->ss) {
-      linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-                          this->hier.ATR, this->hier.xb, 
-                          FLA_ONE, this->hier.rt );
-    }
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs) {
-      FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
-      FLA_Trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
-		FLA_NONUNIT_DIAG, FLA_ONE, 
-		~(this->flat.ATL), ~(this->flat.rt) ); 
-    }
+      if (this->fs && this->ss) {
+        linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+                            this->hier.ATR, this->hier.xb, 
+                            FLA_ONE, this->hier.rt );
+      }
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs) {
+        FLA_Copy( ~(this->flat.xt), ~(this->flat.rt) );
+        FLA_Trmm( FLA_LEFT, FLA_UPPER_TRIANGULAR, FLA_NO_TRANSPOSE,
+		  FLA_NONUNIT_DIAG, FLA_ONE, 
+		  ~(this->flat.ATL), ~(this->flat.rt) ); 
+      }
 
-    if (this->fs && this->ss) {
-      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-		~(this->flat.ATR), ~(this->flat.xb), 
-		FLA_ONE, ~(this->flat.rt) );
+      if (this->fs && this->ss) {
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+		  ~(this->flat.ATR), ~(this->flat.xb), 
+		  FLA_ONE, ~(this->flat.rt) );
+      }
     }
-#endif
   }
    
   // from leaf to root
   void Matrix_FLA_::check_qr_2() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs && this->ss) {
-      linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-                          this->hier.ABL, this->hier.rt, 
-                          FLA_ONE, this->hier.rb );
-    }
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs && this->ss) {
+        linal::dense::gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+                            this->hier.ABL, this->hier.rt, 
+                            FLA_ONE, this->hier.rb );
+      }
     
-    if (this->fs) {
+      if (this->fs) {
 
 #ifdef UHM_QR_INC_ENABLE
-      {
-        linal::Flat_ W;
-        linal::Hier_ W_1;
-
-        int mb = get_hier_block_size();
-
-        W.create    ( this->hier.ATL.get_data_type(), 
-                      mb, mb*this->hier.rt.get_n() );
-        W_1.create  ( W, mb, mb );
-
-        linal::dense::apply_q_inc( FLA_LEFT, FLA_NO_TRANSPOSE, 
-                                   FLA_FORWARD, FLA_COLUMNWISE,
-                                   this->hier.ATL, this->hier.T, 
-                                   W_1, this->hier.rt );
-        W_1.free();
-        W.free();
-      }
+        {
+          linal::Flat_ W;
+          linal::Hier_ W_1;
+
+          int mb = this->_get_block_size();
+
+          W.create    ( this->hier.ATL.get_data_type(), 
+                        mb, mb*this->hier.rt.get_n() );
+          W_1.create  ( W, mb, mb );
+
+          linal::dense::apply_q_inc( FLA_LEFT, FLA_NO_TRANSPOSE, 
+                                     FLA_FORWARD, FLA_COLUMNWISE,
+                                     this->hier.ATL, this->hier.T, 
+                                     W_1, this->hier.rt );
+          W_1.free();
+          W.free();
+        }
 #else 
-      {
-        linal::Flat_ W;
-        linal::Hier_ W_1;
+        {
+          linal::Flat_ W;
+          linal::Hier_ W_1;
 
-        int mb = get_hier_block_size();
+          int mb = this->_get_block_size();
 
-        W.create    ( this->hier.ATL.get_data_type(), 
-                      this->hier.T.flat().get_m(), this->hier.rt.flat().get_n() );
-        W_1.create  ( W, mb, mb );
+          W.create    ( this->hier.ATL.get_data_type(), 
+                        this->hier.T.flat().get_m(), this->hier.rt.flat().get_n() );
+          W_1.create  ( W, mb, mb );
 
-        linal::dense::apply_q( FLA_LEFT, FLA_NO_TRANSPOSE,
-                               FLA_FORWARD, FLA_COLUMNWISE,
-                               this->hier.ATL, this->hier.T, 
-                               W_1, this->hier.rt );
+          linal::dense::apply_q( FLA_LEFT, FLA_NO_TRANSPOSE,
+                                 FLA_FORWARD, FLA_COLUMNWISE,
+                                 this->hier.ATL, this->hier.T, 
+                                 W_1, this->hier.rt );
 
-        W_1.free();
-        W.free();
-      }
+          W_1.free();
+          W.free();
+        }
 #endif
-    }
-    // rb should be merged for upper hierarchy
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    if (this->fs && this->ss) {
-      FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
-		~(this->flat.ABL), ~(this->flat.rt), 
-		FLA_ONE, ~(this->flat.rb) );
-    }
+      }
+      // rb should be merged for upper hierarchy
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      if (this->fs && this->ss) {
+        FLA_Gemm( FLA_NO_TRANSPOSE, FLA_NO_TRANSPOSE, FLA_ONE,
+		  ~(this->flat.ABL), ~(this->flat.rt), 
+		  FLA_ONE, ~(this->flat.rb) );
+      }
     
-    if (this->fs) {
+      if (this->fs) {
 
-      linal::Flat_ W;
+        linal::Flat_ W;
 
-      W.create    ( this->flat.ATL.get_data_type(), 
-                    this->flat.T.get_m(), this->flat.rt.get_n() );
+        W.create    ( this->flat.ATL.get_data_type(), 
+                      this->flat.T.get_m(), this->flat.rt.get_n() );
 
-      FLA_Apply_Q_UT( FLA_LEFT, FLA_NO_TRANSPOSE,
-                      FLA_FORWARD, FLA_COLUMNWISE,
-                      ~(this->flat.ATL), ~(this->flat.T), 
-                      ~W, ~(this->flat.rt) );
+        FLA_Apply_Q_UT( FLA_LEFT, FLA_NO_TRANSPOSE,
+                        FLA_FORWARD, FLA_COLUMNWISE,
+                        ~(this->flat.ATL), ~(this->flat.T), 
+                        ~W, ~(this->flat.rt) );
 
-      W.free();
+        W.free();
 
+      }
+      // rb should be merged for upper hierarchy
     }
-    // rb should be merged for upper hierarchy
-#endif
   }
 }
@@ -45,29 +45,29 @@ namespace uhm {
   static int qr_hier( int fs, int ss, 
                       linal::Hier_ ATL, linal::Hier_ ATR,
                       linal::Hier_ ABL, linal::Hier_ ABR,
-                      linal::Hier_ T );
+                      linal::Hier_ T, int mb );
 
   void Matrix_FLA_::_qr_create_T() {
-    int b  = get_hier_block_size();
+    int b  = this->_get_block_size();
 
-#ifdef UHM_HIER_MATRIX_ENABLE
+    if (this->use_hier) {
 
-    // ** QR_INC only works for hier matrix
+      // ** QR_INC only works for hier matrix
 #ifdef UHM_QR_INC_ENABLE
-    int t_fs = ( this->fs/b > 0 ? ( ( this->fs/b + (this->fs%b>0) )*b ) : this->fs );
-    int t_ss = ( this->ss/b > 0 ? ( ( this->ss/b + (this->ss%b>0) )*b ) : this->ss );
+      int t_fs = ( this->fs/b > 0 ? ( ( this->fs/b + (this->fs%b>0) )*b ) : this->fs );
+      int t_ss = ( this->ss/b > 0 ? ( ( this->ss/b + (this->ss%b>0) )*b ) : this->ss );
 
-    flat.T.create_without_buffer(this->datatype, t_fs, t_fs);
-    hier.T.create(flat.T, b, b);
+      flat.T.create_without_buffer(this->datatype, t_fs, t_fs);
+      hier.T.create(flat.T, b, b);
 #else
-    flat.T.create_without_buffer(this->datatype, this->fs, this->fs);
-    hier.T.create(flat.T, b, b);
+      flat.T.create_without_buffer(this->datatype, this->fs, this->fs);
+      hier.T.create(flat.T, b, b);
 #endif
 
 
-#else
-    flat.T.create_without_buffer(this->datatype, this->fs, this->fs);
-#endif
+    } else {
+      flat.T.create_without_buffer(this->datatype, this->fs, this->fs);
+    }
 
     this->create_buffer(UHM_T);
   }
@@ -79,23 +79,23 @@ namespace uhm {
       this->_qr_create_T();
 
     // ** decomposition
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    qr_hier( this->fs, this->ss, 
-             this->hier.ATL, this->hier.ATR,
-             this->hier.ABL, this->hier.ABR,
-             this->hier.T );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix - Level Matrix
-    // ----------------------------------------------------------
-    qr_flat( this->fs, this->ss, 
-             this->flat.ATL, this->flat.ATR,
-             this->flat.ABL, this->flat.ABR,
-             this->flat.T );
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      qr_hier( this->fs, this->ss, 
+               this->hier.ATL, this->hier.ATR,
+               this->hier.ABL, this->hier.ABR,
+               this->hier.T, this->_get_block_size() );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix - Level Matrix
+      // ----------------------------------------------------------
+      qr_flat( this->fs, this->ss, 
+               this->flat.ATL, this->flat.ATR,
+               this->flat.ABL, this->flat.ABR,
+               this->flat.T );
+    }
   }
   
   static inline int qr_flat( int fs, int ss, 
@@ -137,7 +137,7 @@ namespace uhm {
   static inline int qr_hier( int fs, int ss, 
                              linal::Hier_ ATL, linal::Hier_ ATR,
                              linal::Hier_ ABL, linal::Hier_ ABR,
-                             linal::Hier_ T ) {
+                             linal::Hier_ T, int mb ) {
     if (fs) {
 #ifdef UHM_QR_INC_ENABLE
       linal::dense::qr_inc( ATL, T );
@@ -155,7 +155,6 @@ namespace uhm {
 	linal::Flat_ W;
 	linal::Hier_ W_1;
 	
-	int mb   = get_hier_block_size();
         int t_fs = ( fs/mb > 0 ? ( ( fs/mb + (fs%mb>0) )*mb ) : fs );
 
 	W.create    ( ATL.get_data_type(), fs, ATR.flat().get_n() );
@@ -177,8 +176,6 @@ namespace uhm {
 	linal::Flat_ W;
 	linal::Hier_ W_1;
 	
-	int mb  = get_hier_block_size();
-	
 	W.create    ( ATL.get_data_type(), T.flat().get_m(), ATR.flat().get_n() );
 	W_1.create  ( W, mb, mb );
 	
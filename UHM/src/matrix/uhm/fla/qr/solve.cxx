@@ -53,7 +53,7 @@ namespace uhm {
   static int solve_qr_1_hier( int fs, int ss,
                               linal::Hier_ ATL, linal::Hier_ ABL, 
                               linal::Hier_ t,   linal::Hier_ b,
-                              linal::Hier_ T );
+                              linal::Hier_ T,   int mb );
 
 
   static int solve_qr_2_hier( int fs, int ss,
@@ -63,85 +63,85 @@ namespace uhm {
   
   void Matrix_FLA_::solve_qr_1_x() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_1_hier( this->fs, this->ss,
-                     this->hier.ATL, this->hier.ABL,
-                     this->hier.xt,  this->hier.xb,
-                     this->hier.T );
-
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_1_flat( this->fs, this->ss,
-                     this->flat.ATL, this->flat.ABL,
-                     this->flat.xt,  this->flat.xb,
-                     this->flat.T );
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_1_hier( this->fs, this->ss,
+                       this->hier.ATL, this->hier.ABL,
+                       this->hier.xt,  this->hier.xb,
+                       this->hier.T,   this->_get_block_size() );
+
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_1_flat( this->fs, this->ss,
+                       this->flat.ATL, this->flat.ABL,
+                       this->flat.xt,  this->flat.xb,
+                       this->flat.T );
 
 
-#endif
+    }
   }
 
   void Matrix_FLA_::solve_qr_2_x() {
 
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    solve_qr_2_hier( this->fs, this->ss,
-                     this->hier.ATL, this->hier.ATR,
-                     this->hier.xt,  this->hier.xb );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_2_flat( this->fs, this->ss,
-                     this->flat.ATL, this->flat.ATR,
-                     this->flat.xt,  this->flat.xb );
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      solve_qr_2_hier( this->fs, this->ss,
+                       this->hier.ATL, this->hier.ATR,
+                       this->hier.xt,  this->hier.xb );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_2_flat( this->fs, this->ss,
+                       this->flat.ATL, this->flat.ATR,
+                       this->flat.xt,  this->flat.xb );
 
-#endif
+    }
   }    
 
   void Matrix_FLA_::solve_qr_1_r() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_1_hier( this->fs, this->ss,
-                     this->hier.ATL, this->hier.ABL,
-                     this->hier.rt,  this->hier.rb, 
-                     this->hier.T );
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_1_flat( this->fs, this->ss,
-                     this->flat.ATL, this->flat.ABL,
-                     this->flat.rt,  this->flat.rb, 
-                     this->flat.T );
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_1_hier( this->fs, this->ss,
+                       this->hier.ATL, this->hier.ABL,
+                       this->hier.rt,  this->hier.rb, 
+                       this->hier.T,   this->_get_block_size() );
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_1_flat( this->fs, this->ss,
+                       this->flat.ATL, this->flat.ABL,
+                       this->flat.rt,  this->flat.rb, 
+                       this->flat.T );
 
-#endif
+    }
   }
 
   void Matrix_FLA_::solve_qr_2_r() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    // ----------------------------------------------------------
-    // ** Hier-Matrix
-    // ----------------------------------------------------------
-    solve_qr_2_hier( this->fs, this->ss,
-                     this->hier.ATL, this->hier.ATR,
-                     this->hier.rt,  this->hier.rb);
-#else
-    // ----------------------------------------------------------
-    // ** Flat-Matrix 
-    // ----------------------------------------------------------
-    solve_qr_2_flat( this->fs, this->ss,
-                     this->flat.ATL, this->flat.ATR,
-                     this->flat.rt,  this->flat.rb);
-#endif
+    if (this->use_hier) {
+      // ----------------------------------------------------------
+      // ** Hier-Matrix
+      // ----------------------------------------------------------
+      solve_qr_2_hier( this->fs, this->ss,
+                       this->hier.ATL, this->hier.ATR,
+                       this->hier.rt,  this->hier.rb);
+    } else {
+      // ----------------------------------------------------------
+      // ** Flat-Matrix 
+      // ----------------------------------------------------------
+      solve_qr_2_flat( this->fs, this->ss,
+                       this->flat.ATL, this->flat.ATR,
+                       this->flat.rt,  this->flat.rb);
+    }
   }    
 
 
@@ -190,7 +190,7 @@ namespace uhm {
   static inline int solve_qr_1_hier( int fs, int ss,
                                      linal::Hier_ ATL, linal::Hier_ ABL, 
                                      linal::Hier_ t,   linal::Hier_ b,
-                                     linal::Hier_ T ) {
+                                     linal::Hier_ T,   int mb ) {
 
     if (fs) {
 
@@ -199,8 +199,6 @@ namespace uhm {
         linal::Flat_ W;
         linal::Hier_ W_1;
         
-        int mb = get_hier_block_size();
-        
         W.create    ( ATL.get_data_type(), mb, mb*t.get_n() );
         W_1.create  ( W, mb, mb );
         
@@ -216,8 +214,6 @@ namespace uhm {
         linal::Flat_ W;
         linal::Hier_ W_1;
         
-        int mb = get_hier_block_size();
-        
         W.create    ( ATL.get_data_type(), T.flat().get_m(), t.flat().get_n() );
         W_1.create  ( W, mb, mb );
         
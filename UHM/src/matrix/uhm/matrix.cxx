@@ -31,6 +31,8 @@
   POSSIBILITY OF SUCH DAMAGE.
 */
 #include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
 #include "uhm/matrix/uhm/matrix.hxx"
 
 namespace uhm {
@@ -38,7 +40,120 @@ namespace uhm {
   // ** Matrix 
   static int     hier_matrix_size  = 256;
 
+  // ** ( ( fs, ss ), block size ) sorted by shape, 0 is flat
+  static std::vector< std::pair< std::pair<int,int>, int > > hier_block_profile;
+
   void set_hier_block_size(int size) { hier_matrix_size = size; }
   int  get_hier_block_size()         { return hier_matrix_size; }
 
+  // --------------------------------------------------------------
+  // ** Flat or hier path per front
+  // The compile flag only chooses the default mode now.
+#ifdef UHM_HIER_MATRIX_ENABLE
+  static int     hier_matrix_mode      = UHM_MATRIX_HIER;
+#else
+  static int     hier_matrix_mode      = UHM_MATRIX_FLAT;
+#endif
+  static int     hier_matrix_threshold = UHM_HIER_MATRIX_THRESHOLD;
+
+  void set_hier_matrix_mode(int mode) { 
+    assert( mode == UHM_MATRIX_FLAT || 
+            mode == UHM_MATRIX_HIER || 
+            mode == UHM_MATRIX_AUTO );
+    hier_matrix_mode = mode; 
+  }
+  int  get_hier_matrix_mode()              { return hier_matrix_mode; }
+
+  void set_hier_matrix_threshold(int size) { hier_matrix_threshold = size; }
+  int  get_hier_matrix_threshold()         { return hier_matrix_threshold; }
+
+  bool is_hier_matrix(int fs, int ss) {
+    switch (hier_matrix_mode) {
+    case UHM_MATRIX_FLAT: return false;
+    case UHM_MATRIX_HIER: return true;
+    }
+    return ( (fs + ss) >= hier_matrix_threshold && 
+             get_hier_block_size(fs, ss) > 0 );
+  }
+
+  // --------------------------------------------------------------
+  // ** Recursive or blocked factorization per front
+  static int     recursive_matrix_threshold = UHM_RECURSIVE_MATRIX_THRESHOLD;
+
+  void set_recursive_matrix_threshold(int size) { 
+    recursive_matrix_threshold = (size > 0 ? size : 0); 
+  }
+  int  get_recursive_matrix_threshold() { return recursive_matrix_threshold; }
+
+  bool is_recursive_matrix(int fs, int ss) {
+    return ( recursive_matrix_threshold > 0 && 
+             fs >= recursive_matrix_threshold );
+  }
+
+  // --------------------------------------------------------------
+  // ** Block size per front
+  // A front takes the entry of the nearest tuned shape, measured as
+  // |fs - fs_i| + |ss - ss_i|; ties go to the smaller shape. Without
+  // a profile the global block size is used.
+  int get_hier_block_size(int fs, int ss) {
+    if (hier_block_profile.empty()) 
+      return hier_matrix_size;
+
+    int i_best = 0, d_best = -1;
+    for (int i=0;i<hier_block_profile.size();++i) {
+      std::pair<int,int> &shape = hier_block_profile[i].first;
+      int d = abs(fs - shape.first) + abs(ss - shape.second);
+      if (d_best < 0 || d < d_best) {
+        d_best = d;
+        i_best = i;
+      }
+    }
+    return hier_block_profile[i_best].second;
+  }
+
+  void set_hier_block_profile(std::vector< std::pair< std::pair<int,int>, int > > &profile) {
+    hier_block_profile = profile;
+    std::sort(hier_block_profile.begin(), hier_block_profile.end());
+  }
+
+  void get_hier_block_profile(std::vector< std::pair< std::pair<int,int>, int > > &profile) {
+    profile = hier_block_profile;
+  }
+
+  void clear_hier_block_profile() { hier_block_profile.clear(); }
+
+  bool export_hier_block_profile(char *full_path) {
+    FILE *fp;
+    if (!open_file(full_path, "w", &fp)) return false;
+
+    fprintf(fp, "# UHM hier block profile : fs, ss, block size (0 is flat)\n");
+    for (int i=0;i<hier_block_profile.size();++i) 
+      fprintf(fp, "%d %d %d\n", 
+              hier_block_profile[i].first.first, 
+              hier_block_profile[i].first.second, 
+              hier_block_profile[i].second);
+
+    return close_file(fp);
+  }
+
+  bool import_hier_block_profile(char *full_path) {
+    FILE *fp;
+    if (!open_file(full_path, "r", &fp)) return false;
+
+    std::vector< std::pair< std::pair<int,int>, int > > profile;
+    char *line;
+    while (read_line(fp, &line)) {
+      int fs, ss, b;
+      if (sscanf(line, "%d %d %d", &fs, &ss, &b) != 3 || 
+          fs < 0 || ss < 0 || b < 0) {
+        fprintf(stderr, "invalid hier block profile : %s\n", full_path);
+        close_file(fp);
+        return false;
+      }
+      profile.push_back(std::make_pair(std::make_pair(fs, ss), b));
+    }
+    set_hier_block_profile(profile);
+
+    return close_file(fp);
+  }
 }
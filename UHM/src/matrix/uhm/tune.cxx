@@ -0,0 +1,128 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+#include "uhm/matrix/uhm/fla.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Block size autotuning
+  // Each ( fs, ss ) front is created as a matrix of the given method
+  // for every candidate block size, block size 0 is the flat front,
+  // and its own factorization is timed, so the partial factorization
+  // and the schur update are measured with the kernels of the method.
+  // The best of n_itr runs decides, so the profile reflects the
+  // thread count in use. Candidates not smaller than the front are
+  // skipped as they are the flat case with task overhead. The global
+  // block size, matrix mode and profile are restored afterwards.
+  static double tune_front( int method, int datatype, int fs, int ss, 
+                            int b, int n_itr ) {
+    set_hier_matrix_mode( b ? UHM_MATRIX_HIER : UHM_MATRIX_FLAT );
+    set_hier_block_size( b );
+
+    Matrix_FLA_ hm( datatype, fs, ss, 1 );
+    hm.create_without_buffer();
+    hm.create_buffer();
+
+    double t_best = 1.0e9;
+    for (int q=0;q<n_itr;++q) {
+      if (method == UHM_CHOL) 
+        hm.random_spd( FLA_LOWER_TRIANGULAR );
+      else
+        hm.random();
+
+      double t_base = timer();
+#pragma omp parallel 
+      {
+#pragma omp single nowait
+        switch (method) {
+        case UHM_CHOL:      hm.chol();      break;
+        case UHM_LU_NOPIV:  hm.lu_nopiv();  break;
+        case UHM_LU_PIV:    hm.lu_piv();    break;
+        case UHM_LU_INCPIV: hm.lu_incpiv(); break;
+        case UHM_QR:        hm.qr();        break;
+        }
+      }
+      t_best = min(t_best, timer() - t_base);
+    }
+    return t_best;
+  }
+
+  void tune_hier_block_size( int method, int datatype, 
+                             std::vector< std::pair<int,int> > &front,
+                             std::vector<int> &block,
+                             int n_itr ) {
+    switch (method) {
+    case UHM_CHOL: case UHM_LU_NOPIV: case UHM_LU_PIV: 
+    case UHM_LU_INCPIV: case UHM_QR: break;
+    default:
+      fprintf(stderr, "tune_hier_block_size: not support method %d\n", method);
+      abort();
+    }
+
+    int mode = get_hier_matrix_mode(), size = get_hier_block_size();
+
+    std::vector< std::pair< std::pair<int,int>, int > > profile, saved;
+    get_hier_block_profile( saved );
+    clear_hier_block_profile();
+
+    for (int i=0;i<front.size();++i) {
+      int fs = front[i].first, ss = front[i].second;
+      if (fs <= 0 || ss < 0) continue;
+
+      int    b_best = 0;
+      double t_best = tune_front( method, datatype, fs, ss, 0, n_itr );
+
+      for (int j=0;j<block.size();++j) {
+        int b = block[j];
+        if (b <= 0 || b >= fs + ss) continue;
+
+        double t = tune_front( method, datatype, fs, ss, b, n_itr );
+        if (t < t_best) { 
+          t_best = t; 
+          b_best = b; 
+        }
+      }
+      profile.push_back( std::make_pair(front[i], b_best) );
+    }
+
+    set_hier_matrix_mode( mode );
+    set_hier_block_size( size );
+
+    // ** a profile tuned on no front keeps the previous one
+    set_hier_block_profile( profile.empty() ? saved : profile );
+  }
+}
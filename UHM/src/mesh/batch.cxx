@@ -0,0 +1,259 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+// ** entry (i,j) of lane l in an interleaved batch of n x n fronts
+#define UHM_BATCH(a,n,i,j,l) (a)[ ((j)*(n)+(i))*UHM_BATCH_WIDTH + (l) ]
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Batched factorization of leaf fronts
+  // Leaves of the same shape are packed UHM_BATCH_WIDTH at a time
+  // into one interleaved front, lane fastest, and factored together.
+  // The first fs columns are eliminated right-looking on the whole
+  // front, which gives ATL, ATR, ABL and the schur update of ABR in
+  // one pass; the innermost loop runs across lanes and vectorizes.
+  // Unused lanes carry an identity front. Pivoting of lu_piv is
+  // restricted to the fs rows as FLA_LU_piv on ATL does, and the
+  // pivots are stored in the relative format of FLA_LU_piv.
+
+  static inline double batch_amax(double v) { return fabs(v); }
+  static inline double batch_amax(std::complex<double> v) { 
+    return fabs(v.real()) + fabs(v.imag()); 
+  }
+
+  template<class T>
+  static void batch_chol( int fs, int n, T *a ) {
+    T inv[UHM_BATCH_WIDTH];
+
+    for (int k=0;k<fs;++k) {
+      T *akk = &UHM_BATCH(a,n,k,k,0);
+      for (int l=0;l<UHM_BATCH_WIDTH;++l) {
+        akk[l] = std::sqrt(akk[l]);
+        inv[l] = T(1)/akk[l];
+      }
+      for (int i=k+1;i<n;++i) {
+        T *aik = &UHM_BATCH(a,n,i,k,0);
+        for (int l=0;l<UHM_BATCH_WIDTH;++l) 
+          aik[l] *= inv[l];
+      }
+      // ** lower triangle only, as syrk on ABR
+      for (int j=k+1;j<n;++j) {
+        T *ajk = &UHM_BATCH(a,n,j,k,0);
+        for (int i=j;i<n;++i) {
+          T *aik = &UHM_BATCH(a,n,i,k,0), *aij = &UHM_BATCH(a,n,i,j,0);
+          for (int l=0;l<UHM_BATCH_WIDTH;++l) 
+            aij[l] -= aik[l]*ajk[l];
+        }
+      }
+    }
+  }
+
+  template<class T>
+  static void batch_lu( int fs, int n, int is_piv, T *a, int *p ) {
+    T inv[UHM_BATCH_WIDTH];
+
+    for (int k=0;k<fs;++k) {
+      if (is_piv) {
+        for (int l=0;l<UHM_BATCH_WIDTH;++l) {
+          int r = k;
+          double v = batch_amax(UHM_BATCH(a,n,k,k,l));
+          for (int i=k+1;i<fs;++i) {
+            double t = batch_amax(UHM_BATCH(a,n,i,k,l));
+            if (t > v) { v = t; r = i; }
+          }
+          p[k*UHM_BATCH_WIDTH+l] = r - k;
+          if (r != k) 
+            for (int j=0;j<n;++j) 
+              std::swap(UHM_BATCH(a,n,k,j,l), UHM_BATCH(a,n,r,j,l));
+        }
+      }
+
+      T *akk = &UHM_BATCH(a,n,k,k,0);
+      for (int l=0;l<UHM_BATCH_WIDTH;++l) 
+        inv[l] = T(1)/akk[l];
+
+      for (int i=k+1;i<n;++i) {
+        T *aik = &UHM_BATCH(a,n,i,k,0);
+        for (int l=0;l<UHM_BATCH_WIDTH;++l) 
+          aik[l] *= inv[l];
+      }
+      for (int j=k+1;j<n;++j) {
+        T *akj = &UHM_BATCH(a,n,k,j,0);
+        for (int i=k+1;i<n;++i) {
+          T *aik = &UHM_BATCH(a,n,i,k,0), *aij = &UHM_BATCH(a,n,i,j,0);
+          for (int l=0;l<UHM_BATCH_WIDTH;++l) 
+            aij[l] -= aik[l]*akj[l];
+        }
+      }
+    }
+  }
+
+  // ** is_in = 0 packs lane l from the matrix, otherwise unpacks
+  template<class T>
+  static void batch_copy( Matrix hm, int fs, int ss, int l, int is_in,
+                          std::vector<T> &tmp, T *a ) {
+    int n = fs + ss;
+    int mat[4]  = { UHM_ATL, UHM_ATR, UHM_ABL, UHM_ABR };
+    int offm[4] = { 0,  0,  fs, fs };
+    int offn[4] = { 0,  fs, 0,  fs };
+    int m_b[4]  = { fs, fs, ss, ss };
+    int n_b[4]  = { fs, ss, fs, ss };
+
+    for (int q=0;q<4;++q) {
+      if (!m_b[q] || !n_b[q]) continue;
+      if (!is_in) hm->copy_out(mat[q], &tmp[0]);
+      for (int j=0;j<n_b[q];++j) 
+        for (int i=0;i<m_b[q];++i) {
+          T &v = UHM_BATCH(a,n,offm[q]+i,offn[q]+j,l);
+          if (is_in) tmp[i+j*m_b[q]] = v;
+          else       v = tmp[i+j*m_b[q]];
+        }
+      if (is_in) hm->copy_in(mat[q], &tmp[0]);
+    }
+  }
+
+  template<class T>
+  static void batch_decompose( int type, std::vector< Element > &batch ) {
+    Matrix hm = batch[0]->get_matrix();
+    int fs = hm->get_dimension().first, ss = hm->get_dimension().second;
+    int n  = fs + ss;
+
+    std::vector< T >   a(n*n*UHM_BATCH_WIDTH, T(0)), tmp(n*n);
+    std::vector< int > p(fs*UHM_BATCH_WIDTH, 0), p_lane(fs);
+
+    for (int l=0;l<UHM_BATCH_WIDTH;++l) {
+      if (l < batch.size()) 
+        batch_copy(batch[l]->get_matrix(), fs, ss, l, false, tmp, &a[0]);
+      else 
+        for (int i=0;i<n;++i) 
+          UHM_BATCH(&a[0],n,i,i,l) = T(1);
+    }
+
+    switch (type) {
+    case UHM_CHOL:     batch_chol(fs, n, &a[0]);                 break;
+    case UHM_LU_NOPIV: batch_lu  (fs, n, false, &a[0], &p[0]);   break;
+    case UHM_LU_PIV:   batch_lu  (fs, n, true,  &a[0], &p[0]);   break;
+    }
+
+    for (int l=0;l<batch.size();++l) {
+      Matrix hm_l = batch[l]->get_matrix();
+      batch_copy(hm_l, fs, ss, l, true, tmp, &a[0]);
+      if (type == UHM_LU_PIV) {
+        for (int k=0;k<fs;++k) 
+          p_lane[k] = p[k*UHM_BATCH_WIDTH+l];
+        hm_l->copy_in(UHM_P, &p_lane[0]);
+      }
+    }
+  }
+
+  void Mesh_::set_leaf_batch(int min_group) { this->leaf_batch = min_group; }
+  int  Mesh_::get_leaf_batch()              { return this->leaf_batch; }
+
+  void Mesh_::_decompose_leaves(int type, std::vector< Element > &batched) {
+    batched.clear();
+
+    if (!this->leaf_batch) return;
+    if (type != UHM_CHOL && type != UHM_LU_NOPIV && type != UHM_LU_PIV) return;
+
+    // ** group leaves by shape, complex chol stays on the front path
+    //    since its trsm/syrk pair is not hermitian
+    std::map< std::pair< int, std::pair<int,int> >, 
+              std::vector< Element > > group;
+    std::map< int, Element_ >::iterator eit;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      if (!e->is_leaf() || e->is_matrix_reusable() || 
+          !e->is_matrix_created()) continue;
+
+      Matrix hm = e->get_matrix();
+      std::pair<int,int> dim = hm->get_dimension();
+      int is_complex = hm->is_complex_datatype();
+      if (!dim.first || (type == UHM_CHOL && is_complex)) continue;
+
+      group[ std::make_pair(is_complex, dim) ].push_back(e);
+    }
+
+    // ** cut groups into batches; buffers are created here as
+    //    buffer accounting is not thread safe
+    std::vector< std::vector< Element > > batch;
+    std::map< std::pair< int, std::pair<int,int> >, 
+              std::vector< Element > >::iterator git;
+    for (git=group.begin();git!=group.end();++git) {
+      std::vector< Element > &g = git->second;
+      if (g.size() < this->leaf_batch) continue;
+
+      for (int i=0;i<g.size();i+=UHM_BATCH_WIDTH) {
+        int end = min(i + UHM_BATCH_WIDTH, (int)g.size());
+        batch.push_back( std::vector< Element >(g.begin()+i, g.begin()+end) );
+      }
+      for (int i=0;i<g.size();++i) {
+        for (int mat=UHM_ATL;mat<UHM_END;++mat) 
+          g[i]->get_matrix()->create_buffer(mat);
+        batched.push_back(g[i]);
+      }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i=0;i<batch.size();++i) {
+      if (batch[i][0]->get_matrix()->is_complex_datatype())
+        batch_decompose< std::complex<double> >(type, batch[i]);
+      else 
+        batch_decompose< double >(type, batch[i]);
+    }
+
+    // ** factored leaves are skipped by the tree pass
+    for (int i=0;i<batched.size();++i) 
+      batched[i]->set_reuse(true);
+  }
+
+  void Mesh_::_release_leaves(std::vector< Element > &batched) {
+    for (int i=0;i<batched.size();++i) 
+      batched[i]->set_reuse(false);
+    batched.clear();
+  }
+}
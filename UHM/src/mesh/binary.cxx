@@ -0,0 +1,424 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+#define UHM_BINARY_FORMAT  "UHMB"
+#define UHM_BINARY_VERSION 1
+
+#define UHM_MATRIX_FORMAT  "UHMX"
+#define UHM_MATRIX_VERSION 1
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Binary mesh
+  // Native int layout, 4 byte aligned :
+  //   "UHMB", version, n_nodes, n_elements, n_refs
+  //   node table    :: n_nodes x ( id, phy, n_dof, p, kind )
+  //   element xadj  :: n_elements + 1
+  //   element nodes :: n_refs, index into the node table
+  // Only leaf elements are written; the tree is rebuilt after import.
+  enum { UHM_BINARY_HEAD=5, UHM_BINARY_NODE=5 };
+
+  bool is_binary_mesh(char *full_path) {
+    FILE *fp;
+    char format[4];
+    bool flag = false;
+
+    fp = fopen(full_path, "rb");
+    if (fp != NULL) {
+      flag = ( fread(format, 1, 4, fp) == 4 &&
+	       !strncmp(UHM_BINARY_FORMAT, format, 4) );
+      fclose(fp);
+    }
+    return flag;
+  }
+
+  bool Mesh_::export_binary(char *full_path) {
+    FILE *fp;
+    std::vector< int > buf;
+
+    std::map< Node, int > index;
+    std::map< std::pair<int,int>, Node_ >::iterator nit;
+    std::map< int, Element_ >::iterator eit;
+
+    int n_nodes = this->nodes.size(), n_elements = 0, n_refs = 0;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      if (eit->second.is_leaf()) {
+	++n_elements;
+	n_refs += eit->second.get_n_nodes();
+      }
+    }
+
+    buf.reserve(UHM_BINARY_HEAD + UHM_BINARY_NODE*n_nodes + 
+		n_elements + 1 + n_refs);
+    buf.resize(UHM_BINARY_HEAD);
+    memcpy(&buf[0], UHM_BINARY_FORMAT, 4);
+    buf[1] = UHM_BINARY_VERSION;
+    buf[2] = n_nodes;
+    buf[3] = n_elements;
+    buf[4] = n_refs;
+
+    // *** node table in the order of node id
+    int i = 0;
+    for (nit=this->nodes.begin();nit!=this->nodes.end();++nit,++i) {
+      Node n = &(nit->second);
+      index[n] = i;
+      buf.push_back(n->get_id().first);
+      buf.push_back(n->get_id().second);
+      buf.push_back(n->get_n_dof());
+      buf.push_back(n->get_p());
+      buf.push_back(n->get_kind());
+    }
+
+    // *** element to node table
+    int offs = 0;
+    buf.push_back(offs);
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      if (eit->second.is_leaf()) {
+	offs += eit->second.get_n_nodes();
+	buf.push_back(offs);
+      }
+    }
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      if (eit->second.is_leaf()) {
+	std::map< Node, int >::iterator it;
+	for (it=eit->second.nodes.begin();it!=eit->second.nodes.end();++it) 
+	  buf.push_back(index[it->first]);
+      }
+    }
+
+    // *** file open BINARY mode
+    assert(open_file(full_path, "wb", &fp));
+    assert(write_buffer_to_file(fp, buf.size()*sizeof(int), (char*)&buf[0]));
+    assert(close_file(fp));
+
+    return true;
+  }
+
+  bool Mesh_::import_binary(char *full_path) {
+    // empty all containers in mesh
+    this->reset();
+
+    size_t size;
+    char *map;
+
+    // *** map the whole file read only
+    assert(map_file(full_path, &size, &map));
+    assert(size >= UHM_BINARY_HEAD*sizeof(int));
+
+    int *head = (int*)map;
+
+    // *** format check
+    if (strncmp(UHM_BINARY_FORMAT, (char*)head, 4) || 
+	head[1] != UHM_BINARY_VERSION) {
+      fprintf(stderr, "mismatch format %s\n", full_path);
+      abort();
+    } 
+
+    int n_nodes = head[2], n_elements = head[3], n_refs = head[4];
+    printf("Reading : n_nodes %d\n", n_nodes);
+    printf("Reading : n_elements %d\n", n_elements);
+
+    assert(size == sizeof(int)*(UHM_BINARY_HEAD + UHM_BINARY_NODE*n_nodes + 
+				n_elements + 1 + n_refs));
+
+    int *node = head + UHM_BINARY_HEAD;
+    int *xadj = node + UHM_BINARY_NODE*n_nodes;
+    int *adjncy = xadj + n_elements + 1;
+
+    // *** nodes :: table is sorted, insert at the end of the map
+    std::vector< Node > index(n_nodes);
+    for (int i=0;i<n_nodes;++i) {
+      int *nod = &node[UHM_BINARY_NODE*i];
+      std::pair<int,int> id(nod[0], nod[1]);
+      std::map< std::pair<int,int>, Node_ >::iterator it;
+
+      it = this->nodes.insert(this->nodes.end(), 
+			      std::make_pair(id, Node_(id, nod[2], nod[3], nod[4])));
+      index[i] = &(it->second);
+    }
+    assert((int)this->nodes.size() == n_nodes);
+
+    // *** elements
+    for (int i=0;i<n_elements;++i) {
+      std::map< int, Element_ >::iterator it;
+      it = this->elements.insert(this->elements.end(), 
+				 std::make_pair(this->id_element, 
+						Element_(this->id_element, 0)));
+      this->id_element++;
+
+      Element e = &(it->second);
+      for (int j=xadj[i];j<xadj[i+1];++j) {
+	assert(adjncy[j] >= 0 && adjncy[j] < n_nodes);
+	e->add_node(index[adjncy[j]]);
+      }
+    }
+
+    // *** unmap
+    assert(unmap_file(size, map));
+
+    return true;
+  }
+
+  // --------------------------------------------------------------
+  // ** Binary leaf matrices
+  // Native layout :
+  //   "UHMX", version, is_complex, n_elts
+  //   per leaf :: id, n_nodes, fs, ss, n_rhs,
+  //               node ids ( factor, schur, then nodes without dof ),
+  //               8 flags for ATL, ATR, ABL, ABR, BT, BB, XT, XB,
+  //               column-major buffer of each flagged block
+  // Every block is written with a single write as in write_to_ooc.
+  enum { UHM_MATRIX_HEAD=4, UHM_MATRIX_LEAF=5, UHM_MATRIX_N_BLOCK=8 };
+
+  static int  g_matrix_block[UHM_MATRIX_N_BLOCK] = 
+    { UHM_ATL, UHM_ATR, UHM_ABL, UHM_ABR, UHM_BT, UHM_BB, UHM_XT, UHM_XB };
+
+  // 0 - A, 1 - B, 2 - X
+  static int  g_matrix_target[UHM_MATRIX_N_BLOCK] = 
+    { 0, 0, 0, 0, 1, 1, 2, 2 };
+
+  // block dimension and offset in the element matrix [ A | B | X ]
+  static void matrix_block(int mat, int fs, int ss, int n_rhs,
+			   int &m, int &n, int &offm, int &offn) {
+    switch (mat) {
+    case UHM_ATL: m=fs; n=fs;    offm=0;  offn=0;  break;
+    case UHM_ATR: m=fs; n=ss;    offm=0;  offn=fs; break;
+    case UHM_ABL: m=ss; n=fs;    offm=fs; offn=0;  break;
+    case UHM_ABR: m=ss; n=ss;    offm=fs; offn=fs; break;
+    case UHM_BT: 
+    case UHM_XT:  m=fs; n=n_rhs; offm=0;  offn=0;  break;
+    case UHM_BB: 
+    case UHM_XB:  m=ss; n=n_rhs; offm=fs; offn=0;  break;
+    }
+  }
+
+  bool Mesh_::export_matrix_binary(char *full_path) {
+    FILE *fp;
+    std::map< int, Element_ >::iterator eit;
+
+    // leaf matrices are overwritten by factors
+    assert(!this->is_decomposed());
+
+    int n_elts = 0, is_complex = 0;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      if (e->is_leaf() && e->is_matrix_created()) {
+	is_complex = e->get_matrix()->is_complex_datatype();
+	++n_elts;
+      }
+    }
+
+    // *** file open BINARY mode
+    assert(open_file(full_path, "wb", &fp));
+
+    int head[UHM_MATRIX_HEAD];
+    memcpy(&head[0], UHM_MATRIX_FORMAT, 4);
+    head[1] = UHM_MATRIX_VERSION;
+    head[2] = is_complex;
+    head[3] = n_elts;
+    assert(write_buffer_to_file(fp, sizeof(head), (char*)head));
+
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      if (!e->is_leaf() || !e->is_matrix_created()) continue;
+
+      Matrix hm = e->get_matrix();
+      std::pair<int,int> dim = hm->get_dimension();
+
+      int leaf[UHM_MATRIX_LEAF] = { e->get_id(), e->get_n_nodes(),
+				    dim.first, dim.second, hm->get_n_rhs() };
+
+      // node order of the element matrix
+      std::vector< int > buf;
+      buf.reserve(2*e->get_n_nodes() + UHM_MATRIX_N_BLOCK);
+      for (int i=0;i<e->factor.size();++i) {
+	buf.push_back(e->factor.at(i).first->get_id().first);
+	buf.push_back(e->factor.at(i).first->get_id().second);
+      }
+      for (int i=0;i<e->schur.size();++i) {
+	buf.push_back(e->schur.at(i).first->get_id().first);
+	buf.push_back(e->schur.at(i).first->get_id().second);
+      }
+      std::map< Node, int >::iterator nit;
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) {
+	if (!nit->first->get_n_dof()) {
+	  buf.push_back(nit->first->get_id().first);
+	  buf.push_back(nit->first->get_id().second);
+	}
+      }
+      assert(buf.size() == 2*e->get_n_nodes());
+
+      for (int i=0;i<UHM_MATRIX_N_BLOCK;++i) 
+	buf.push_back(hm->is_buffer(g_matrix_block[i]));
+
+      assert(write_buffer_to_file(fp, sizeof(leaf), (char*)leaf));
+      assert(write_buffer_to_file(fp, buf.size()*sizeof(int), (char*)&buf[0]));
+
+      for (int i=0;i<UHM_MATRIX_N_BLOCK;++i) 
+	if (hm->is_buffer(g_matrix_block[i]))
+	  assert(hm->write_to_ooc(fp, g_matrix_block[i]));
+    }
+
+    // *** close file
+    assert(close_file(fp));
+
+    return true;
+  }
+
+  bool Mesh_::import_matrix_binary(char *full_path) {
+    FILE *fp;
+    int head[UHM_MATRIX_HEAD];
+
+    // *** file open BINARY mode
+    assert(open_file(full_path, "rb", &fp));
+    assert(read_buffer_from_file(fp, sizeof(head), (char*)head));
+
+    // *** format check
+    if (strncmp(UHM_MATRIX_FORMAT, (char*)head, 4) ||
+	head[1] != UHM_MATRIX_VERSION) {
+      fprintf(stderr, "mismatch format %s\n", full_path);
+      abort();
+    }
+
+    int datatype = (head[2] ? UHM_COMPLEX : UHM_REAL);
+    int n_val    = (head[2] ? 2 : 1);
+    int n_elts   = head[3];
+
+    std::vector< int > buf;
+    std::vector< double > blk, abx[3];
+
+    for (int k=0;k<n_elts;++k) {
+      int leaf[UHM_MATRIX_LEAF];
+      assert(read_buffer_from_file(fp, sizeof(leaf), (char*)leaf));
+
+      int n_nodes = leaf[1], fs = leaf[2], ss = leaf[3], n_rhs = leaf[4];
+      int m = fs + ss;
+
+      Element e = this->find_element(leaf[0]);
+      if (e == nil_element || !e->is_leaf() || 
+	  !e->is_matrix_created() || e->get_n_nodes() != n_nodes) {
+	fprintf(stderr, "mismatch element %d in %s\n", leaf[0], full_path);
+	abort();
+      }
+
+      buf.resize(2*n_nodes + UHM_MATRIX_N_BLOCK);
+      assert(read_buffer_from_file(fp, buf.size()*sizeof(int), (char*)&buf[0]));
+      int *flag = &buf[2*n_nodes];
+
+      // [ A | B | X ] in the node order of the file
+      abx[0].assign(n_val*m*m, 0.0);
+      abx[1].assign(n_val*m*n_rhs, 0.0);
+      abx[2].assign(n_val*m*n_rhs, 0.0);
+
+      for (int i=0;i<UHM_MATRIX_N_BLOCK;++i) {
+	if (!flag[i]) continue;
+
+	int bm, bn, offm, offn;
+	matrix_block(g_matrix_block[i], fs, ss, n_rhs, bm, bn, offm, offn);
+
+	blk.resize(n_val*bm*bn);
+	if (blk.size()) 
+	  assert(read_buffer_from_file(fp, blk.size()*sizeof(double), 
+				       (char*)&blk[0]));
+
+	std::vector< double > &t = abx[g_matrix_target[i]];
+	for (int c=0;c<bn;++c) 
+	  memcpy(&t[n_val*((offn+c)*m + offm)], &blk[n_val*c*bm], 
+		 n_val*bm*sizeof(double));
+      }
+
+      // lhs and rhs are assembled through the user interface
+      if (m && (flag[0] || flag[1] || flag[2] || flag[3]))
+	this->copy_in(e, datatype, m, m, UHM_PHYSICS_MULTI, &buf[0], 
+		      UHM_LHS, &abx[0][0]);
+      if (m && n_rhs && (flag[4] || flag[5]))
+	this->copy_in(e, datatype, m, n_rhs, UHM_PHYSICS_MULTI, &buf[0], 
+		      UHM_RHS, &abx[1][0]);
+
+      // solutions are restored when the node arrangement is the same
+      if (flag[6] || flag[7]) {
+	bool same = (e->factor.size() + e->schur.size() <= n_nodes);
+	for (int i=0;same && i<e->factor.size();++i) 
+	  same = (e->factor.at(i).first->get_id() == 
+		  std::make_pair(buf[2*i], buf[2*i+1]));
+	for (int i=0;same && i<e->schur.size();++i) {
+	  int j = e->factor.size() + i;
+	  same = (e->schur.at(i).first->get_id() == 
+		  std::make_pair(buf[2*j], buf[2*j+1]));
+	}
+
+	if (same) {
+	  Matrix hm = e->get_matrix();
+	  hm->create_buffer(UHM_XT);
+	  hm->create_buffer(UHM_XB);
+	  
+	  // X is stored with leading dimension m, split into XT and XB
+	  for (int i=6;i<UHM_MATRIX_N_BLOCK;++i) {
+	    int bm, bn, offm, offn;
+	    matrix_block(g_matrix_block[i], fs, ss, n_rhs, bm, bn, offm, offn);
+	    if (!bm || !bn) continue;
+
+	    blk.resize(n_val*bm*bn);
+	    for (int c=0;c<bn;++c) 
+	      memcpy(&blk[n_val*c*bm], &abx[2][n_val*(c*m + offm)], 
+		     n_val*bm*sizeof(double));
+	    hm->copy_in(g_matrix_block[i], &blk[0]);
+	  }
+	} else {
+	  fprintf(stderr, "skip solution of element %d, node order differs\n", 
+		  leaf[0]);
+	}
+      }
+    }
+
+    // *** close file
+    assert(close_file(fp));
+
+    return true;
+  }
+}
@@ -49,21 +49,29 @@ namespace uhm {
   void Mesh_::chol_with_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_CHOL, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_chol_with_merge_and_free, true);
 #else
     s->execute_elements_seq(&op_chol_with_merge_and_free, true);
 #endif
+    this->_release_leaves(batched);
   }
 
   void Mesh_::chol_without_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_CHOL, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_chol_with_merge_and_no_free, true);
 #else
     s->execute_elements_seq(&op_chol_with_merge_and_no_free, true);
 #endif
+    this->_release_leaves(batched);
   }
 
   void Mesh_::solve_chol_1() {
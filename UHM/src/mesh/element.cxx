@@ -81,6 +81,12 @@ namespace uhm {
     assert(element_valid(p));
     this->parent = p;
   }
+  void Element_::set_centroid(double x, double y, double z) {
+    this->is_centroid = true;
+    this->centroid[0] = x;
+    this->centroid[1] = y;
+    this->centroid[2] = z;
+  }
 
   int  Element_::get_generation()  { return this->generation; }
   int  Element_::get_height() {
@@ -103,6 +109,23 @@ namespace uhm {
     assert(index>-1 && index<2);
     return this->marker[index];
   }
+  void   Element_::get_centroid(double *xyz) {
+    for (int i=0;i<3;++i) 
+      xyz[i] = this->centroid[i];
+
+    if (this->is_centroid || this->nodes.empty()) return;
+
+    // average of node coordinates
+    std::map< Node, int >::iterator it;
+    for (it=this->nodes.begin();it!=this->nodes.end();++it) {
+      double coord[3];
+      it->first->get_coord(coord);
+      for (int i=0;i<3;++i) 
+	xyz[i] += coord[i];
+    }
+    for (int i=0;i<3;++i) 
+      xyz[i] /= this->nodes.size();
+  }
 
   int  Element_::get_n_children()      { return this->children.size(); }
   int  Element_::get_n_nodes()         { return this->nodes.size(); }
@@ -386,6 +409,7 @@ namespace uhm {
       if (it->second == UHM_SEPARATED_FACTOR) {
 	Node n = it->first;
 	n->set_offset(get_g_offset());
+	n->set_numbered(true);
 	add_g_offset(n->get_n_dof());
       }
     }
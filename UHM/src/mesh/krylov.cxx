@@ -0,0 +1,361 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Krylov solvers
+  // The factorization of this mesh ( possibly stale ) is applied as
+  // the preconditioner through the solve sweeps, and A x is computed
+  // element by element on op, which holds the current leaf matrices
+  // with the same numbering ( e.g. the tree imported by import_tree ).
+  // Vectors are ( n_dof x n_rhs ) column major and every column runs
+  // its own iteration, a column that breaks down stops where it is.
+  // Real datatype only.
+  static double col_dot(int n, int j, 
+                        std::vector<double> &a, 
+                        std::vector<double> &b) {
+    double r_val = 0.0;
+    double *aa = &a[j*n], *bb = &b[j*n];
+#pragma omp parallel for reduction(+:r_val)
+    for (int i=0;i<n;++i) 
+      r_val += aa[i]*bb[i];
+    return r_val;
+  }
+
+  static void col_axpy(int n, int j, double alpha,
+                       std::vector<double> &a, 
+                       std::vector<double> &b) {
+    double *aa = &a[j*n], *bb = &b[j*n];
+#pragma omp parallel for 
+    for (int i=0;i<n;++i) 
+      bb[i] += alpha*aa[i];
+  }
+
+  // ** complex meshes are rejected, vectors hold real values only
+  static void check_real(const char *name, Mesh pre, Mesh op) {
+    Element e = op->get_root();
+    while (!e->is_leaf()) 
+      e = e->get_child(0);
+
+    assert(pre->get_root()->is_matrix_created() && e->is_matrix_created());
+    if (pre->get_root()->get_matrix()->is_complex_datatype() ||
+        e->get_matrix()->is_complex_datatype()) {
+      fprintf(stderr, "%s : complex datatype is not supported\n", name);
+      abort();
+    }
+  }
+
+  static double max_residual(std::vector<double> &res) {
+    double r_val = 0.0;
+    for (int j=0;j<res.size();++j) 
+      r_val = max(r_val, res[j]);
+    return r_val;
+  }
+
+  void Mesh_::_precondition(int method, int n_rhs,
+                            std::vector<double> &r,
+                            std::vector<double> &z) {
+    double t_base = timer();
+    this->solve(method, n_rhs, r, z);
+    this->t_precond += (timer() - t_base);
+  }
+
+  // r = b - A x
+  static void residual(Mesh op, int n_rhs,
+                       std::vector<double> &b,
+                       std::vector<double> &x,
+                       std::vector<double> &r,
+                       double &t_multiply) {
+    double t_base = timer();
+    op->multiply(n_rhs, x, r);
+    t_multiply += (timer() - t_base);
+
+#pragma omp parallel for 
+    for (int i=0;i<r.size();++i) 
+      r[i] = b[i] - r[i];
+  }
+
+  int Mesh_::pcg(Mesh op, int method, int n_rhs,
+                 std::vector<double> &b, std::vector<double> &x,
+                 double tol, int max_iter) {
+    assert(this->is_locked() && op->is_locked());
+    assert(this->get_n_dof() == op->get_n_dof());
+    check_real("pcg", this, op);
+
+    double t_base = timer();
+    this->t_precond  = 0.0;
+    this->t_multiply = 0.0;
+
+    int n = this->get_n_dof(), nn = n*n_rhs;
+    assert(b.size() == nn);
+    if (x.size() != nn) x.assign(nn, 0.0);
+
+    std::vector< double > r(nn), z(nn), p, q(nn);
+    std::vector< double > rz(n_rhs), b_norm(n_rhs), res(n_rhs);
+    std::vector< int > done(n_rhs);
+
+    residual(op, n_rhs, b, x, r, this->t_multiply);
+    this->_precondition(method, n_rhs, r, z);
+    p = z;
+
+    for (int j=0;j<n_rhs;++j) {
+      b_norm[j] = sqrt(col_dot(n, j, b, b));
+      if (b_norm[j] == 0.0) b_norm[j] = 1.0;
+
+      rz[j]   = col_dot(n, j, r, z);
+      res[j]  = sqrt(col_dot(n, j, r, r))/b_norm[j];
+      done[j] = (res[j] < tol);
+    }
+
+    int iter = 0;
+    while (iter < max_iter && 
+           std::count(done.begin(), done.end(), 1) < n_rhs) {
+      double t_tmp = timer();
+      op->multiply(n_rhs, p, q);
+      this->t_multiply += (timer() - t_tmp);
+
+      for (int j=0;j<n_rhs;++j) {
+        if (done[j]) continue;
+
+        // breakdown :: zero or not positive definite ( also nan )
+        double pq = col_dot(n, j, p, q);
+        if (!(pq > 0.0) || !(rz[j] > 0.0)) { 
+          fprintf(stderr, "pcg : breakdown in column %d\n", j);
+          done[j] = 1;
+          continue;
+        }
+        double alpha = rz[j]/pq;
+        col_axpy(n, j,  alpha, p, x);
+        col_axpy(n, j, -alpha, q, r);
+
+        res[j]  = sqrt(col_dot(n, j, r, r))/b_norm[j];
+        done[j] = (res[j] < tol);
+      }
+      ++iter;
+
+      this->_precondition(method, n_rhs, r, z);
+
+      for (int j=0;j<n_rhs;++j) {
+        if (done[j]) continue;
+
+        // the preconditioner is not positive definite
+        double rz_new = col_dot(n, j, r, z);
+        if (!(rz_new > 0.0)) {
+          fprintf(stderr, "pcg : breakdown in column %d\n", j);
+          done[j] = 1;
+          continue;
+        }
+        double beta   = rz_new/rz[j];
+        rz[j] = rz_new;
+
+        // p = z + beta p
+        double *pp = &p[j*n], *zz = &z[j*n];
+#pragma omp parallel for 
+        for (int i=0;i<n;++i)
+          pp[i] = zz[i] + beta*pp[i];
+      }
+    }
+
+    this->krylov_iter     = iter;
+    this->krylov_residual = max_residual(res);
+    this->t_krylov        = timer() - t_base;
+
+    return iter;
+  }
+
+  // ** Restarted GMRES with right preconditioning
+  // Each column keeps its own Hessenberg matrix and Givens rotations
+  // while the basis vectors of all columns are built together, so a
+  // preconditioner apply and a matrix-vector product serve every column.
+  int Mesh_::gmres(Mesh op, int method, int n_rhs,
+                   std::vector<double> &b, std::vector<double> &x,
+                   double tol, int max_iter, int restart) {
+    assert(this->is_locked() && op->is_locked());
+    assert(this->get_n_dof() == op->get_n_dof());
+    assert(restart > 0);
+    check_real("gmres", this, op);
+
+    double t_base = timer();
+    this->t_precond  = 0.0;
+    this->t_multiply = 0.0;
+
+    int n = this->get_n_dof(), nn = n*n_rhs, m = restart;
+    assert(b.size() == nn);
+    if (x.size() != nn) x.assign(nn, 0.0);
+
+    std::vector< std::vector< double > > v(m+1, std::vector< double >(nn));
+    std::vector< double > r(nn), w(nn), z(nn);
+
+    // per column :: hessenberg ( m+1 x m ), rotations and rhs
+    std::vector< double > h(n_rhs*(m+1)*m), cs(n_rhs*m), sn(n_rhs*m), g(n_rhs*(m+1));
+    std::vector< double > b_norm(n_rhs), res(n_rhs);
+    std::vector< int > k(n_rhs), active(n_rhs);
+
+    for (int j=0;j<n_rhs;++j) {
+      b_norm[j] = sqrt(col_dot(n, j, b, b));
+      if (b_norm[j] == 0.0) b_norm[j] = 1.0;
+    }
+
+    residual(op, n_rhs, b, x, r, this->t_multiply);
+    for (int j=0;j<n_rhs;++j)
+      res[j] = sqrt(col_dot(n, j, r, r))/b_norm[j];
+
+    int iter = 0;
+    while (iter < max_iter && max_residual(res) >= tol) {
+      int n_active = 0;
+      for (int j=0;j<n_rhs;++j) {
+        double beta = res[j]*b_norm[j];
+
+        active[j] = (res[j] >= tol);
+        n_active += active[j];
+
+        k[j] = 0;
+        g[j*(m+1)] = beta;
+        for (int i=0;i<n;++i) 
+          v[0][j*n+i] = (active[j] ? r[j*n+i]/beta : 0.0);
+      }
+
+      for (int i=0;i<m && iter<max_iter && n_active;++i,++iter) {
+        double t_tmp;
+        this->_precondition(method, n_rhs, v[i], z);
+
+        t_tmp = timer();
+        op->multiply(n_rhs, z, w);
+        this->t_multiply += (timer() - t_tmp);
+
+        for (int j=0;j<n_rhs;++j) {
+          double *hh = &h[j*(m+1)*m + i*(m+1)];
+          double *c = &cs[j*m], *s = &sn[j*m], *gg = &g[j*(m+1)];
+
+          if (!active[j]) {
+            std::fill(&v[i+1][j*n], &v[i+1][j*n]+n, 0.0);
+            continue;
+          }
+
+          // modified gram-schmidt
+          for (int l=0;l<=i;++l) {
+            hh[l] = col_dot(n, j, w, v[l]);
+            col_axpy(n, j, -hh[l], v[l], w);
+          }
+          hh[i+1] = sqrt(col_dot(n, j, w, w));
+          for (int l=0;l<n;++l)
+            v[i+1][j*n+l] = (hh[i+1] != 0.0 ? w[j*n+l]/hh[i+1] : 0.0);
+
+          int is_lucky = (hh[i+1] == 0.0);
+
+          // previous rotations then the new one
+          for (int l=0;l<i;++l) {
+            double tmp = c[l]*hh[l] + s[l]*hh[l+1];
+            hh[l+1]    = -s[l]*hh[l] + c[l]*hh[l+1];
+            hh[l]      = tmp;
+          }
+          double d = sqrt(hh[i]*hh[i] + hh[i+1]*hh[i+1]);
+          if (d == 0.0) {
+            c[i] = 1.0; s[i] = 0.0;
+          } else {
+            c[i] = hh[i]/d; s[i] = hh[i+1]/d;
+          }
+          hh[i]   = d;
+          hh[i+1] = 0.0;
+
+          gg[i+1] = -s[i]*gg[i];
+          gg[i]   =  c[i]*gg[i];
+
+          k[j]   = i+1;
+          res[j] = fabs(gg[i+1])/b_norm[j];
+
+          if (res[j] < tol || is_lucky) {
+            active[j] = 0;
+            --n_active;
+          }
+        }
+      }
+
+      // x += M^{-1} V y, y solves the triangular hessenberg
+      std::fill(w.begin(), w.end(), 0.0);
+      for (int j=0;j<n_rhs;++j) {
+        std::vector< double > y(k[j]);
+        for (int i=k[j]-1;i>=0;--i) {
+          double sum = g[j*(m+1)+i];
+          for (int l=i+1;l<k[j];++l)
+            sum -= h[j*(m+1)*m + l*(m+1) + i]*y[l];
+          double diag = h[j*(m+1)*m + i*(m+1) + i];
+          y[i] = (diag != 0.0 ? sum/diag : 0.0);
+        }
+        for (int i=0;i<k[j];++i)
+          col_axpy(n, j, y[i], v[i], w);
+      }
+      this->_precondition(method, n_rhs, w, z);
+
+#pragma omp parallel for 
+      for (int i=0;i<nn;++i) 
+        x[i] += z[i];
+
+      // true residual for the restart
+      residual(op, n_rhs, b, x, r, this->t_multiply);
+      for (int j=0;j<n_rhs;++j)
+        res[j] = sqrt(col_dot(n, j, r, r))/b_norm[j];
+    }
+
+    this->krylov_iter     = iter;
+    this->krylov_residual = max_residual(res);
+    this->t_krylov        = timer() - t_base;
+
+    return iter;
+  }
+
+  void Mesh_::get_krylov_stat(int &n_iter, double &residual,
+                              double &t_total, double &t_precond,
+                              double &t_multiply) {
+    n_iter     = this->krylov_iter;
+    residual   = this->krylov_residual;
+    t_total    = this->t_krylov;
+    t_precond  = this->t_precond;
+    t_multiply = this->t_multiply;
+  }
+}
@@ -54,22 +54,28 @@ namespace uhm {
   void Mesh_::lu_nopiv_with_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
-    
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_LU_NOPIV, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_nopiv_with_merge_and_free, true);
 #else
     s->execute_elements_seq(&op_lu_nopiv_with_merge_and_free, true);
 #endif
+    this->_release_leaves(batched);
   }
   void Mesh_::lu_nopiv_without_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
-    
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_LU_NOPIV, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_nopiv_with_merge_and_no_free, true);
 #else
     s->execute_elements_seq(&op_lu_nopiv_with_merge_and_no_free, true);
 #endif
+    this->_release_leaves(batched);
   }
 
   void Mesh_::solve_lu_nopiv_1() {
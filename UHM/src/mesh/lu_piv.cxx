@@ -54,26 +54,35 @@ namespace uhm {
   void Mesh_::lu_piv_with_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_LU_PIV, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_piv_with_merge_and_free, true);
 #else
     s->execute_elements_seq(&op_lu_piv_with_merge_and_free, true);
 #endif
+    this->_release_leaves(batched);
   }
 
   void Mesh_::lu_piv_without_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
+    std::vector< Element > batched;
+    this->_decompose_leaves(UHM_LU_PIV, batched);
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_piv_with_merge_and_no_free, true);
 #else
     s->execute_elements_seq(&op_lu_piv_with_merge_and_no_free, true);
 #endif
+    this->_release_leaves(batched);
   }
 
   void Mesh_::lu_piv_with_ooc() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_piv_with_merge_and_ooc, true);
 #else
@@ -84,6 +93,7 @@ namespace uhm {
   void Mesh_::lu_incpiv_with_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
 
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_incpiv_with_merge_and_free, true);
@@ -95,6 +105,7 @@ namespace uhm {
   void Mesh_::lu_incpiv_without_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
 
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_lu_incpiv_with_merge_and_no_free, true);
@@ -63,12 +63,14 @@ namespace uhm {
 
   void Mesh_::create_matrix_without_buffer(int datatype, int n_rhs) {
     std::map< int, Element_ >::iterator it;
+    int is_reused = false;
       
     for (it=this->elements.begin();it!=this->elements.end();++it) {
       Element e = &(it->second);
         
       if (e->is_matrix_reusable()) {
         assert(e->is_matrix_created()); 
+        is_reused = true;
       } else {
         // create matrix
         // if the matrix is not reusable, which means connectivity is 
@@ -87,6 +89,9 @@ namespace uhm {
         e->set_matrix(hm);
       }
     }
+
+    // reused matrices keep their factors
+    if (!is_reused) this->decomposed = false;
   }
 
   void Mesh_::create_leaf_matrix_buffer() {
@@ -139,6 +144,7 @@ namespace uhm {
         e->set_matrix(nil_matrix);
       }
     }
+    this->decomposed = false;
   }
 
   void Mesh_::free_matrix_buffer() {
@@ -37,6 +37,7 @@
 #include "uhm/object.hxx"
 
 #include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/mesh.hxx"
 #include "uhm/operation/element.hxx"
 
 #include "uhm/mesh/node.hxx"
@@ -50,6 +51,9 @@
 
 
 namespace uhm {
+  // ** numbering version, unique over meshes
+  static int g_numbering = 0;
+
   // --------------------------------------------------------------
   // ** Callable from C
   //void mesh_new   ( Mesh &m ) { m = new Mesh_; }
@@ -232,6 +236,11 @@ namespace uhm {
 
     this->id_element = 0;
 
+    this->updated.clear();
+    this->vanished.clear();
+    this->offset_end = 0;
+    this->decomposed = false;
+
     //     if (this->comm != MPI_COMM_NULL)
     //       MPI_Comm_free(&this->comm);
     //     this->comm = MPI_COMM_NULL;
@@ -245,8 +254,9 @@ namespace uhm {
   void Mesh_::remove_all_nodes()    { this->nodes.clear(); }
   void Mesh_::remove_orphan_nodes() { 
     std::map< std::pair<int,int>, Node_ >::iterator it;
-    for (it=this->nodes.begin();it!=this->nodes.end();it++) {
-      if (!(it->second.get_n_owner())) this->nodes.erase(it);
+    for (it=this->nodes.begin();it!=this->nodes.end();) {
+      if (!(it->second.get_n_owner())) this->nodes.erase(it++);
+      else ++it;
     }
   }
   void Mesh_::remove_all_elements() { this->elements.clear(); }
@@ -416,6 +426,7 @@ namespace uhm {
 	e->add_child(c);
       }
     }
+    this->updated.insert(e->get_id());
 
     return e;
   }
@@ -427,10 +438,24 @@ namespace uhm {
     for (int i=0;i<e->get_n_children();i++) {
       Element c;
       c = e->get_child(i);
-      if (c->is_leaf()) this->unrefine_element(c->get_id());
+      if (!c->is_leaf()) this->unrefine_element(c->get_id());
+
+      // nodes eliminated below e are gone with the children
+      std::map< Node, int >::iterator nit;
+      for (nit=c->nodes.begin();nit!=c->nodes.end();++nit) {
+	Node n = nit->first;
+	if (e->nodes.find(n) != e->nodes.end()) continue;
+	if (n->is_numbered()) {
+	  this->vanished.push_back(std::make_pair(n->get_offset(), 
+						  n->get_n_dof()));
+	  n->set_numbered(false);
+	}
+	n->reset_owner();
+      }
       this->remove_element(c->get_id());
     }
     e->reset_children();
+    this->updated.insert(e->get_id());
 
     return e;
   }
@@ -445,9 +470,17 @@ namespace uhm {
     s->execute_leaves_seq(&op_restore_connectivity);
     s->execute_elements_seq(&op_update_connectivity, true);
 
+    std::map< std::pair<int,int>, Node_ >::iterator it;
+    for (it=this->nodes.begin();it!=this->nodes.end();++it) 
+      it->second.set_numbered(false);
+
     reset_g_offset();
     s->execute_elements_seq(&op_numbering, true);
 
+    this->offset_end = get_g_offset();
+    this->updated.clear();
+    this->vanished.clear();
+
     // arrange is not working
     s->execute_elements_seq(&op_arrange_nodes, true);
     
@@ -455,12 +488,195 @@ namespace uhm {
     this->locker = true;
   }
 
+  // ** lock after refine_element / unrefine_element
+  // Only the subtree of each updated element and its ancestors are 
+  // rebuilt ( update_tree ), separated, numbered and arranged again. 
+  // Nodes keep their offsets and new nodes are appended, so untouched
+  // elements keep their arrangement and pass check_reuse. Offsets of 
+  // vanished nodes are closed by shifting the later offsets.
+  void Mesh_::relock() {
+    // ** nothing is numbered yet
+    if (!this->offset_end) {
+      this->lock();
+      return;
+    }
+
+    this->unlock();
+
+    { // ** outermost updated elements, the others are in their subtree
+      std::vector< Element > top;
+      std::set< int >::iterator it;
+      for (it=this->updated.begin();it!=this->updated.end();++it) {
+	Element e = this->find_element(*it), p;
+	if (e == nil_element) continue;
+
+	for (p=e->get_parent();p!=nil_element;p=p->get_parent())
+	  if (this->updated.count(p->get_id())) break;
+
+	if (p == nil_element) top.push_back(e);
+      }
+      this->updated.clear();
+
+      for (int i=0;i<top.size();++i) 
+	this->_relock(top.at(i));
+    }
+
+    if (this->vanished.size()) { // ** close the gaps
+      std::sort(this->vanished.begin(), this->vanished.end());
+
+      std::vector< int > shift(this->vanished.size()+1, 0);
+      for (int i=0;i<this->vanished.size();++i) 
+	shift.at(i+1) = shift.at(i) + this->vanished.at(i).second;
+
+      std::map< std::pair<int,int>, Node_ >::iterator it;
+      for (it=this->nodes.begin();it!=this->nodes.end();++it) {
+	Node n = &(it->second);
+	if (!n->is_numbered()) continue;
+
+	int k = ( std::lower_bound(this->vanished.begin(), 
+				   this->vanished.end(),
+				   std::make_pair(n->get_offset(), -1)) - 
+		  this->vanished.begin() );
+	n->set_offset(n->get_offset() - shift.at(k));
+      }
+      this->offset_end -= shift.back();
+      this->vanished.clear();
+    }
+
+    this->get_scheduler()->load(this);
+
+    this->locker = true;
+  }
+
+  void Mesh_::_relock(Element e) {
+    std::vector< Element > sub, anc;
+    std::set< Node > prev, touched;
+
+    for (Element p=e->get_parent();p!=nil_element;p=p->get_parent()) 
+      anc.push_back(p);
+
+    { // ** nodes of the region before the update
+      sub.push_back(e);
+      for (int i=0;i<sub.size();++i) 
+	for (int j=0;j<sub.at(i)->get_n_children();++j) 
+	  sub.push_back(sub.at(i)->get_child(j));
+
+      std::map< Node, int >::iterator nit;
+      for (int i=0;i<sub.size();++i) 
+	for (nit=sub.at(i)->nodes.begin();nit!=sub.at(i)->nodes.end();++nit) 
+	  prev.insert(nit->first);
+      for (int i=0;i<anc.size();++i) 
+	for (nit=anc.at(i)->nodes.begin();nit!=anc.at(i)->nodes.end();++nit) 
+	  prev.insert(nit->first);
+    }
+
+    // interface of e has to stay in the refined leaves
+    std::vector< Node > interface;
+    {
+      std::map< Node, int >::iterator nit;
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit)
+	if (nit->second == UHM_SEPARATED_SCHUR)
+	  interface.push_back(nit->first);
+    }
+
+    update_tree(this, e);
+
+    { // ** new subtree, children come before their parent
+      sub.clear();
+      sub.push_back(e);
+      for (int i=0;i<sub.size();++i) 
+	for (int j=0;j<sub.at(i)->get_n_children();++j) 
+	  sub.push_back(sub.at(i)->get_child(j));
+      std::reverse(sub.begin(), sub.end());
+    }
+
+    { // ** owners :: leaves of the subtree and the other children of 
+      //    the ancestors, which hold their separated schur nodes
+      std::map< Node, int >::iterator nit;
+      for (int i=0;i<sub.size();++i) 
+	if (sub.at(i)->is_leaf()) 
+	  for (nit=sub.at(i)->nodes.begin();nit!=sub.at(i)->nodes.end();++nit) 
+	    touched.insert(nit->first);
+
+      for (int i=0;i<interface.size();++i) 
+	assert(touched.count(interface.at(i)));
+
+      touched.insert(prev.begin(), prev.end());
+
+      std::set< Node >::iterator tit;
+      for (tit=touched.begin();tit!=touched.end();++tit) 
+	(*tit)->reset_owner();
+
+      for (int i=0;i<sub.size();++i) 
+	if (sub.at(i)->is_leaf()) {
+	  for (nit=sub.at(i)->nodes.begin();nit!=sub.at(i)->nodes.end();++nit) {
+	    nit->second = UHM_NOT_SEPARATED;
+	    nit->first->add_owner(sub.at(i));
+	  }
+	  sub.at(i)->reset_factor();
+	  sub.at(i)->reset_schur();
+	}
+
+      Element c = e;
+      for (int i=0;i<anc.size();++i) {
+	for (int j=0;j<anc.at(i)->get_n_children();++j) {
+	  Element s = anc.at(i)->get_child(j);
+	  if (s == c) continue;
+	  for (nit=s->nodes.begin();nit!=s->nodes.end();++nit) 
+	    if (nit->second == UHM_SEPARATED_SCHUR)
+	      nit->first->add_owner(s);
+	}
+	c = anc.at(i);
+      }
+    }
+
+    // ** region in the elimination order
+    sub.insert(sub.end(), anc.begin(), anc.end());
+
+    for (int i=0;i<sub.size();++i) 
+      op_update_connectivity(sub.at(i));
+
+    { // ** numbering :: new nodes are appended
+      std::set< Node > factor;
+      std::map< Node, int >::iterator nit;
+      for (int i=0;i<sub.size();++i) 
+	for (nit=sub.at(i)->nodes.begin();nit!=sub.at(i)->nodes.end();++nit) {
+	  if (nit->second != UHM_SEPARATED_FACTOR) continue;
+
+	  Node n = nit->first;
+	  if (!n->is_numbered()) {
+	    n->set_offset(this->offset_end);
+	    n->set_numbered(true);
+	    this->offset_end += n->get_n_dof();
+	  }
+	  factor.insert(n);
+	}
+
+      std::set< Node >::iterator pit;
+      for (pit=prev.begin();pit!=prev.end();++pit) {
+	Node n = *pit;
+	if (n->is_numbered() && !factor.count(n)) {
+	  this->vanished.push_back(std::make_pair(n->get_offset(), 
+						  n->get_n_dof()));
+	  n->set_numbered(false);
+	}
+      }
+    }
+
+    for (int i=0;i<sub.size();++i) 
+      op_arrange_nodes(sub.at(i));
+  }
+
   void Mesh_::unlock() { 
     this->get_scheduler()->unload();
+    this->colors.clear();
     this->locker = false;
+    this->numbering = ++g_numbering;
   }
   
   int  Mesh_::is_locked() { return this->locker; }
+  int  Mesh_::is_decomposed() { return this->decomposed; }
+  int  Mesh_::get_numbering_version() { return this->numbering; }
 
   bool Mesh_::disp() { return this->disp(stdout); }
   bool Mesh_::disp(int mode) { return this->disp(stdout, mode); }
@@ -508,20 +724,81 @@ namespace uhm {
     return true;
   }
 
+  // --------------------------------------------------------------
+  // ** ASCII parser
+  // Lines follow read_line : leading white spaces are skipped, blank
+  // lines and lines starting with '#' are ignored. Each line is parsed
+  // into at most UHM_ASCII_MAX_INT integers stored in CSR form; the
+  // rest of the line from the first non-integer token is ignored.
+#define UHM_ASCII_MAX_INT 5
+
+  static inline char* skip_line(char *c, char *end) {
+    while (c < end && *c != '\n') ++c;
+    return (c < end ? c+1 : end);
+  }
+
+  // move to the beginning of the line containing c
+  static inline char* align_line(char *c, char *begin, char *end) {
+    if (c == begin || c == end || *(c-1) == '\n') return c;
+    return skip_line(c, end);
+  }
+
+  static void parse_lines(char *c, char *end,
+			  std::vector< int > &xval,
+			  std::vector< int > &val) {
+    while (c < end) {
+      while (c < end && *c <= ' ') ++c;
+      if (c == end) break;
+      if (*c == '#') { c = skip_line(c, end); continue; }
+
+      xval.push_back(val.size());
+
+      // ** as sscanf "%d %d ..." : stop at the first non-integer token
+      for (int n=0;n<UHM_ASCII_MAX_INT;++n) {
+	while (c < end && *c != '\n' && *c <= ' ') ++c;
+
+	int sign = 1;
+	char *d = c;
+	if (d < end && (*d == '-' || *d == '+')) 
+	  sign = (*d++ == '-' ? -1 : 1);
+	if (d == end || *d < '0' || *d > '9') 
+	  break;
+
+	int v = 0;
+	while (d < end && *d >= '0' && *d <= '9') 
+	  v = v*10 + (*d++ - '0');
+	val.push_back(sign*v);
+	c = d;
+      }
+      c = skip_line(c, end);
+    }
+  }
+
   bool Mesh_::import_file(char *full_path) {
+    // binary format is loaded through mmap
+    if (is_binary_mesh(full_path)) 
+      return this->import_binary(full_path);
+
     // empty all containers in mesh
     this->reset();
     
-    FILE *fp;
-    char format[32], *line;
+    size_t size;
+    char *buf, *c, *end, format[32];
     int i, j, n_nodes, n_elements;
 
-    // *** file open ASCII mode 
-    assert(open_file(full_path, "r", &fp));
-    assert(read_line(fp, &line));
-    sscanf(line, "%s", format);
-    
-    // *** format check
+    // *** map the whole file
+    assert(map_file(full_path, &size, &buf));
+    c   = buf;
+    end = buf + size;
+
+    // *** format check :: the first line
+    while (c < end && (*c <= ' ' || *c == '#')) 
+      c = (*c == '#' ? skip_line(c, end) : c+1);
+    for (i=0;i<31 && c+i < end && c[i] > ' ';++i) 
+      format[i] = c[i];
+    format[i] = '\0';
+    c = skip_line(c, end);
+
     if (strcmp("UHM", format)) {
       fprintf(stderr, "mismatch format %s\n", format);
       abort();
@@ -529,52 +806,124 @@ namespace uhm {
       printf("format %s\n", format);
     }
 
+    // *** parse byte ranges aligned to lines
+    int nt = max(get_num_threads(), 1);
+    std::vector< std::vector< int > > xvals(nt), vals(nt);
+    std::vector< int > xval, val;
+    {
+      size_t length = end - c;
+
+#pragma omp parallel for schedule(static, 1)
+      for (int t=0;t<nt;++t) {
+	char *b = align_line(c + length*t/nt,     c, end);
+	char *e = align_line(c + length*(t+1)/nt, c, end);
+	parse_lines(b, e, xvals[t], vals[t]);
+      }
+
+      // merge chunks into one line table
+      std::vector< int > line_offs(nt+1, 0), val_offs(nt+1, 0);
+      for (int t=0;t<nt;++t) {
+	line_offs[t+1] = line_offs[t] + xvals[t].size();
+	val_offs[t+1]  = val_offs[t]  + vals[t].size();
+      }
+      xval.resize(line_offs[nt]+1);
+      val.resize(val_offs[nt]);
+      xval[line_offs[nt]] = val_offs[nt];
+
+#pragma omp parallel for schedule(static, 1)
+      for (int t=0;t<nt;++t) {
+	for (int k=0;k<xvals[t].size();++k) 
+	  xval[line_offs[t]+k] = xvals[t][k] + val_offs[t];
+	std::copy(vals[t].begin(), vals[t].end(), val.begin()+val_offs[t]);
+
+	std::vector< int >().swap(xvals[t]);
+	std::vector< int >().swap(vals[t]);
+      }
+    }
+
+    // *** unmap, parsed values are in the line table
+    assert(unmap_file(size, buf));
+
+    int n_lines = xval.size() - 1, l = 0;
+#define UHM_ASCII_LINE(l, n)						\
+    if ((l) >= n_lines || xval[(l)+1] - xval[(l)] < (n)) {		\
+      fprintf(stderr, "fail to read line %d of %s\n", (l), full_path); \
+      abort();								\
+    }
+
     // *** read nodes
-    assert(read_line(fp, &line));
-    sscanf(line, "%d", &n_nodes);
+    UHM_ASCII_LINE(l, 1);
+    n_nodes = val[xval[l++]];
     printf("Reading : n_nodes %d\n", n_nodes);
 
-    for (i=0;i<n_nodes;i++) {
-      int id, phy, ndof, p, kind;
-      assert(read_line(fp, &line));
-      sscanf(line, "%d %d %d %d %d", 
-	     &id, &phy, &ndof, &p, &kind);
-      this->add_node(std::pair<int,int>(id, phy), ndof, p, kind);
+    for (i=0;i<n_nodes;i++,l++) {
+      UHM_ASCII_LINE(l, 5);
+      int *v = &val[xval[l]];
+      this->add_node(std::pair<int,int>(v[0], v[1]), v[2], v[3], v[4]);
     }
 
     // *** read elements
-    assert(read_line(fp, &line));
-    sscanf(line, "%d", &n_elements);
+    UHM_ASCII_LINE(l, 1);
+    n_elements = val[xval[l++]];
     printf("Reading : n_elements %d\n", n_elements);
 
+    // element to node references, line of the first node per element
+    std::vector< int > xref(n_elements+1), first(n_elements);
+    xref[0] = 0;
     for (i=0;i<n_elements;i++) {
-      int n_nods;
+      UHM_ASCII_LINE(l, 1);
+      int n_nods = val[xval[l++]];
+      first[i]  = l;
+      xref[i+1] = xref[i] + n_nods;
+      l += n_nods;
+    }
+    if (l > n_lines) {
+      fprintf(stderr, "fail to read elements of %s\n", full_path);
+      abort();
+    }
 
-      assert(read_line(fp, &line));
-      sscanf(line, "%d", &n_nods);
+    // find nodes in parallel, the node map is not modified here
+    std::vector< Node > ref(xref[n_elements]);
+    int n_fail = 0;
 
-      Element e = this->add_element();
-      for (j=0;j<n_nods;j++) {
-	int id, phy;
-
-	assert(read_line(fp, &line));
-	sscanf(line, "%d %d", &id, &phy);
-	Node n = this->find_node(std::pair<int,int>(id, phy));
-	if (n != nil_node) {
-	  e->add_node(n);
-	} else { 
-	  fprintf(stderr, "failt to find node [ %d , %d ]\n", id, phy);
-	  abort();
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:n_fail)
+    for (int k=0;k<n_elements;k++) {
+      for (int r=xref[k];r<xref[k+1];r++) {
+	int ll = first[k] + r - xref[k];
+	if (xval[ll+1] - xval[ll] < 2) {
+	  ref[r] = nil_node; ++n_fail;
+	} else {
+	  int *v = &val[xval[ll]];
+	  ref[r] = this->find_node(std::pair<int,int>(v[0], v[1]));
+	  if (ref[r] == nil_node) ++n_fail;
 	}
       }
     }
 
+    if (n_fail) {
+      for (i=0;i<n_elements;i++) {
+	for (j=xref[i];j<xref[i+1];j++) {
+	  if (ref[j] == nil_node) {
+	    int ll = first[i] + j - xref[i];
+	    fprintf(stderr, "fail to find node at line %d\n", ll);
+	  }
+	}
+      }
+      abort();
+    }
+
+    // owners of nodes are shared, elements are connected in order
+    for (i=0;i<n_elements;i++) {
+      Element e = this->add_element();
+      for (j=xref[i];j<xref[i+1];j++) 
+	e->add_node(ref[j]);
+    }
+
+#undef UHM_ASCII_LINE
+
     // *** clean up orphans
     this->remove_orphan_nodes();
 
-    // *** close file
-    assert(close_file(fp));
-
     return true;
   }
 
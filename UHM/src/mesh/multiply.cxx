@@ -0,0 +1,162 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Element-by-element matrix-vector product
+  // Leaf matrices are applied to the gathered vector with dense gemm
+  // and scattered back to the global vector. Leaves of a color do not
+  // share nodes, so a color is scattered in parallel without atomics.
+  // The product uses leaf matrices as they are; call it before the
+  // factorization overwrites them.
+  void Mesh_::_color_leaves() {
+    this->colors.clear();
+
+    // colors already given to leaves around a node
+    std::map< Node, std::vector< int > > used;
+    std::vector< int > mark;
+    int stamp = 0;
+
+    std::map< int, Element_ >::iterator eit;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      if (!e->is_leaf()) continue;
+
+      ++stamp;
+
+      std::map< Node, int >::iterator nit;
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) {
+        std::vector< int > &c = used[nit->first];
+        for (int i=0;i<c.size();++i)
+          mark[c[i]] = stamp;
+      }
+
+      // smallest color not used by the neighbors
+      int color = 0;
+      while (color < mark.size() && mark[color] == stamp) 
+        ++color;
+
+      if (color == this->colors.size()) {
+        this->colors.push_back( std::vector< Element >() );
+        mark.push_back(0);
+      }
+      this->colors[color].push_back(e);
+
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) 
+        used[nit->first].push_back(color);
+    }
+  }
+
+  bool Mesh_::multiply(int n_rhs, 
+                       std::vector<double> &x, 
+                       std::vector<double> &y) {
+    assert(this->is_locked());
+
+    if (this->colors.empty())
+      this->_color_leaves();
+
+    if (this->colors.empty()) return false;
+
+    int n_dof = this->get_n_dof();
+    int n_val = (this->colors[0][0]->get_matrix()->is_complex_datatype() ? 2 : 1);
+
+    assert(x.size() == n_dof*n_rhs*n_val);
+
+    y.resize(x.size());
+    std::fill(y.begin(), y.end(), 0.0);
+
+    for (int c=0;c<this->colors.size();++c) {
+      std::vector< Element > &leaves = this->colors[c];
+      int n_leaves = leaves.size();
+
+#pragma omp parallel 
+      {
+        std::vector< int > idx;
+        std::vector< double > x_loc, y_loc;
+
+#pragma omp for schedule(dynamic)
+        for (int k=0;k<n_leaves;++k) {
+          Element e = leaves[k];
+
+          // local numbering :: factor nodes then schur nodes
+          idx.clear();
+          for (int i=0;i<e->factor.size();++i) {
+            Node n = e->factor[i].first;
+            for (int l=0;l<n->get_n_dof();++l)
+              idx.push_back(n->get_offset()+l);
+          }
+          for (int i=0;i<e->schur.size();++i) {
+            Node n = e->schur[i].first;
+            for (int l=0;l<n->get_n_dof();++l)
+              idx.push_back(n->get_offset()+l);
+          }
+
+          int m = idx.size();
+          if (!m) continue;
+
+          x_loc.resize(m*n_rhs*n_val);
+          y_loc.resize(m*n_rhs*n_val);
+          std::fill(y_loc.begin(), y_loc.end(), 0.0);
+
+          for (int j=0;j<n_rhs;++j)
+            for (int i=0;i<m;++i)
+              for (int l=0;l<n_val;++l)
+                x_loc[(i+j*m)*n_val+l] = x[(idx[i]+j*n_dof)*n_val+l];
+
+          e->get_matrix()->multiply(n_rhs, &x_loc[0], &y_loc[0]);
+
+          for (int j=0;j<n_rhs;++j)
+            for (int i=0;i<m;++i)
+              for (int l=0;l<n_val;++l)
+                y[(idx[i]+j*n_dof)*n_val+l] += y_loc[(i+j*m)*n_val+l];
+        }
+      }
+    }
+    return true;
+  }
+}
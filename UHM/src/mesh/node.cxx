@@ -57,6 +57,12 @@ namespace uhm {
   void Node_::set_p       (int p)      { this->p = p; }
   void Node_::set_offset  (int offset) { this->offset = offset; }
   void Node_::set_marker  (int marker) { this->marker = marker; }
+  void Node_::set_numbered(int flag)   { this->numbered = flag; }
+  void Node_::set_coord   (double x, double y, double z) { 
+    this->coord[0] = x;
+    this->coord[1] = y;
+    this->coord[2] = z;
+  }
 
   int  Node_::get_kind()   { return this->kind; }
   int  Node_::get_n_dof()  { return this->n_dof; }
@@ -64,6 +70,11 @@ namespace uhm {
   int  Node_::get_n_owner(){ return this->owner.size(); }
   int  Node_::get_offset() { return this->offset; }
   int  Node_::get_marker() { return this->marker; }
+  int  Node_::is_numbered(){ return this->numbered; }
+  void Node_::get_coord(double *xyz) { 
+    for (int i=0;i<3;++i) 
+      xyz[i] = this->coord[i];
+  }
 
   bool Node_::is_owned_by(Element e) {
     assert(element_valid(e));
@@ -100,8 +111,9 @@ namespace uhm {
     std::set< Element >::iterator it;
 #pragma omp critical
     {
-      for (it=this->owner.begin();it!=this->owner.end();++it) 
-	if (!(*it)->is_leaf()) this->owner.erase(it);
+      for (it=this->owner.begin();it!=this->owner.end();) 
+	if (!(*it)->is_leaf()) this->owner.erase(it++);
+	else ++it;
     }
   }
 
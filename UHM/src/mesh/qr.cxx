@@ -54,6 +54,7 @@ namespace uhm {
   void Mesh_::qr_with_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
     
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_qr_with_merge_and_free, true);
@@ -64,6 +65,7 @@ namespace uhm {
   void Mesh_::qr_without_free() {
     assert(this->get_scheduler()->is_loaded());
     Scheduler s = this->get_scheduler();
+    this->decomposed = true;
     
 #ifdef UHM_MULTITHREADING_ENABLE
     s->execute_tree(&op_qr_with_merge_and_no_free, true);
@@ -0,0 +1,295 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Streamed solve
+  // Global rhs of any width is pushed through the factorization in
+  // blocks of the n_rhs given to create_matrix_without_buffer. The
+  // same x buffers of elements are reused by every block and sweeps
+  // run as trsm/gemm on the block. Rhs blocks of the elements are
+  // not touched.
+
+  // leaf part of b; a dof is given to the first leaf having it
+  static void leaf_rhs(std::vector< std::pair<Node,int> > &nodes,
+                       int m, int n_dof, int n_rhs, int n_val,
+                       std::vector<double> &b,
+                       std::vector<char> &is_given,
+                       std::vector<double> &buf) {
+    buf.assign(m*n_rhs*n_val, 0.0);
+    int i = 0;
+    for (int k=0;k<nodes.size();++k) {
+      int offs = nodes[k].first->get_offset();
+      for (int l=0;l<nodes[k].first->get_n_dof();++l,++i) {
+        if (is_given[offs+l]) continue;
+        for (int j=0;j<n_rhs;++j)
+          for (int v=0;v<n_val;++v)
+            buf[(i+j*m)*n_val+v] = b[(offs+l+j*n_dof)*n_val+v];
+        is_given[offs+l] = 1;
+      }
+    }
+  }
+
+  void Mesh_::_solve_block(int method, 
+                           std::vector<double> &b,
+                           std::vector<double> &x) {
+    int n_dof = this->get_n_dof(), n_rhs = 0, n_val = 1;
+
+    std::vector< char > is_given(n_dof, 0);
+    std::vector< double > buf;
+
+    // b goes to x of leaves, upper levels are cleared
+    std::map< int, Element_ >::iterator eit;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      assert(e->is_matrix_created());
+
+      Matrix hm = e->get_matrix();
+      n_rhs = hm->get_n_rhs();
+      n_val = (hm->is_complex_datatype() ? 2 : 1);
+      
+      if (!e->is_leaf()) {
+        hm->set_rhs(false);
+        continue;
+      }
+
+      std::pair<int,int> n_dof_e = e->get_n_dof();
+      if (n_dof_e.first) {
+        leaf_rhs(e->factor, n_dof_e.first, n_dof, n_rhs, n_val, 
+                 b, is_given, buf);
+        hm->copy_in(UHM_XT, &buf[0]);
+      }
+      if (n_dof_e.second) {
+        leaf_rhs(e->schur, n_dof_e.second, n_dof, n_rhs, n_val, 
+                 b, is_given, buf);
+        hm->copy_in(UHM_XB, &buf[0]);
+      }
+    }
+
+    assert(b.size() == n_dof*n_rhs*n_val);
+
+    switch (method) {
+    case UHM_CHOL:      this->solve_chol();     break;
+    case UHM_LU_NOPIV:  this->solve_lu_nopiv(); break;
+    case UHM_LU_INCPIV:
+    case UHM_LU_PIV:    this->solve_lu_piv();   break;
+    case UHM_QR:        this->solve_qr();       break;
+    default:
+      fprintf(stderr, "solve: not support method %d\n", method);
+      abort();
+    }
+
+    // the solution of a node lives in the element factoring it
+    x.resize(n_dof*n_rhs*n_val);
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      int m = e->get_n_dof().first;
+      if (!m) continue;
+
+      buf.resize(m*n_rhs*n_val);
+      e->get_matrix()->copy_out(UHM_XT, &buf[0]);
+
+      int i = 0;
+      for (int k=0;k<e->factor.size();++k) {
+        int offs = e->factor[k].first->get_offset();
+        for (int l=0;l<e->factor[k].first->get_n_dof();++l,++i) 
+          for (int j=0;j<n_rhs;++j)
+            for (int v=0;v<n_val;++v)
+              x[(offs+l+j*n_dof)*n_val+v] = buf[(i+j*m)*n_val+v];
+      }
+    }
+  }
+
+  bool Mesh_::solve(int method, int n_rhs,
+                    std::vector<double> &b,
+                    std::vector<double> &x) {
+    assert(this->is_locked());
+
+    Element root = this->get_root();
+    assert(root->is_matrix_created());
+
+    int n_dof = this->get_n_dof();
+    int n_blk = root->get_matrix()->get_n_rhs();
+    int n_val = (root->get_matrix()->is_complex_datatype() ? 2 : 1);
+    int ld    = n_dof*n_val;
+
+    assert(n_blk > 0);
+    assert(b.size() == ld*n_rhs);
+
+    x.resize(b.size());
+
+    // one block straight
+    if (n_rhs == n_blk) {
+      this->_solve_block(method, b, x);
+      return true;
+    }
+
+    std::vector< double > b_blk(ld*n_blk), x_blk;
+    for (int j=0;j<n_rhs;j+=n_blk) {
+      int n = min(n_blk, n_rhs - j);
+
+      // the last block is padded with zero columns
+      std::copy(b.begin() + j*ld, b.begin() + (j+n)*ld, b_blk.begin());
+      std::fill(b_blk.begin() + n*ld, b_blk.end(), 0.0);
+
+      this->_solve_block(method, b_blk, x_blk);
+
+      std::copy(x_blk.begin(), x_blk.begin() + n*ld, x.begin() + j*ld);
+    }
+    return true;
+  }
+
+  // --------------------------------------------------------------
+  // ** Selective solve
+  // Rhs is nonzero only on the given leaves and the solution is only
+  // wanted on the given elements. The forward sweep runs on the root
+  // paths of the rhs leaves and the backward sweep on the root paths
+  // of the output elements. Other elements are not visited, except
+  // that x is cleared for children merged by the forward path and for
+  // elements only on the backward path. Solution of an output element
+  // is found in its xt and xb.
+  static void root_path(std::vector< Element > &elts,
+                        std::map< int, std::vector< Element > > &level,
+                        std::set< Element > &path) {
+    for (int i=0;i<elts.size();++i) 
+      for (Element e=elts[i];e!=nil_element;e=e->get_parent()) {
+        if (!path.insert(e).second) break;
+        level[e->get_generation()].push_back(e);
+      }
+  }
+
+  static void execute_level(std::vector< Element > &elts,
+                            bool (*op_func)(Element)) {
+    int n_elts = elts.size();
+#pragma omp parallel for schedule(dynamic)
+    for (int i=0;i<n_elts;++i) 
+      assert(op_func(elts[i]));
+  }
+
+  bool Mesh_::solve_selective(int method,
+                              std::vector< Element > &rhs,
+                              std::vector< Element > &out) {
+    assert(this->is_locked());
+
+    bool (*op_1)(Element), (*op_2)(Element);
+    switch (method) {
+    case UHM_CHOL:
+      op_1 = &op_solve_chol_1_x_with_merge;
+      op_2 = &op_solve_chol_2_x_with_branch;
+      break;
+    case UHM_LU_NOPIV:
+      op_1 = &op_solve_lu_nopiv_1_x_with_merge;
+      op_2 = &op_solve_lu_nopiv_2_x_with_branch;
+      break;
+    case UHM_LU_INCPIV:
+    case UHM_LU_PIV:
+      op_1 = &op_solve_lu_piv_1_x_with_merge;
+      op_2 = &op_solve_lu_piv_2_x_with_branch;
+      break;
+    case UHM_QR:
+      op_1 = &op_solve_qr_1_x_with_merge;
+      op_2 = &op_solve_qr_2_x_with_branch;
+      break;
+    default:
+      fprintf(stderr, "solve_selective: not support method %d\n", method);
+      abort();
+    }
+
+    std::map< int, std::vector< Element > > level_1, level_2;
+    std::set< Element > path_1, path_2;
+
+    root_path(rhs, level_1, path_1);
+    root_path(out, level_2, path_2);
+
+    // prepare x on the forward path and zero x of the children merged
+    std::set< Element >::iterator it;
+    for (it=path_1.begin();it!=path_1.end();++it) {
+      Element e = *it;
+      assert(e->is_matrix_created());
+      e->get_matrix()->set_rhs(e->is_leaf());
+
+      for (int i=0;i<e->get_n_children();++i) {
+        Element c = e->get_child(i);
+        if (path_1.count(c)) continue;
+
+        std::pair<int,int> n_dof = c->get_n_dof();
+        if (n_dof.first)  c->get_matrix()->set_zero(UHM_XT);
+        if (n_dof.second) c->get_matrix()->set_zero(UHM_XB);
+      }
+    }
+
+    // without rhs the solution is zero 
+    if (path_1.empty()) {
+      for (int i=0;i<out.size();++i) {
+        std::pair<int,int> n_dof = out[i]->get_n_dof();
+        if (n_dof.first)  out[i]->get_matrix()->set_zero(UHM_XT);
+        if (n_dof.second) out[i]->get_matrix()->set_zero(UHM_XB);
+      }
+      return true;
+    }
+
+    // forward result is zero off the forward path
+    for (it=path_2.begin();it!=path_2.end();++it) {
+      Element e = *it;
+      if (path_1.count(e) || !e->get_n_dof().first) continue;
+      e->get_matrix()->set_zero(UHM_XT);
+    }
+
+    // leaf to root
+    std::map< int, std::vector< Element > >::reverse_iterator rit;
+    for (rit=level_1.rbegin();rit!=level_1.rend();++rit) 
+      execute_level(rit->second, op_1);
+
+    // root to leaf
+    std::map< int, std::vector< Element > >::iterator lit;
+    for (lit=level_2.begin();lit!=level_2.end();++lit) 
+      execute_level(lit->second, op_2);
+
+    return true;
+  }
+}
@@ -0,0 +1,309 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+#define UHM_TREE_FORMAT  "UHMT"
+#define UHM_TREE_VERSION 1
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Tree snapshot
+  // Binary file of the locked state : node offsets, tree links and
+  // separated nodes of every element with factor/schur offsets.
+  // Leaves are identified by the connectivity hash of the mesh, so
+  // the snapshot is only loaded onto the mesh it was taken from.
+  static void write_int(FILE *fp, int val) {
+    assert(write_buffer_to_file(fp, sizeof(int), (char*)&val));
+  }
+  static int read_int(FILE *fp) {
+    int val;
+    assert(read_buffer_from_file(fp, sizeof(int), (char*)&val));
+    return val;
+  }
+  static void hash_int(unsigned long long &hash, int val) {
+    // FNV-1a
+    unsigned char *c = (unsigned char*)&val;
+    for (int i=0;i<(int)sizeof(int);++i) {
+      hash ^= c[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  // nodes of a leaf are keyed by pointer, so they are hashed in the 
+  // order of node id to give the same value across loaders and runs
+  unsigned long long Mesh_::get_connectivity_hash() {
+    unsigned long long hash = 14695981039346656037ULL;
+
+    std::vector< std::pair< std::pair<int,int>, Node > > leaf;
+
+    std::map< int, Element_ >::iterator eit;
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+      if (!e->is_leaf()) continue;
+
+      hash_int(hash, e->get_id());
+      hash_int(hash, e->get_n_nodes());
+
+      leaf.clear();
+      std::map< Node, int >::iterator nit;
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) 
+	leaf.push_back(std::make_pair(nit->first->get_id(), nit->first));
+      std::sort(leaf.begin(), leaf.end());
+
+      for (int i=0;i<leaf.size();++i) {
+	Node n = leaf.at(i).second;
+	hash_int(hash, n->get_id().first);
+	hash_int(hash, n->get_id().second);
+	hash_int(hash, n->get_n_dof());
+	hash_int(hash, n->get_p());
+	hash_int(hash, n->get_kind());
+      }
+    }
+    return hash;
+  }
+
+  bool Mesh_::export_tree(char *full_path) {
+    assert(this->is_locked());
+
+    FILE *fp;
+    unsigned long long hash = this->get_connectivity_hash();
+
+    // *** file open BINARY mode
+    assert(open_file(full_path, "wb", &fp));
+    assert(write_buffer_to_file(fp, 4, (char*)UHM_TREE_FORMAT));
+    write_int(fp, UHM_TREE_VERSION);
+    assert(write_buffer_to_file(fp, sizeof(hash), (char*)&hash));
+
+    // *** nodes :: index in the node container
+    std::map< Node, int > index;
+    {
+      std::map< std::pair<int,int>, Node_ >::iterator it;
+      int i = 0;
+      write_int(fp, this->nodes.size());
+      for (it=this->nodes.begin();it!=this->nodes.end();++it,++i) {
+	Node n = &(it->second);
+	index[n] = i;
+	write_int(fp, n->get_offset());
+	write_int(fp, n->is_numbered());
+      }
+    }
+
+    // *** elements
+    std::map< int, Element_ >::iterator eit;
+    write_int(fp, this->elements.size());
+    write_int(fp, this->id_element);
+    for (eit=this->elements.begin();eit!=this->elements.end();++eit) {
+      Element e = &(eit->second);
+
+      write_int(fp, e->get_id());
+      write_int(fp, e->get_generation());
+
+      write_int(fp, e->get_n_children());
+      for (int i=0;i<e->get_n_children();++i) 
+	write_int(fp, e->get_child(i)->get_id());
+
+      std::map< Node, int >::iterator nit;
+      write_int(fp, e->nodes.size());
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) {
+	write_int(fp, index[nit->first]);
+	write_int(fp, nit->second);
+      }
+
+      std::vector< std::pair<Node,int> >::iterator fit;
+      write_int(fp, e->factor.size());
+      for (fit=e->factor.begin();fit!=e->factor.end();++fit) {
+	write_int(fp, index[fit->first]);
+	write_int(fp, fit->second);
+      }
+      write_int(fp, e->schur.size());
+      for (fit=e->schur.begin();fit!=e->schur.end();++fit) {
+	write_int(fp, index[fit->first]);
+	write_int(fp, fit->second);
+      }
+    }
+
+    // *** close file
+    assert(close_file(fp));
+
+    return true;
+  }
+
+  bool Mesh_::import_tree(char *full_path) {
+    FILE *fp;
+    char format[4];
+    unsigned long long hash;
+
+    // *** no snapshot, caller builds the tree
+    if (!is_file(full_path)) return false;
+
+    // *** file open BINARY mode
+    assert(open_file(full_path, "rb", &fp));
+    assert(read_buffer_from_file(fp, 4, format));
+    
+    // *** format check
+    if (strncmp(UHM_TREE_FORMAT, format, 4) || 
+	read_int(fp) != UHM_TREE_VERSION) {
+      fprintf(stderr, "mismatch format %s\n", full_path);
+      assert(close_file(fp));
+      return false;
+    }
+
+    // *** connectivity check
+    assert(read_buffer_from_file(fp, sizeof(hash), (char*)&hash));
+    if (hash != this->get_connectivity_hash() ||
+	read_int(fp) != (int)this->nodes.size()) {
+      assert(close_file(fp));
+      return false;
+    }
+
+    this->unlock();
+
+    // *** nodes
+    std::vector< Node > index;
+    {
+      std::map< std::pair<int,int>, Node_ >::iterator it;
+      index.reserve(this->nodes.size());
+      this->offset_end = 0;
+      for (it=this->nodes.begin();it!=this->nodes.end();++it) {
+	Node n = &(it->second);
+	n->set_offset(read_int(fp));
+	n->set_numbered(read_int(fp));
+	n->reset_owner();
+	if (n->is_numbered()) 
+	  this->offset_end = max(this->offset_end, 
+				 n->get_offset() + n->get_n_dof());
+	index.push_back(n);
+      }
+      this->updated.clear();
+      this->vanished.clear();
+    }
+
+    // *** remove the previous tree, leaves are kept
+    std::map< int, Element_ >::iterator eit;
+    for (eit=this->elements.begin();eit!=this->elements.end();) {
+      if (eit->second.is_leaf()) {
+	eit->second.reset_parent();
+	++eit;
+      } else {
+	this->elements.erase(eit++);
+      }
+    }
+
+    // *** elements
+    int n_elements = read_int(fp);
+    this->id_element = read_int(fp);
+
+    std::vector< std::pair<Element, std::vector<int> > > tree(n_elements);
+
+    for (int i=0;i<n_elements;++i) {
+      int id = read_int(fp);
+      Element e = this->find_element(id);
+      if (e == nil_element) 
+	e = this->insert_element(id);
+
+      e->generation = read_int(fp);
+
+      // children are linked after all elements are created
+      int n_children = read_int(fp);
+      tree.at(i).first = e;
+      for (int j=0;j<n_children;++j) 
+	tree.at(i).second.push_back(read_int(fp));
+
+      e->reset_nodes();
+      e->reset_factor();
+      e->reset_schur();
+
+      int n_nodes = read_int(fp);
+      for (int j=0;j<n_nodes;++j) {
+	Node n = index.at(read_int(fp));
+	e->nodes[n] = read_int(fp);
+      }
+
+      int n_factor = read_int(fp);
+      for (int j=0;j<n_factor;++j) {
+	Node n = index.at(read_int(fp));
+	e->add_factor(n, read_int(fp));
+      }
+
+      int n_schur = read_int(fp);
+      for (int j=0;j<n_schur;++j) {
+	Node n = index.at(read_int(fp));
+	e->add_schur(n, read_int(fp));
+      }
+    }
+
+    // *** close file
+    assert(close_file(fp));
+
+    // *** tree links in the stored order of children
+    for (int i=0;i<n_elements;++i) {
+      Element p = tree.at(i).first;
+      for (int j=0;j<tree.at(i).second.size();++j) {
+	Element c = this->find_element(tree.at(i).second.at(j));
+	assert(c != nil_element);
+	c->set_parent(p);
+	p->add_child(c);
+      }
+    }
+
+    // *** owners as left by merge_nodes : schur nodes move to the parent
+    for (int i=0;i<n_elements;++i) {
+      Element e = tree.at(i).first;
+      std::map< Node, int >::iterator nit;
+      for (nit=e->nodes.begin();nit!=e->nodes.end();++nit) 
+	if (nit->second != UHM_SEPARATED_SCHUR || 
+	    e->get_parent() == nil_element)
+	  nit->first->add_owner(e);
+    }
+
+    // *** locked
+    this->get_scheduler()->load(this);
+    this->locker = true;
+
+    return true;
+  }
+}
@@ -0,0 +1,442 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/operation/graph.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** Multilevel graph bisection
+  // This replaces METIS internals used in build_tree_var_3 and 4.
+  // 1. coarsen by heavy edge matching until the graph is small
+  // 2. bisect the coarsest graph by greedy growing with a few trials
+  // 3. project back and refine with FM on each level
+  typedef std::priority_queue< std::pair<int,int> > Queue;
+
+  static int  _rand(unsigned int *seed) { return rand_r(seed); }
+
+  static void _coarsen(Graph_ &g, Graph_ &cg, std::vector< int > &cmap,
+		       int maxvwgt, unsigned int *seed);
+  static int  _grow   (Graph_ &g, int tpw0, std::vector< int > &where,
+		       unsigned int *seed);
+  static int  _refine (Graph_ &g, int tpw[2], std::vector< int > &where);
+
+  // --------------------------------------------------------------
+  // ** Graph member
+  int Graph_::get_total_weight() {
+    int r_val = 0;
+    for (int i=0;i<this->vwgt.size();++i) 
+      r_val += this->vwgt[i];
+    return r_val;
+  }
+  int Graph_::get_max_weight() {
+    int r_val = 0;
+    for (int i=0;i<this->vwgt.size();++i) 
+      r_val = max(r_val, this->vwgt[i]);
+    return r_val;
+  }
+
+  // --------------------------------------------------------------
+  // ** Bisection
+  int graph_bisection(Graph g, std::vector< int > &where) {
+    int n = g->get_n_vertices(), tvwgt = g->get_total_weight(), tpw[2];
+    unsigned int seed = (unsigned int)n;
+
+    tpw[0] = tvwgt/2;
+    tpw[1] = tvwgt - tpw[0];
+
+    where.assign(n, 0);
+    if (n < 2) return 0;
+
+    // ** coarsening phase :: level 0 is the input graph
+    std::vector< Graph_ > level(1);
+    std::vector< std::vector< int > > cmap;
+
+    int maxvwgt = max(1, (int)(1.5*tvwgt/UHM_BISECTION_COARSEN_TO));
+
+    Graph_ *fine = g;
+    while (fine->get_n_vertices() > UHM_BISECTION_COARSEN_TO) {
+      Graph_ coarse;
+      std::vector< int > map;
+
+      _coarsen(*fine, coarse, map, maxvwgt, &seed);
+
+      // stop when matching does not reduce the graph
+      if (coarse.get_n_vertices() > 0.9*fine->get_n_vertices()) 
+	break;
+
+      level.push_back(Graph_());
+      std::swap(level.back().xadj,   coarse.xadj);
+      std::swap(level.back().adjncy, coarse.adjncy);
+      std::swap(level.back().adjwgt, coarse.adjwgt);
+      std::swap(level.back().vwgt,   coarse.vwgt);
+
+      cmap.push_back(std::vector< int >());
+      std::swap(cmap.back(), map);
+
+      fine = &level.back();
+    }
+
+    // ** initial bisection :: keep the best among trials
+    std::vector< int > cwhere, trial;
+    int cut = -1;
+    int n_trials = (n > UHM_BISECTION_COARSEN_TO ? UHM_BISECTION_N_TRIALS : 1);
+    for (int k=0;k<n_trials;++k) {
+      _grow(*fine, tpw[0], trial, &seed);
+      int tcut = _refine(*fine, tpw, trial);
+      if (cut < 0 || tcut < cut) {
+	cut = tcut;
+	std::swap(cwhere, trial);
+      }
+    }
+
+    // ** uncoarsening phase
+    for (int l=cmap.size();l>0;--l) {
+      Graph_ &g_fine = (l > 1 ? level[l-1] : *g);
+      std::vector< int > fwhere( g_fine.get_n_vertices() );
+      
+      for (int i=0;i<fwhere.size();++i)
+	fwhere[i] = cwhere[ cmap[l-1][i] ];
+
+      // release the coarse level
+      level[l].reset();
+      std::vector< int >().swap(cmap[l-1]);
+
+      cut = _refine(g_fine, tpw, fwhere);
+      std::swap(cwhere, fwhere);
+    }
+    std::swap(where, cwhere);
+
+    // ** both parts should not be empty
+    int pw0 = 0;
+    for (int i=0;i<n;++i) 
+      pw0 += (where[i] == 0 ? g->vwgt[i] : 0);
+    
+    if (pw0 == 0 || pw0 == tvwgt) {
+      int side = (pw0 == 0);
+      where[0] = (side ? 0 : 1);
+    }
+
+    return cut;
+  }
+
+  // --------------------------------------------------------------
+  // ** Split the graph according to bisection
+  bool graph_split(Graph g, std::vector< int > &where, 
+		   Graph g0, Graph g1) {
+    int n = g->get_n_vertices(), cnt[2] = { 0, 0 };
+    Graph sub[2] = { g0, g1 };
+    std::vector< int > local(n);
+
+    for (int i=0;i<n;++i) 
+      local[i] = cnt[ where[i] ]++;
+
+    for (int k=0;k<2;++k) {
+      sub[k]->reset();
+      sub[k]->xadj.reserve( cnt[k]+1 );
+      sub[k]->vwgt.reserve( cnt[k] );
+      sub[k]->label.reserve( cnt[k] );
+      sub[k]->xadj.push_back( 0 );
+    }
+
+    for (int i=0;i<n;++i) {
+      Graph s = sub[ where[i] ];
+      s->vwgt.push_back ( g->vwgt[i] );
+      s->label.push_back( g->label[i] );
+      for (int j=g->xadj[i];j<g->xadj[i+1];++j) {
+	int nb = g->adjncy[j];
+	if (where[nb] == where[i]) {
+	  s->adjncy.push_back( local[nb] );
+	  s->adjwgt.push_back( g->adjwgt[j] );
+	}
+      }
+      s->xadj.push_back( s->adjncy.size() );
+    }
+    return true;
+  }
+
+  // --------------------------------------------------------------
+  // ** Heavy edge matching
+  void _coarsen(Graph_ &g, Graph_ &cg, std::vector< int > &cmap,
+		int maxvwgt, unsigned int *seed) {
+    int n = g.get_n_vertices(), cn = 0;
+    std::vector< int > match(n, -1), perm(n), rep;
+
+    for (int i=0;i<n;++i) 
+      perm[i] = i;
+    for (int i=n-1;i>0;--i)
+      std::swap(perm[i], perm[ _rand(seed)%(i+1) ]);
+
+    cmap.assign(n, -1);
+    rep.reserve(n);
+
+    for (int k=0;k<n;++k) {
+      int u = perm[k], v = u, w = -1;
+      if (match[u] != -1) continue;
+
+      // the heaviest edge to an unmatched neighbor
+      for (int j=g.xadj[u];j<g.xadj[u+1];++j) {
+	int nb = g.adjncy[j];
+	if (match[nb] == -1 && nb != u && g.adjwgt[j] > w &&
+	    g.vwgt[u] + g.vwgt[nb] <= maxvwgt) {
+	  v = nb;
+	  w = g.adjwgt[j];
+	}
+      }
+      match[u] = v;  match[v] = u;
+      cmap[u]  = cn; cmap[v]  = cn;
+      rep.push_back(u);
+      ++cn;
+    }
+
+    // contract the matched pairs
+    std::vector< int > htable(cn, -1);
+
+    cg.reset();
+    cg.xadj.reserve( cn+1 );
+    cg.vwgt.assign( cn, 0 );
+    cg.adjncy.reserve( g.adjncy.size() );
+    cg.adjwgt.reserve( g.adjwgt.size() );
+    cg.xadj.push_back( 0 );
+
+    for (int c=0;c<cn;++c) {
+      int u[2] = { rep[c], match[ rep[c] ] };
+      int begin = cg.adjncy.size();
+
+      for (int k=0;k<(u[0] == u[1] ? 1 : 2);++k) {
+	cg.vwgt[c] += g.vwgt[ u[k] ];
+	for (int j=g.xadj[ u[k] ];j<g.xadj[ u[k]+1 ];++j) {
+	  int cnb = cmap[ g.adjncy[j] ];
+	  if (cnb == c) continue;
+	  if (htable[cnb] == -1) {
+	    htable[cnb] = cg.adjncy.size();
+	    cg.adjncy.push_back( cnb );
+	    cg.adjwgt.push_back( g.adjwgt[j] );
+	  } else {
+	    cg.adjwgt[ htable[cnb] ] += g.adjwgt[j];
+	  }
+	}
+      }
+      for (int j=begin;j<cg.adjncy.size();++j) 
+	htable[ cg.adjncy[j] ] = -1;
+
+      cg.xadj.push_back( cg.adjncy.size() );
+    }
+  }
+
+  // --------------------------------------------------------------
+  // ** Greedy graph growing 
+  // Part 0 grows from a random seed taking the vertex with the largest
+  // gain until it reaches its target weight.
+  int _grow(Graph_ &g, int tpw0, std::vector< int > &where,
+	    unsigned int *seed) {
+    int n = g.get_n_vertices(), pw0 = 0, n_moved = 0;
+    std::vector< int > gain(n, 0);
+    Queue q;
+
+    where.assign(n, 1);
+    for (int i=0;i<n;++i) 
+      for (int j=g.xadj[i];j<g.xadj[i+1];++j) 
+	gain[i] -= g.adjwgt[j];
+
+    while (pw0 < tpw0 && n_moved < n-1) {
+      int v = -1;
+
+      // pick the best vertex on the front
+      while (!q.empty()) {
+	std::pair<int,int> top = q.top(); q.pop();
+	if (where[top.second] == 1 && gain[top.second] == top.first) {
+	  v = top.second;
+	  break;
+	}
+      }
+
+      // new component :: random vertex in part 1
+      if (v < 0) {
+	v = _rand(seed)%n;
+	while (where[v] != 1) v = (v+1)%n;
+
+	// start from a pseudo peripheral vertex, the last one in BFS
+	if (!n_moved) {
+	  std::vector< int > bfs(1, v), visit(n, 0);
+	  visit[v] = 1;
+	  for (int k=0;k<bfs.size();++k) 
+	    for (int j=g.xadj[ bfs[k] ];j<g.xadj[ bfs[k]+1 ];++j) 
+	      if (!visit[ g.adjncy[j] ]) {
+		visit[ g.adjncy[j] ] = 1;
+		bfs.push_back( g.adjncy[j] );
+	      }
+	  v = bfs.back();
+	}
+      }
+
+      // do not overshoot more than undershoot
+      if (pw0 && pw0 + g.vwgt[v] - tpw0 > tpw0 - pw0) 
+	break;
+
+      where[v] = 0;
+      pw0 += g.vwgt[v];
+      ++n_moved;
+
+      for (int j=g.xadj[v];j<g.xadj[v+1];++j) {
+	int nb = g.adjncy[j];
+	if (where[nb] == 1) {
+	  gain[nb] += 2*g.adjwgt[j];
+	  q.push( std::make_pair(gain[nb], nb) );
+	}
+      }
+    }
+    return pw0;
+  }
+
+  // --------------------------------------------------------------
+  // ** Fiduccia-Mattheyses refinement
+  // Vertex moves are taken from priority queues of both parts with lazy
+  // deletion. Balance violation is reduced first, then the edge cut. 
+  // Moves after the best state are rolled back at the end of a pass.
+  static inline void _move(Graph_ &g, int v, std::vector< int > &where, 
+			   std::vector< int > &id, std::vector< int > &ed, 
+			   int pw[2]) {
+    int from = where[v], to = 1 - from;
+
+    where[v] = to;
+    pw[from] -= g.vwgt[v];
+    pw[to]   += g.vwgt[v];
+    std::swap(id[v], ed[v]);
+
+    for (int j=g.xadj[v];j<g.xadj[v+1];++j) {
+      int nb = g.adjncy[j], w = g.adjwgt[j];
+      if (where[nb] == to) {
+	id[nb] += w;  ed[nb] -= w;
+      } else {
+	id[nb] -= w;  ed[nb] += w;
+      }
+    }
+  }
+
+  int _refine(Graph_ &g, int tpw[2], std::vector< int > &where) {
+    int n = g.get_n_vertices(), cut = 0, pw[2] = { 0, 0 }, maxpw[2];
+    int maxv = g.get_max_weight();
+    std::vector< int > id(n, 0), ed(n, 0), locked(n), moves;
+
+    for (int k=0;k<2;++k) 
+      maxpw[k] = max((int)(UHM_BISECTION_UBFACTOR*tpw[k]), tpw[k] + maxv);
+
+    for (int i=0;i<n;++i) {
+      pw[ where[i] ] += g.vwgt[i];
+      for (int j=g.xadj[i];j<g.xadj[i+1];++j) {
+	if (where[ g.adjncy[j] ] == where[i]) id[i] += g.adjwgt[j];
+	else                                  ed[i] += g.adjwgt[j];
+      }
+      cut += ed[i];
+    }
+    cut /= 2;
+
+    int limit = max(25, min(n/20, 1000));
+
+    for (int pass=0;pass<UHM_BISECTION_N_PASSES;++pass) {
+      Queue q[2];
+      for (int i=0;i<n;++i) {
+	locked[i] = 0;
+	if (ed[i] > 0 || pw[ where[i] ] > maxpw[ where[i] ]) 
+	  q[ where[i] ].push( std::make_pair(ed[i]-id[i], i) );
+      }
+      moves.clear();
+
+      int curr = cut, best_cut = cut, best = 0;
+      int best_bal = ( max(0, pw[0]-maxpw[0]) + max(0, pw[1]-maxpw[1]) );
+      
+      while (true) {
+	int cand[2] = { -1, -1 };
+
+	// valid top of each queue
+	for (int k=0;k<2;++k) {
+	  while (!q[k].empty()) {
+	    std::pair<int,int> top = q[k].top();
+	    int v = top.second;
+	    if (!locked[v] && where[v] == k && ed[v]-id[v] == top.first) {
+	      if (pw[1-k] + g.vwgt[v] <= maxpw[1-k] || pw[k] > maxpw[k]) 
+		cand[k] = v;
+	      else 
+		q[k].pop();
+	      break;
+	    }
+	    q[k].pop();
+	  }
+	}
+
+	int from;
+	if      (pw[0] > maxpw[0] && cand[0] >= 0) from = 0;
+	else if (pw[1] > maxpw[1] && cand[1] >= 0) from = 1;
+	else if (cand[0] >= 0 && cand[1] >= 0) 
+	  from = ( ed[cand[0]]-id[cand[0]] >= ed[cand[1]]-id[cand[1]] ? 0 : 1 );
+	else if (cand[0] >= 0) from = 0;
+	else if (cand[1] >= 0) from = 1;
+	else break;
+
+	int v = cand[from];
+	q[from].pop();
+
+	curr -= (ed[v] - id[v]);
+	_move(g, v, where, id, ed, pw);
+	locked[v] = 1;
+	moves.push_back(v);
+
+	for (int j=g.xadj[v];j<g.xadj[v+1];++j) {
+	  int nb = g.adjncy[j];
+	  if (!locked[nb]) 
+	    q[ where[nb] ].push( std::make_pair(ed[nb]-id[nb], nb) );
+	}
+
+	int bal = ( max(0, pw[0]-maxpw[0]) + max(0, pw[1]-maxpw[1]) );
+	if (bal < best_bal || (bal == best_bal && curr < best_cut)) {
+	  best_bal = bal;
+	  best_cut = curr;
+	  best     = moves.size();
+	} else if ((int)moves.size() - best > limit) {
+	  break;
+	}
+      }
+
+      // roll back to the best state
+      for (int k=moves.size()-1;k>=best;--k)
+	_move(g, moves[k], where, id, ed, pw);
+
+      cut = best_cut;
+      if (best == 0) break;
+    }
+    return cut;
+  }
+}
@@ -50,6 +50,9 @@
 namespace uhm {
   // --------------------------------------------------------------
   // ** coarsening 
+  // var 6 does not need METIS internals, but its tree quality has not
+  // been compared with var 4 on the benchmark meshes yet; until then 
+  // var 4 stays the default and METIS stays a build dependency
   bool build_tree(Mesh m) {
     return build_tree_var_4(m);
   }
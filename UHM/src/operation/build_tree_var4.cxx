@@ -69,10 +69,24 @@ namespace uhm {
   static bool build_tree_var_4_internal(std::vector< Element > *orphan,
 					Mesh m, Element parent, int is_parallel,
 					CtrlType *ctrl, GraphType *graph);
+  bool build_tree_var_4_weighted(Mesh m, int is_weighted,
+				 int decomposition, int datatype, int n_rhs);
   
   // --------------------------------------------------------------
   // ** coarsening 
   bool build_tree_var_4(Mesh m) {
+    return build_tree_var_4_weighted(m, false, 0, 0, 0);
+  }
+
+  // ** var 4 with the orphans weighted by the elimination cost of the
+  //    given decomposition, so that bisection balances flops rather 
+  //    than the number of elements
+  bool build_tree_var_5(Mesh m, int decomposition, int datatype, int n_rhs) {
+    return build_tree_var_4_weighted(m, true, decomposition, datatype, n_rhs);
+  }
+
+  bool build_tree_var_4_weighted(Mesh m, int is_weighted,
+				 int decomposition, int datatype, int n_rhs) {
     assert(m && mesh_valid(m));
     { // ** multi level coarsening mesh
       // Start :: collect orphans
@@ -102,14 +116,16 @@ namespace uhm {
       // *** bisection of orphan
       if (orphan->size() > 1) {
 	Element parent = m->add_element();
-	int n = orphan->size(), wgtflag = 1;
+	int n = orphan->size(), wgtflag = (is_weighted ? 3 : 1);
 
-	std::vector< int > xadj, adjncy, adjwgt;
+	std::vector< int > xadj, adjncy, adjwgt, vwgt;
 	{
 	  //double t = timer();
 
 	  orphan_graph(orphan, parent,
 		       &xadj, &adjncy, &adjwgt);
+	  if (is_weighted)
+	    orphan_weight(orphan, decomposition, datatype, n_rhs, &vwgt);
 
 	  //double time = timer() - t;
 	  //printf("time build_tree_var 4 :: graph orphan %lf\n", time);
@@ -124,7 +140,7 @@ namespace uhm {
 	{
 	  //double t = timer();
 	  SetUpGraph(&graph, OP_OEMETIS, n, 1, &xadj[0], &adjncy[0],
-		     NULL, &adjwgt[0], wgtflag);
+		     (is_weighted ? &vwgt[0] : NULL), &adjwgt[0], wgtflag);
 	  //double time = timer() - t;
 	  //printf("time build_tree_var 4 :: initial metis %lf\n", time);
 	}	  
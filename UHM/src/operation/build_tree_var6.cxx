@@ -0,0 +1,179 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/mesh.hxx"
+#include "uhm/operation/element.hxx"
+#include "uhm/operation/graph.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** coarsening 
+  // Same recursion as var 4 with the built-in multilevel bisection,
+  // so METIS internal headers are not required.
+  bool build_tree_var_6(Mesh m) {
+    assert(m && mesh_valid(m));
+    { // ** multi level coarsening mesh
+      // Start :: collect orphans
+      std::vector< Element > *orphan = new std::vector< Element >;
+      { // ** preprocess                                              
+	Scheduler_ s;
+	s.load(m);
+	s.execute_elements_par(&(op_update_connectivity), true);
+      }
+
+      {
+	std::map< int, Element_ >::iterator mit;
+	for (mit=m->elements.begin();mit!=m->elements.end();mit++) 
+	  if (mit->second.is_orphan()) 
+	    orphan->push_back(&mit->second);
+      }
+      // ---------------------------------------------------------------
+      // *** bisection of orphan
+      if (orphan->size() > 1) {
+	Element parent = m->add_element();
+	int n = orphan->size();
+
+	Graph_ graph;
+	{
+	  //double t = timer();
+
+	  orphan_graph(orphan, parent,
+		       &graph.xadj, &graph.adjncy, &graph.adjwgt);
+
+	  graph.vwgt.assign(n, 1);
+	  graph.label.reserve(n);
+	  for (int i=0;i<n;++i) 
+	    graph.label.push_back(i);
+
+	  //double time = timer() - t;
+	  //printf("time build_tree_var 6 :: graph orphan %lf\n", time);
+	}
+
+#pragma omp parallel
+	{
+#pragma omp single nowait
+	  {
+	    //double t = timer();
+	    graph_dissection(orphan, m, parent, true, &graph);
+	    //double time = timer() - t;
+	    //printf("time build_tree_var 6 :: dissection %lf\n", time);
+	  }
+	}
+      }
+      delete orphan;
+    }
+
+    { // ** update generation
+      Scheduler_ s;
+      s.load(m);
+      s.execute_tree(&op_update_generation, true);
+    }
+    return true;
+  }
+  
+  bool graph_dissection(std::vector< Element > * orphan, 
+			Mesh m, Element parent, int is_parallel,
+			Graph graph) {
+    std::vector< int > where;
+    Graph_ graph_elt[2];
+
+    graph_bisection(graph, where);
+    graph_split(graph, where, &graph_elt[0], &graph_elt[1]);
+
+    graph->reset();
+
+    for (int i=0;i<2;++i) {
+      int n = graph_elt[i].get_n_vertices();
+
+      if (n > 3) {
+	Element elt = m->add_element();
+	
+	elt->set_parent( parent );
+	parent->add_child( elt );
+
+	if (n > UHM_DISSECTION_TASK_SIZE && is_parallel) {
+	  // the task owns the subgraph
+	  Graph sub = new Graph_;
+	  std::swap(sub->xadj,   graph_elt[i].xadj);
+	  std::swap(sub->adjncy, graph_elt[i].adjncy);
+	  std::swap(sub->adjwgt, graph_elt[i].adjwgt);
+	  std::swap(sub->vwgt,   graph_elt[i].vwgt);
+	  std::swap(sub->label,  graph_elt[i].label);
+
+#pragma omp task firstprivate(elt, sub)
+	  {
+	    graph_dissection(orphan, m, elt, true, sub);
+	    delete sub;
+	  }
+	} else {
+	  graph_dissection(orphan, m, elt, false, &graph_elt[i]);
+	}
+
+      } else {
+	if ( n ) {
+	  Element elt;
+	  
+	  switch ( n ) {
+	  case 1: 
+	    elt = parent;
+	    break;
+	  default:
+	    elt = m->add_element();
+	    elt->set_parent( parent );
+	    parent->add_child( elt );
+	    break;
+	  }
+	  
+	  for (int j=0;j<n;++j) {
+	    orphan->at( graph_elt[i].label[j] )->set_parent( elt );
+	    elt->add_child( orphan->at( graph_elt[i].label[j] ) );
+	  }
+	}
+      }
+    }
+    return true;
+  }
+}
@@ -0,0 +1,241 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/mesh.hxx"
+#include "uhm/operation/element.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // compare orphan index by its coordinate along one axis
+  struct Coord_less_ {
+    double *xyz; 
+    int     axis;
+    Coord_less_(double *xyz, int axis) : xyz(xyz), axis(axis) { }
+    bool operator()(int a, int b) const { 
+      return (xyz[3*a+axis] < xyz[3*b+axis]); 
+    }
+  };
+
+  // true if coordinate is below ( or equal to ) the value
+  struct Coord_below_ {
+    double *xyz, val;
+    int     axis, is_equal;
+    Coord_below_(double *xyz, int axis, double val, int is_equal = false) 
+      : xyz(xyz), val(val), axis(axis), is_equal(is_equal) { }
+    bool operator()(int a) const { 
+      return (is_equal ? 
+	      (xyz[3*a+axis] <= val) : 
+	      (xyz[3*a+axis] <  val)); 
+    }
+  };
+
+  static bool build_tree_var_7_internal(std::vector< Element > *orphan,
+					double *xyz,
+					Mesh m, Element parent, int is_parallel,
+					int *idx, int n);
+  
+  // --------------------------------------------------------------
+  // ** coarsening 
+  // Recursive coordinate bisection of orphans. Each level cuts the
+  // bounding box along its longest side at the median, which needs
+  // node coordinates ( Node_::set_coord ) or element centroids 
+  // ( Element_::set_centroid ). Graph is not created at all.
+  // Without coordinates all centroids coincide and the cut would be 
+  // arbitrary, so it falls back to var 4.
+  bool build_tree_var_7(Mesh m) {
+    assert(m && mesh_valid(m));
+    { // ** multi level coarsening mesh
+      // Start :: collect orphans
+      std::vector< Element > *orphan = new std::vector< Element >;
+      { // ** preprocess                                              
+	Scheduler_ s;
+	s.load(m);
+	s.execute_elements_par(&(op_update_connectivity), true);
+      }
+
+      {
+	std::map< int, Element_ >::iterator mit;
+	for (mit=m->elements.begin();mit!=m->elements.end();mit++) 
+	  if (mit->second.is_orphan()) 
+	    orphan->push_back(&mit->second);
+      }
+      // ---------------------------------------------------------------
+      // *** bisection of orphan
+      if (orphan->size() > 1) {
+	int n = orphan->size();
+
+	std::vector< int >    idx(n);
+	std::vector< double > xyz(3*n);
+
+#pragma omp parallel for schedule(static)
+	for (int i=0;i<n;++i) {
+	  idx[i] = i;
+	  orphan->at(i)->get_centroid(&xyz[3*i]);
+	}
+
+	int is_flat = true;
+	for (int i=1;i<n && is_flat;++i) 
+	  for (int k=0;k<3;++k) 
+	    if (xyz[3*i+k] != xyz[k]) {
+	      is_flat = false;
+	      break;
+	    }
+
+	if (is_flat) {
+	  fprintf(stderr, 
+		  "build_tree_var_7: no coordinates, fall back to var 4\n");
+	  delete orphan;
+	  return build_tree_var_4(m);
+	}
+
+	Element parent = m->add_element();
+
+#pragma omp parallel
+	{
+#pragma omp single nowait
+	  {
+	    //double t = timer();
+	    build_tree_var_7_internal(orphan, &xyz[0], m, parent, true,
+				      &idx[0], n);
+	    //double time = timer() - t;
+	    //printf("time build_tree_var 7 :: dissection %lf\n", time);
+	  }
+	}
+      }
+      delete orphan;
+    }
+
+    { // ** update generation
+      Scheduler_ s;
+      s.load(m);
+      s.execute_tree(&op_update_generation, true);
+    }
+    return true;
+  }
+  
+  bool build_tree_var_7_internal(std::vector< Element > * orphan, 
+				 double *xyz,
+				 Mesh m, Element parent, int is_parallel,
+				 int *idx, int n) {
+    // bounding box and its longest side
+    double lo[3], hi[3];
+    for (int k=0;k<3;++k) 
+      lo[k] = hi[k] = xyz[3*idx[0]+k];
+
+    for (int i=1;i<n;++i) 
+      for (int k=0;k<3;++k) {
+	lo[k] = min(lo[k], xyz[3*idx[i]+k]);
+	hi[k] = max(hi[k], xyz[3*idx[i]+k]);
+      }
+
+    int axis = 0;
+    for (int k=1;k<3;++k) 
+      if (hi[k]-lo[k] > hi[axis]-lo[axis]) axis = k;
+
+    // split at median; elements on the median plane go to one side
+    // so that the separator is straight on structured meshes
+    std::nth_element(idx, idx + n/2, idx + n, Coord_less_(xyz, axis));
+
+    int half = n/2;
+    {
+      double val = xyz[3*idx[half]+axis];
+      int lower = std::partition(idx, idx + n, 
+				 Coord_below_(xyz, axis, val)) - idx;
+      int upper = std::partition(idx + lower, idx + n, 
+				 Coord_below_(xyz, axis, val, true)) - idx;
+      
+      half = ((half - lower) <= (upper - half) ? lower : upper);
+      if (half == 0 || half == n) {
+	std::nth_element(idx, idx + n/2, idx + n, Coord_less_(xyz, axis));
+	half = n/2;
+      }
+    }
+    int n_elt[2] = { half, n - half }, *idx_elt[2] = { idx, idx + half };
+
+    for (int i=0;i<2;++i) {
+
+      if (n_elt[i] > 3) {
+	Element elt = m->add_element();
+	
+	elt->set_parent( parent );
+	parent->add_child( elt );
+
+	if (n_elt[i] > UHM_DISSECTION_TASK_SIZE && is_parallel) {
+	  
+#pragma omp task firstprivate(i, elt, n_elt, idx_elt)
+	  {
+	    build_tree_var_7_internal(orphan, xyz, m, elt, true,
+				      idx_elt[i], n_elt[i]);
+	  }
+	} else {
+	  build_tree_var_7_internal(orphan, xyz, m, elt, false,
+				    idx_elt[i], n_elt[i]);
+	}
+
+      } else {
+	if ( n_elt[i] ) {
+	  Element elt;
+	  
+	  switch ( n_elt[i] ) {
+	  case 1: 
+	    elt = parent;
+	    break;
+	  default:
+	    elt = m->add_element();
+	    elt->set_parent( parent );
+	    parent->add_child( elt );
+	    break;
+	  }
+	  
+	  for (int j=0;j<n_elt[i];++j) {
+	    orphan->at( idx_elt[i][j] )->set_parent( elt );
+	    elt->add_child( orphan->at( idx_elt[i][j] ) );
+	  }
+	}
+      }
+    }
+    return true;
+  }
+}
@@ -60,27 +60,48 @@ namespace uhm {
     int n = orphan->size();
 
     { // ** mark the elements with parent id, and indexing
-      double t = timer();
+#pragma omp parallel for schedule(static)
       for (int i=0;i<n;++i) {
 	orphan->at(i)->set_marker(0, parent->get_id());
 	orphan->at(i)->set_marker(1, i);
       }
-      double time = timer()-t;
-      //printf("orphan_graph::marking %lf\n", time);
     }
 
     { // ** create graph
-      std::vector< std::map< int, int > > adj;
-      adj.assign( n, std::map<int,int>() );
-      
-      { // **loop through orphan
-	double t = timer();
-
-#pragma omp parallel for schedule(static)
-	for (int i=0;i<n;++i) {
+      // Two passes over contiguous ranges of orphans, one range per thread.
+      // Pass 1 gathers ( neighbor, weight ) of a vertex in a row scratch,
+      //        sorts and reduces duplicated edges, and appends the row to
+      //        the thread local buffer. Row length is kept in xadj.
+      // Pass 2 shifts the rows by the offset of preceding threads and 
+      //        copies the local buffer into adjncy and adjwgt.
+      int n_threads = 1;
+#ifdef _OPENMP
+      n_threads = omp_get_max_threads();
+#endif
+      std::vector< int > offs( n_threads+1, 0 );
+
+      xadj->assign( n+1, 0 );
+      if (adjncy->size()) adjncy->clear();
+      if (adjwgt->size()) adjwgt->clear();
+
+#pragma omp parallel 
+      {
+	int tid = 0, nt = 1;
+#ifdef _OPENMP
+	tid = omp_get_thread_num();
+	nt  = omp_get_num_threads();
+#endif
+	int begin = (int)(((long)n*tid    )/nt);
+	int end   = (int)(((long)n*(tid+1))/nt);
+
+	std::vector< std::pair<int,int> > row, local;
+	
+	// ** pass 1 :: count
+	for (int i=begin;i<end;++i) {
 	  Element elt = orphan->at(i);
-	  
+
 	  // loop through schur nodes
+	  row.clear();
 	  std::map< Node, int >::iterator nit;
 	  for (nit=elt->nodes.begin();nit!=elt->nodes.end();++nit) {
 	    
@@ -90,56 +111,94 @@ namespace uhm {
 	      for (eit =(nit->first)->owner.begin();
 		   eit!=(nit->first)->owner.end();
 		   ++eit) {
-		  
+		
 		// if owner has marker of parent id, add it in adjacency
 		if ((*eit)->get_marker(0) == parent->get_id() &&
-		    (*eit) != elt) { 
-		    
-		  // vertex point and its weight
-		  std::pair< std::map< int, int >::iterator, bool > ret;
-		  std::pair< int,int > in;
-		    
-		  in.first  = (*eit)->get_marker(1);
-		  in.second = nit->first->get_n_dof();
-		    
-		  ret = adj[i].insert( in );
-		    
-		  if (ret.second==false) 
-		    ret.first->second += in.second;
-		}
+		    (*eit) != elt) 
+		  row.push_back( std::make_pair( (*eit)->get_marker(1),
+						 nit->first->get_n_dof() ) );
 	      }
 	    }
 	  }
+	  
+	  // sort and reduce duplicated edges
+	  std::sort( row.begin(), row.end() );
+
+	  int n_adj = 0;
+	  for (int j=0;j<row.size();++j) {
+	    if (n_adj && local.back().first == row[j].first) {
+	      local.back().second += row[j].second;
+	    } else {
+	      local.push_back( row[j] );
+	      ++n_adj;
+	    }
+	  }
+	  (*xadj)[i+1] = n_adj;
 	}
-	double time = timer()-t;
-	//printf("orphan_graph::adding %lf\n", time);
-      }
+	offs[tid+1] = local.size();
 
-      // remove duplicated entries
-      {
-	double t = timer();
-
-	// clear input array
-	if (xadj->size()) xadj->clear();
-	if (adjncy->size()) adjncy->clear();
-	if (adjwgt->size()) adjwgt->clear();
+#pragma omp barrier
+#pragma omp single
+	{
+	  for (int k=0;k<nt;++k) 
+	    offs[k+1] += offs[k];
 
-	xadj->reserve   ( n+1 );
-	xadj->push_back ( 0 );
-	
-	for (int i=0;i<n;++i) {
+	  adjncy->resize( offs[nt] );
+	  adjwgt->resize( offs[nt] );
+	}
 
-	  std::map<int,int>::iterator ait;
-	  for (ait=adj[i].begin();ait!=adj[i].end();++ait) {
-	    adjncy->push_back(ait->first);
-	    adjwgt->push_back(ait->second);
-	  }
-	  xadj->push_back(adjncy->size());
+	// ** pass 2 :: fill
+	int k = offs[tid];
+	for (int i=begin;i<end;++i) {
+	  k += (*xadj)[i+1];
+	  (*xadj)[i+1] = k;
+	}
+	for (int j=0;j<local.size();++j) {
+	  (*adjncy)[ offs[tid]+j ] = local[j].first;
+	  (*adjwgt)[ offs[tid]+j ] = local[j].second;
 	}
-	double time = timer() - t;
-	//printf("orphan_graph::map to vector %lf\n", time);
       }
     }
     return true;
   }
+
+  // --------------------------------------------------------------
+  // ** vertex weight 
+  // Each orphan is weighted by the flops to eliminate its own factor 
+  // nodes, normalized by the average so that the sum fits in METIS idxtype.
+  // Weights are at least 1, so elements without work still count, and
+  // the total is capped by UHM_VERTEX_WEIGHT_MAX ( 2^29 ) so that sums
+  // and imbalance bounds in METIS stay in int.
+  bool orphan_weight(std::vector< Element > *orphan,
+		     int decomposition, int datatype, int n_rhs,
+		     std::vector< int > *vwgt) {
+    int n = orphan->size();
+    std::vector< double > cost(n);
+    double total = 0.0;
+
+#pragma omp parallel for schedule(static) reduction(+:total)
+    for (int i=0;i<n;++i) {
+      double flop_decompose, flop_solve, buffer;
+      unsigned int n_nonzero_factor;
+      orphan->at(i)->estimate_cost(decomposition, datatype, n_rhs,
+				   flop_decompose, flop_solve,
+				   n_nonzero_factor, buffer);
+      cost[i] = flop_decompose;
+      total  += flop_decompose;
+    }
+
+    if (vwgt->size()) vwgt->clear();
+    vwgt->reserve( n );
+
+    double budget = (double)UHM_VERTEX_WEIGHT_SCALE*n;
+    double limit  = (double)UHM_VERTEX_WEIGHT_MAX - n;
+    if (budget > limit) 
+      budget = (limit > 0.0 ? limit : 0.0);
+
+    double scale = (total > 0.0 ? budget/total : 0.0);
+    for (int i=0;i<n;++i) 
+      vwgt->push_back( 1 + (int)(cost[i]*scale) );
+
+    return true;
+  }
 }
@@ -0,0 +1,174 @@
+/*
+  Copyright © 2011, Kyungjoo Kim
+  All rights reserved.
+  
+  This file is part of UHM.
+  
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+  1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+
+  2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+  3. Neither the name of the owner nor the names of its contributors
+    may be used to endorse or promote products derived from this software
+    without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "uhm/common.hxx"
+#include "uhm/const.hxx"
+#include "uhm/util.hxx"
+
+#include "uhm/object.hxx"
+
+#include "uhm/operation/scheduler.hxx"
+#include "uhm/operation/mesh.hxx"
+#include "uhm/operation/element.hxx"
+#include "uhm/operation/graph.hxx"
+
+#include "uhm/mesh/node.hxx"
+#include "uhm/mesh/element.hxx"
+
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include "uhm/mesh/mesh.hxx"
+
+namespace uhm {
+  // --------------------------------------------------------------
+  // ** incremental tree update
+  // After refine_element, the leaves below e are dissected again under e
+  // and only e and its ancestors change their generation. The rest of
+  // the tree is untouched. Mesh_::relock calls this for the elements
+  // changed by refine_element and unrefine_element.
+  bool update_tree(Mesh m, Element e) {
+    assert(m && mesh_valid(m) && element_valid(e));
+
+    if (e->is_leaf()) return true;
+
+    std::vector< Element > *orphan = new std::vector< Element >;
+
+    { // ** collect leaves and remove intermediate elements
+      std::vector< Element > tmp;
+      tmp.push_back( e );
+
+      for (int i=0;i<tmp.size();++i) 
+	for (int j=0;j<tmp.at(i)->get_n_children();++j) 
+	  tmp.push_back( tmp.at(i)->get_child(j) );
+
+      e->reset_children();
+
+      for (int i=1;i<tmp.size();++i) {
+	Element c = tmp.at(i);
+	if (c->is_leaf()) {
+	  c->reset_parent();
+	  orphan->push_back( c );
+	} else {
+	  // merged nodes may still refer the element as owner
+	  std::map< Node, int >::iterator nit;
+	  for (nit=c->nodes.begin();nit!=c->nodes.end();++nit) 
+	    if (nit->first->is_owned_by(c)) 
+	      nit->first->remove_owner(c);
+	  m->remove_element(c->get_id());
+	}
+      }
+    }
+
+    int n = orphan->size();
+
+    if (n > 3) {
+      Graph_ graph;
+      { // ** graph of leaves :: leaves sharing a node are adjacent
+	std::vector< std::pair<Node,int> > incidence;
+	for (int i=0;i<n;++i) {
+	  std::map< Node, int >::iterator nit;
+	  for (nit=orphan->at(i)->nodes.begin();
+	       nit!=orphan->at(i)->nodes.end();++nit) 
+	    incidence.push_back( std::make_pair( nit->first, i ) );
+	}
+	std::sort( incidence.begin(), incidence.end() );
+
+	std::vector< std::vector< std::pair<int,int> > > row( n );
+	for (int k=0;k<incidence.size();) {
+	  int l = k;
+	  while (l < incidence.size() && 
+		 incidence.at(l).first == incidence.at(k).first) ++l;
+
+	  int w = incidence.at(k).first->get_n_dof();
+	  for (int a=k;a<l;++a) 
+	    for (int b=k;b<l;++b) 
+	      if (a != b) 
+		row[ incidence.at(a).second ].push_back
+		  ( std::make_pair( incidence.at(b).second, w ) );
+	  k = l;
+	}
+
+	graph.xadj.reserve( n+1 );
+	graph.xadj.push_back( 0 );
+	for (int i=0;i<n;++i) {
+	  // sort and reduce duplicated edges
+	  std::sort( row[i].begin(), row[i].end() );
+	  for (int j=0;j<row[i].size();++j) {
+	    if (j && row[i][j].first == row[i][j-1].first) {
+	      graph.adjwgt.back() += row[i][j].second;
+	    } else {
+	      graph.adjncy.push_back( row[i][j].first );
+	      graph.adjwgt.push_back( row[i][j].second );
+	    }
+	  }
+	  graph.xadj.push_back( graph.adjncy.size() );
+	}
+
+	graph.vwgt.assign(n, 1);
+	graph.label.reserve(n);
+	for (int i=0;i<n;++i) 
+	  graph.label.push_back(i);
+      }
+
+#pragma omp parallel
+      {
+#pragma omp single nowait
+	graph_dissection(orphan, m, e, true, &graph);
+      }
+    } else {
+      for (int i=0;i<n;++i) {
+	orphan->at(i)->set_parent( e );
+	e->add_child( orphan->at(i) );
+      }
+    }
+    delete orphan;
+
+    { // ** update generation :: new subtree, then ancestors
+      std::vector< Element > tmp;
+      tmp.push_back( e );
+
+      for (int i=0;i<tmp.size();++i) 
+	for (int j=0;j<tmp.at(i)->get_n_children();++j) 
+	  tmp.push_back( tmp.at(i)->get_child(j) );
+
+      for (int i=tmp.size()-1;i>=0;--i) 
+	tmp.at(i)->update_generation();
+
+      Element p = e->get_parent();
+      while (p != nil_element) {
+	p->update_generation();
+	p = p->get_parent();
+      }
+    }
+    return true;
+  }
+}
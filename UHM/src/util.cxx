@@ -34,6 +34,12 @@
 #include "uhm/const.hxx"
 #include "uhm/util.hxx"
 
+#include "uhm/matrix/uhm/matrix.hxx"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
 namespace uhm {
   // --------------------------------------------------------------
   // ** Timer
@@ -65,11 +71,7 @@ namespace uhm {
   // --------------------------------------------------------------
   // ** Query
   bool is_hier_matrix_enable() {
-#ifdef UHM_HIER_MATRIX_ENABLE
-    return true;
-#else 
-    return false;
-#endif
+    return ( get_hier_matrix_mode() != UHM_MATRIX_FLAT );
   }
 
   bool is_multithreading_enable() {
@@ -198,4 +200,38 @@ namespace uhm {
     assert(buf_size == fread (buf, 1, buf_size, fp));
     return true;
   }
+
+  // read only mapping of the whole file, sequential access expected
+  bool map_file(char *fullpath, size_t *size, char **buf) {
+    int fd;
+    struct stat stats;
+
+    fd = open(fullpath, O_RDONLY);
+    if (fd < 0 || fstat(fd, &stats)) {
+      fprintf(stderr, "fail to open file : %s\n", fullpath);
+      if (fd >= 0) close(fd);
+      return false;
+    }
+
+    *size = stats.st_size;
+    *buf  = (char*)mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if (*buf == (char*)MAP_FAILED) {
+      fprintf(stderr, "fail to map file : %s\n", fullpath);
+      return false;
+    }
+    madvise(*buf, *size, MADV_SEQUENTIAL);
+    return true;
+  }
+
+  bool unmap_file(size_t size, char *buf) {
+    if (munmap(buf, size)) {
+      fprintf(stderr, "fail to unmap file");
+      return false;
+    }
+    return true;
+  }
 }
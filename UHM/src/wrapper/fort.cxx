@@ -66,6 +66,19 @@ void UHM_C2F(uhm_set_hier_block_size)         ( uhm_fort_int *blocksize ) {
 void UHM_C2F(uhm_get_hier_block_size)         ( uhm_fort_int *size ) {
   *size = uhm::get_hier_block_size();
 }
+void UHM_C2F(uhm_import_hier_block_profile)   ( uhm_fort_char *filename,
+                                                uhm_fort_int  *is_loaded ) {
+  *is_loaded = uhm::import_hier_block_profile(filename);
+}
+void UHM_C2F(uhm_set_hier_matrix_mode)        ( uhm_fort_int *mode ) {
+  uhm::set_hier_matrix_mode( *mode );
+}
+void UHM_C2F(uhm_set_hier_matrix_threshold)   ( uhm_fort_int *size ) {
+  uhm::set_hier_matrix_threshold( *size );
+}
+void UHM_C2F(uhm_set_recursive_matrix_threshold)( uhm_fort_int *size ) {
+  uhm::set_recursive_matrix_threshold( *size );
+}
 void UHM_C2F(uhm_reset_flop)                  () {
   uhm::matrix_reset_flop();
 }
@@ -127,6 +140,18 @@ void UHM_C2F(uhm_element_add_node)            ( uhm_fort_p   *elt,
   e->add_node(n);
 }
 
+void UHM_C2F(uhm_node_set_coord)              ( uhm_fort_p   *nod,
+                                                uhm_fort_double *xyz ) {
+  uhm::Node n = (uhm::Node)( *nod );
+  n->set_coord(xyz[0], xyz[1], xyz[2]);
+}
+
+void UHM_C2F(uhm_element_set_centroid)        ( uhm_fort_p   *elt,
+                                                uhm_fort_double *xyz ) {
+  uhm::Element e = (uhm::Element)( *elt );
+  e->set_centroid(xyz[0], xyz[1], xyz[2]);
+}
+
 void UHM_C2F(uhm_copy_in)                     ( uhm_fort_p   *mesh,
                                                 uhm_fort_p   *elt,
                                                 uhm_fort_int *datatype,
@@ -193,12 +218,36 @@ void UHM_C2F(uhm_mesh_import)                 ( uhm_fort_p    *mesh,
   uhm::Mesh m = (uhm::Mesh)( *mesh );
   m->import_file(filename);
 }
+void UHM_C2F(uhm_mesh_export_tree)            ( uhm_fort_p    *mesh,
+                                                uhm_fort_char *filename) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  m->export_tree(filename);
+}
+void UHM_C2F(uhm_mesh_import_tree)            ( uhm_fort_p    *mesh,
+                                                uhm_fort_char *filename,
+                                                uhm_fort_int  *is_loaded) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  *is_loaded = m->import_tree(filename);
+}
 
 void UHM_C2F(uhm_build_tree)                  ( uhm_fort_p   *mesh ) {
   uhm::Mesh m = (uhm::Mesh)( *mesh );
   uhm::build_tree(m);
 }
 
+void UHM_C2F(uhm_build_tree_geometry)         ( uhm_fort_p   *mesh ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  uhm::build_tree_var_7(m);
+}
+
+void UHM_C2F(uhm_build_tree_weighted)         ( uhm_fort_p   *mesh,
+                                                uhm_fort_int *decomposition,
+                                                uhm_fort_int *datatype,
+                                                uhm_fort_int *n_rhs ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  uhm::build_tree_var_5(m, *decomposition, *datatype, *n_rhs);
+}
+
 void UHM_C2F(uhm_create_matrix_without_buffer)( uhm_fort_p   *mesh,
                                                 uhm_fort_int *datatype,
                                                 uhm_fort_int *n_rhs ) {
@@ -320,4 +369,80 @@ void UHM_C2F(uhm_get_residual)                ( uhm_fort_p  *mesh,
   *res = (uhm_fort_double)m->get_residual();
 }
 
+void UHM_C2F(uhm_mesh_multiply)               ( uhm_fort_p  *mesh,
+                                                uhm_fort_int *datatype,
+                                                uhm_fort_int *n_rhs,
+                                                uhm_fort_double *x,
+                                                uhm_fort_double *y ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+
+  // complex vectors are interleaved
+  int n = m->get_n_dof()*(*n_rhs)*(*datatype == UHM_COMPLEX ? 2 : 1);
+  std::vector<double> xx(x, x+n), yy;
+
+  m->multiply( *n_rhs, xx, yy );
+  std::copy(yy.begin(), yy.end(), y);
+}
+
+// ** krylov solvers
+//----------------------------------------------------------------------
+
+void UHM_C2F(uhm_mesh_pcg)                    ( uhm_fort_p  *mesh,
+                                                uhm_fort_p  *op,
+                                                uhm_fort_int *method,
+                                                uhm_fort_int *n_rhs,
+                                                uhm_fort_double *b,
+                                                uhm_fort_double *x,
+                                                uhm_fort_double *tol,
+                                                uhm_fort_int *max_iter,
+                                                uhm_fort_int *n_iter ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  uhm::Mesh o = (uhm::Mesh)( *op );
+
+  int n = m->get_n_dof()*(*n_rhs);
+  std::vector<double> bb(b, b+n), xx(x, x+n);
+
+  *n_iter = m->pcg( o, *method, *n_rhs, bb, xx, *tol, *max_iter );
+  std::copy(xx.begin(), xx.end(), x);
+}
+
+void UHM_C2F(uhm_mesh_gmres)                  ( uhm_fort_p  *mesh,
+                                                uhm_fort_p  *op,
+                                                uhm_fort_int *method,
+                                                uhm_fort_int *n_rhs,
+                                                uhm_fort_double *b,
+                                                uhm_fort_double *x,
+                                                uhm_fort_double *tol,
+                                                uhm_fort_int *max_iter,
+                                                uhm_fort_int *restart,
+                                                uhm_fort_int *n_iter ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+  uhm::Mesh o = (uhm::Mesh)( *op );
+
+  int n = m->get_n_dof()*(*n_rhs);
+  std::vector<double> bb(b, b+n), xx(x, x+n);
+
+  *n_iter = m->gmres( o, *method, *n_rhs, bb, xx, *tol, *max_iter, *restart );
+  std::copy(xx.begin(), xx.end(), x);
+}
+
+void UHM_C2F(uhm_get_krylov_stat)             ( uhm_fort_p  *mesh,
+                                                uhm_fort_int *n_iter,
+                                                uhm_fort_double *residual,
+                                                uhm_fort_double *t_total,
+                                                uhm_fort_double *t_precond,
+                                                uhm_fort_double *t_multiply ) {
+  uhm::Mesh m = (uhm::Mesh)( *mesh );
+
+  int    it;
+  double res, t, t_p, t_m;
+  m->get_krylov_stat( it, res, t, t_p, t_m );
+
+  *n_iter     = (uhm_fort_int)it;
+  *residual   = (uhm_fort_double)res;
+  *t_total    = (uhm_fort_double)t;
+  *t_precond  = (uhm_fort_double)t_p;
+  *t_multiply = (uhm_fort_double)t_m;
+}
+
 
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+echo '****** Orphan graph from 10^4 to 10^7 elements *******'
+
+for i in 100 316 1000 3162 ; do \
+    ../graphtest 1 $i 4
+done ;
+
+echo '****** Orphan graph for various thread size *******'
+
+for i in 1 2 4 8 12 16 20 24 ; do \
+    ../graphtest $i 3162 4
+done ;
@@ -0,0 +1,142 @@
+#include "uhm.hxx"
+
+// structured quad mesh with vertex, edge and interior nodes
+// node ids are offset by kind : 0 vertex, 1 x-edge, 2 y-edge, 3 interior
+static int node_id(int kind, int i, int j, int n) {
+  return (kind*(n+1) + i)*(n+1) + j;
+}
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  uhm::Mesh m;
+
+  // input check
+  if (argc != 4) {
+    printf("Try : graphtest [n_thread][n_elements per side][p]\n");
+    return 0;
+  }
+
+  int n_threads, n, p;
+  n_threads = atoi( (argv[1]) );
+  n         = atoi( (argv[2]) );
+  p         = atoi( (argv[3]) );
+
+  double t_base, t_graph, t_bisection;
+
+  uhm::set_num_threads(n_threads);
+
+  printf( "BEGIN : Create mesh %d x %d \n", n, n );
+  m = new uhm::Mesh_;
+  std::vector< uhm::Element > orphan;
+  orphan.reserve( n*n );
+
+  for (int i=0;i<n;++i) {
+    for (int j=0;j<n;++j) {
+      uhm::Element e = m->add_element();
+
+      e->add_node( m->add_node( node_id(0, i  , j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i  , j+1, n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j+1, n), 1 ) );
+
+      e->add_node( m->add_node( node_id(1, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(1, i  , j+1, n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i+1, j  , n), p-1 ) );
+
+      e->add_node( m->add_node( node_id(3, i  , j  , n), (p-1)*(p-1) ) );
+
+      orphan.push_back(e);
+    }
+  }
+  printf( "END   : Create mesh < n_nodes %d, n_elements %d >\n",
+	  m->get_n_nodes(), m->get_n_elements() );
+
+  {
+    uhm::Scheduler_ s;
+    s.load(m);
+    s.execute_elements_par(&(uhm::op_update_connectivity), true);
+  }
+
+  std::vector< int > xadj, adjncy, adjwgt;
+  uhm::Element parent = m->add_element();
+
+  printf( "BEGIN : Orphan graph \n" );
+  t_base  = uhm::timer();
+  uhm::orphan_graph(&orphan, parent, &xadj, &adjncy, &adjwgt);
+  t_graph = uhm::timer() - t_base;
+  printf( "END   : Orphan graph \n" );
+
+  // built-in bisection on the orphan graph with unit vertex weights
+  uhm::Graph_ g;
+  std::vector< int > where;
+  g.xadj   = xadj;
+  g.adjncy = adjncy;
+  g.adjwgt = adjwgt;
+  g.vwgt.assign(xadj.size()-1, 1);
+
+  printf( "BEGIN : Bisection \n" );
+  t_base      = uhm::timer();
+  int cut     = uhm::graph_bisection(&g, where);
+  t_bisection = uhm::timer() - t_base;
+  printf( "END   : Bisection \n" );
+
+  // cut and part weights recomputed from the partition
+  int is_bisection_valid = (where.size() == xadj.size()-1);
+  int n_cut = 0, pw[2] = { 0, 0 };
+  for (int i=0;i<where.size() && is_bisection_valid;++i) {
+    if (where[i] != 0 && where[i] != 1) {
+      is_bisection_valid = false;
+      break;
+    }
+    pw[ where[i] ] += g.vwgt[i];
+    for (int j=xadj[i];j<xadj[i+1];++j) 
+      if (where[ adjncy[j] ] != where[i]) 
+        n_cut += adjwgt[j];
+  }
+  n_cut /= 2;
+
+  // same tolerance as the refinement : ubfactor or one heaviest vertex
+  int tpw[2], maxpw[2];
+  tpw[0] = g.get_total_weight()/2;
+  tpw[1] = g.get_total_weight() - tpw[0];
+  for (int k=0;k<2;++k)
+    maxpw[k] = max((int)(UHM_BISECTION_UBFACTOR*tpw[k]), 
+                   tpw[k] + g.get_max_weight());
+
+  is_bisection_valid = ( is_bisection_valid && 
+                         n_cut == cut && 
+                         pw[0] > 0 && pw[1] > 0 &&
+                         pw[0] <= maxpw[0] && pw[1] <= maxpw[1] );
+
+  printf("--------------------------\n");
+  printf("Threads                = %d\n", n_threads);
+  printf("Vertices               = %d\n", (int)(xadj.size()-1));
+  printf("Edges                  = %d\n", (int)adjncy.size());
+  printf("--------------------------\n");
+  printf("Time graph (s)         = %E\n", t_graph);
+  printf("Vertices / s           = %E\n", (xadj.size()-1)/t_graph);
+  printf("--------------------------\n");
+  printf("Edge cut               = %d\n", cut);
+  printf("Part weights           = %d, %d\n", pw[0], pw[1]);
+  printf("Time bisection (s)     = %E\n", t_bisection);
+  printf("--------------------------\n");
+
+  // interior vertex of structured mesh has 8 neighbors
+  if (n > 2 && xadj[ n+2 ] - xadj[ n+1 ] == 8)
+    printf("TESTING GRAPH : **** PASS **** \n");
+  else if (n > 2)
+    printf("TESTING GRAPH : **** FAIL **** \n");
+
+  if (is_bisection_valid)
+    printf("TESTING BISECTION : **** PASS **** \n");
+  else
+    printf("TESTING BISECTION : **** FAIL **** \n");
+
+  delete m;
+
+  FLA_Finalize();
+  return 0;
+}
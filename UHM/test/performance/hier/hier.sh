@@ -0,0 +1,12 @@
+#!/bin/bash
+
+echo '****** Flat, hier and auto fronts for various threshold *******'
+
+for i in 128 256 512 1024 ; do \
+    ../hiertest 12 1 256 $i ../../uhmfile/sphere3.uhm
+done ;
+
+echo '****** Flat, hier and auto fronts for various thread size *******'
+for i in 1 4 8 12 16 24 ; do \
+    ../hiertest $i 1 256 512 ../../uhmfile/sphere4.uhm
+done ;
@@ -0,0 +1,127 @@
+#include "uhm.hxx"
+
+// decompose the same tree with flat, hier and auto (flat below the
+// threshold, hier above) fronts and compare the time
+
+static double decompose(uhm::Mesh m, int decomposition, int mode,
+                        double &residual) {
+  uhm::set_hier_matrix_mode(mode);
+
+  int datatype = UHM_REAL;
+  int n_rhs    = 1;
+  int is_schur = false;
+
+  m->create_matrix_without_buffer( datatype, n_rhs );
+  m->create_matrix_buffer(is_schur);
+
+  switch (decomposition) {
+  case UHM_CHOL:
+    m->random_spd_matrix();
+    m->triangularize();
+    break;
+  default:
+    m->random_matrix();
+    break;
+  }
+  m->set_rhs();
+
+  double t_base = uhm::timer();
+  switch (decomposition) {
+  case UHM_CHOL:     m->chol_without_free();     break;
+  case UHM_LU_NOPIV: m->lu_nopiv_without_free(); break;
+  case UHM_LU_PIV:   m->lu_piv_without_free();   break;
+  case UHM_QR:       m->qr_without_free();       break;
+  }
+  double t_decompose = uhm::timer() - t_base;
+
+  switch (decomposition) {
+  case UHM_CHOL:     m->solve_chol();     m->check_chol();     break;
+  case UHM_LU_NOPIV: m->solve_lu_nopiv(); m->check_lu_nopiv(); break;
+  case UHM_LU_PIV:   m->solve_lu_piv();   m->check_lu_piv();   break;
+  case UHM_QR:       m->solve_qr();       m->check_qr();       break;
+  }
+  residual = m->get_residual();
+
+  m->free_matrix();
+  uhm::matrix_reset_buffer();
+
+  return t_decompose;
+}
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  uhm::Mesh m;
+
+  // input check
+  if (argc != 6 && argc != 7) {
+    printf("Try : hiertest [n_thread][decomposition][blocksize][threshold][input_file]([recursive])\n");
+    return 0;
+  }
+
+  int n_threads, decomposition, blocksize, threshold, recursive = 0;
+  char *filename;
+  n_threads     = atoi( (argv[1]) );
+  decomposition = atoi( (argv[2]) );
+  blocksize     = atoi( (argv[3]) );
+  threshold     = atoi( (argv[4]) );
+  filename      = argv[5];
+  if (argc == 7)
+    recursive   = atoi( (argv[6]) );
+
+  if (decomposition == UHM_LU_INCPIV) {
+    printf("LU_INCPIV has no flat path\n");
+    return 0;
+  }
+
+  m = new uhm::Mesh_;
+  m->import_file( filename );
+  m->get_n_dof();
+
+  uhm::set_num_threads(n_threads);
+  uhm::build_tree(m);
+  m->lock();
+
+  uhm::set_hier_block_size(blocksize);
+  uhm::set_hier_matrix_threshold(threshold);
+  uhm::set_recursive_matrix_threshold(recursive);
+
+  int mode[] = { UHM_MATRIX_FLAT, UHM_MATRIX_HIER, UHM_MATRIX_AUTO };
+  const char *name[] = { "Flat", "Hier", "Auto" };
+  double t_decompose[3], residual[3];
+
+  for (int i=0;i<3;++i) {
+    printf("BEGIN : %s Decomposition\n", name[i]);
+    t_decompose[i] = decompose(m, decomposition, mode[i], residual[i]);
+    printf("END   : %s Decomposition\n", name[i]);
+  }
+
+  double f_decompose, f_solve, m_estimate;
+  unsigned int n_nonzero_factor;
+  m->estimate_cost( decomposition, UHM_REAL, 1,
+                    f_decompose, f_solve, n_nonzero_factor, m_estimate );
+
+  printf("==== Report =====\n");
+  printf("Number of threads      = %d\n", uhm::get_num_threads());
+  printf("Decomposition          = %d\n", decomposition);
+  printf("CHOL(1), LU_NOPIV(2), LU_PIV(3), QR(5)\n");
+  printf("Blocksize              = %d\n", blocksize);
+  printf("Threshold              = %d\n", threshold);
+  printf("Recursive              = %d\n", recursive);
+  printf("NDOF                   = %d\n", m->get_n_dof());
+  printf("--------------------------\n");
+  for (int i=0;i<3;++i) {
+    printf("%s time decom (s)    = %E\n", name[i], t_decompose[i]);
+    printf("%s decom (GFLOP/s)   = %6.3lf\n", name[i],
+           f_decompose/t_decompose[i]/1.0e9);
+    printf("%s residual          = %E\n", name[i], residual[i]);
+    printf("--------------------------\n");
+  }
+
+  delete m;
+
+  FLA_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+echo '****** Krylov solvers preconditioned by the factorization *******'
+
+for t in 1 4 ; do \
+    ../krylovtest $t 16 3
+done ;
@@ -0,0 +1,279 @@
+#include "uhm.hxx"
+
+#define UHM_ERROR_TOL 1.0e-5
+
+// krylov solvers preconditioned by the factorization of the same spd
+// leaf matrices ( one iteration ), by a stale factorization ( gmres ),
+// and a breakdown on a zero operator that has to stop without nan.
+// the element-by-element product is checked against the assembled matrix
+// and the selective solve against the full solve on its output elements.
+
+// structured quad mesh with vertex, edge and interior nodes
+static int node_id(int kind, int i, int j, int n) {
+  return (kind*(n+1) + i)*(n+1) + j;
+}
+
+static uhm::Mesh create_mesh(int n, int p) {
+  uhm::Mesh m = new uhm::Mesh_;
+
+  for (int i=0;i<n;++i) {
+    for (int j=0;j<n;++j) {
+      uhm::Element e = m->add_element();
+
+      e->add_node( m->add_node( node_id(0, i  , j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i  , j+1, n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j+1, n), 1 ) );
+
+      e->add_node( m->add_node( node_id(1, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(1, i  , j+1, n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i+1, j  , n), p-1 ) );
+
+      e->add_node( m->add_node( node_id(3, i  , j  , n), (p-1)*(p-1) ) );
+    }
+  }
+  return m;
+}
+
+static void create_matrix(uhm::Mesh m) {
+  m->create_matrix_without_buffer( UHM_REAL, 1 );
+  m->create_matrix_buffer();
+}
+
+// spd leaf matrices B B^T + n I, the assembled matrix is spd
+static void spd_leaves(uhm::Mesh m, int n) {
+  m->random_matrix();
+  for (int k=0;k<n*n;++k) {
+    uhm::Matrix hm = m->find_element(k)->get_matrix();
+    std::pair<int,int> dim = hm->get_dimension();
+    int fs = dim.first, ss = dim.second, nn = fs + ss;
+
+    std::vector<double> b(nn*nn), a(nn*nn, 0.0);
+    for (int i=0;i<b.size();++i)
+      b[i] = 2.0*rand()/RAND_MAX - 1.0;
+
+    for (int j=0;j<nn;++j) {
+      for (int i=0;i<nn;++i)
+        for (int l=0;l<nn;++l)
+          a[i+j*nn] += b[i+l*nn]*b[j+l*nn];
+      a[j+j*nn] += nn;
+    }
+
+    // blocks of the leaf :: ( offset, size ) of factor and schur rows
+    int off[2] = { 0, fs }, len[2] = { fs, ss };
+    int mat[2][2] = { { UHM_ATL, UHM_ATR }, { UHM_ABL, UHM_ABR } };
+    for (int r=0;r<2;++r)
+      for (int c=0;c<2;++c) {
+        if (!len[r] || !len[c] || !hm->is_buffer(mat[r][c])) continue;
+        std::vector<double> blk(len[r]*len[c]);
+        for (int j=0;j<len[c];++j)
+          for (int i=0;i<len[r];++i)
+            blk[i+j*len[r]] = a[(off[r]+i)+(off[c]+j)*nn];
+        hm->import_matrix( len[r], len[c], len[r], blk, mat[r][c] );
+      }
+  }
+}
+
+// relative error of the element-by-element product against the
+// assembled sparse matrix ( fortran index, row major triplets )
+static double multiply_error(uhm::Mesh m, int n_rhs) {
+  int n_dof = m->get_n_dof();
+  std::vector<double> x(n_dof*n_rhs), y, z(n_dof*n_rhs, 0.0);
+  for (int i=0;i<x.size();++i)
+    x[i] = 2.0*rand()/RAND_MAX - 1.0;
+
+  if (!m->multiply( n_rhs, x, y ))
+    return 1.0;
+
+  uhm::DSparse_ sp(1, 0, n_rhs);
+  m->export_matrix( &sp, n_rhs );
+
+  int n, nr, nz;
+  std::vector<int> ia, ja;
+  std::vector<double> a, b;
+  sp.triplet( false, n, nr, nz, ia, ja, a, b );
+
+  for (int k=0;k<nz;++k)
+    for (int j=0;j<n_rhs;++j)
+      z[(ia[k]-1)+j*n_dof] += a[k]*x[(ja[k]-1)+j*n_dof];
+
+  double diff = 0.0, norm = 0.0;
+  for (int i=0;i<z.size();++i) {
+    if (fabs(y[i]-z[i]) > diff) diff = fabs(y[i]-z[i]);
+    if (fabs(z[i]) > norm)      norm = fabs(z[i]);
+  }
+  return (norm > 0.0 ? diff/norm : diff);
+}
+
+// xt and xb of the element in one vector
+static void get_x(uhm::Element e, std::vector<double> &v) {
+  std::pair<int,int> n_dof = e->get_n_dof();
+  v.assign(n_dof.first + n_dof.second, 0.0);
+  if (n_dof.first)  e->get_matrix()->copy_out(UHM_XT, &v[0]);
+  if (n_dof.second) e->get_matrix()->copy_out(UHM_XB, &v[n_dof.first]);
+}
+
+// rhs on the first row of leaves, other leaves are cleared; output on 
+// the last leaf, a middle leaf and the root. returns the relative error 
+// of the selective solve and whether an empty rhs gives zero
+static double selective_error(uhm::Mesh m, int n, int &is_zero) {
+  std::vector< uhm::Element > rhs, out, none;
+  for (int k=0;k<n*n;++k) {
+    uhm::Element e = m->find_element(k);
+    if (k < n) {
+      rhs.push_back(e);
+    } else {
+      std::pair<int,int> n_dof = e->get_n_dof();
+      if (n_dof.first)  e->get_matrix()->set_zero(UHM_BT);
+      if (n_dof.second) e->get_matrix()->set_zero(UHM_BB);
+    }
+  }
+  out.push_back(m->find_element(n*n-1));
+  out.push_back(m->find_element(n*n/2));
+  out.push_back(m->get_root());
+
+  std::vector< std::vector<double> > x_full(out.size());
+  std::vector< double > x;
+
+  m->set_rhs();
+  m->solve_lu_nopiv();
+  for (int i=0;i<out.size();++i)
+    get_x(out[i], x_full[i]);
+
+  m->solve_selective( UHM_LU_NOPIV, rhs, out );
+
+  double diff = 0.0, norm = 0.0;
+  for (int i=0;i<out.size();++i) {
+    get_x(out[i], x);
+    for (int l=0;l<x.size();++l) {
+      if (fabs(x[l]-x_full[i][l]) > diff) diff = fabs(x[l]-x_full[i][l]);
+      if (fabs(x_full[i][l]) > norm)      norm = fabs(x_full[i][l]);
+    }
+  }
+
+  m->solve_selective( UHM_LU_NOPIV, none, out );
+
+  is_zero = true;
+  for (int i=0;i<out.size();++i) {
+    get_x(out[i], x);
+    for (int l=0;l<x.size();++l)
+      if (x[l] != 0.0) is_zero = false;
+  }
+  return (norm > 0.0 ? diff/norm : 1.0);
+}
+
+static int is_finite(std::vector<double> &x) {
+  for (int i=0;i<x.size();++i)
+    if (x[i] != x[i] || fabs(x[i]) > 1.0e300)
+      return false;
+  return true;
+}
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  // input check
+  if (argc != 4) {
+    printf("Try : krylovtest [n_thread][n_elements per side][p]\n");
+    return 0;
+  }
+
+  int n_threads, n, p;
+  n_threads = atoi( (argv[1]) );
+  n         = atoi( (argv[2]) );
+  p         = atoi( (argv[3]) );
+
+  uhm::set_num_threads(n_threads);
+
+  // the stale leaf is a low rank update, restart covers its dofs
+  int n_rhs = 2, max_iter = 60, restart = 30;
+  char treename[] = "krylovtest.tree", matname[] = "krylovtest.mat";
+
+  // op holds the leaf matrices, pre is factorized with the same values
+  uhm::Mesh op = create_mesh(n, p), pre = create_mesh(n, p);
+
+  uhm::build_tree(op);
+  op->lock();
+  op->export_tree( treename );
+  int is_tree_loaded = pre->import_tree( treename );
+
+  create_matrix(op);
+  spd_leaves(op, n);
+  op->export_matrix_binary( matname );
+
+  create_matrix(pre);
+  pre->import_matrix_binary( matname );
+  pre->lu_nopiv_with_free();
+
+  int n_dof = op->get_n_dof();
+  std::vector<double> b(n_dof*n_rhs), x;
+  for (int i=0;i<b.size();++i)
+    b[i] = 2.0*rand()/RAND_MAX - 1.0;
+
+  // y = A x against the assembled matrix
+  double err_multiply = multiply_error(op, n_rhs);
+
+  int it_pcg, it_gmres, it_stale, it_zero;
+  double t, t_p, t_m, res_pcg, res_gmres, res_stale, res_zero;
+
+  // exact preconditioner
+  x.clear();
+  pre->pcg( op, UHM_LU_NOPIV, n_rhs, b, x, UHM_ERROR_TOL, max_iter );
+  pre->get_krylov_stat( it_pcg, res_pcg, t, t_p, t_m );
+
+  x.clear();
+  pre->gmres( op, UHM_LU_NOPIV, n_rhs, b, x, UHM_ERROR_TOL, max_iter, restart );
+  pre->get_krylov_stat( it_gmres, res_gmres, t, t_p, t_m );
+
+  // stale preconditioner :: one leaf matrix is replaced
+  op->find_element(0)->get_matrix()->random_spd(FLA_LOWER_TRIANGULAR);
+  x.clear();
+  pre->gmres( op, UHM_LU_NOPIV, n_rhs, b, x, UHM_ERROR_TOL, max_iter, restart );
+  pre->get_krylov_stat( it_stale, res_stale, t, t_p, t_m );
+
+  // zero operator :: breakdown at the first iteration
+  for (int k=0;k<n*n;++k) {
+    uhm::Matrix hm = op->find_element(k)->get_matrix();
+    for (int i=UHM_ATL;i<UHM_P;++i)
+      if (hm->is_buffer(i))
+        hm->set_zero(i);
+  }
+  x.clear();
+  pre->pcg( op, UHM_LU_NOPIV, n_rhs, b, x, UHM_ERROR_TOL, max_iter );
+  pre->get_krylov_stat( it_zero, res_zero, t, t_p, t_m );
+
+  int is_breakdown = (is_finite(x) && it_zero == 1);
+
+  // selective sweeps :: rhs of pre is changed
+  int is_selective_zero;
+  double err_selective = selective_error(pre, n, is_selective_zero);
+
+  printf("--------------------------\n");
+  printf("Threads                = %d\n", n_threads);
+  printf("N dof                  = %d\n", n_dof);
+  printf("Multiply ( error )     = %E\n", err_multiply);
+  printf("PCG exact   ( iter )   = %d, %E\n", it_pcg, res_pcg);
+  printf("GMRES exact ( iter )   = %d, %E\n", it_gmres, res_gmres);
+  printf("GMRES stale ( iter )   = %d, %E\n", it_stale, res_stale);
+  printf("PCG zero op ( iter )   = %d, %E\n", it_zero, res_zero);
+  printf("Selective ( error )    = %E, %s\n", err_selective,
+         (is_selective_zero ? "zero without rhs" : "NONZERO without rhs"));
+  printf("--------------------------\n");
+
+  if (is_tree_loaded && err_multiply < UHM_ERROR_TOL &&
+      it_pcg <= 1 && res_pcg < UHM_ERROR_TOL &&
+      it_gmres <= 1 && res_gmres < UHM_ERROR_TOL &&
+      res_stale < UHM_ERROR_TOL && is_breakdown &&
+      err_selective < UHM_ERROR_TOL && is_selective_zero)
+    printf("TESTING KRYLOV : **** PASS **** \n");
+  else
+    printf("TESTING KRYLOV : **** FAIL **** \n");
+
+  delete op;
+  delete pre;
+
+  FLA_Finalize();
+  return 0;
+}
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+echo '****** ASCII and binary mesh import *******'
+
+for f in $@ ; do \
+    ../meshtest 1 $f $f.bin
+done ;
+
+echo '****** ASCII mesh import for various thread size *******'
+
+for i in 1 2 4 8 12 16 20 24 ; do \
+    ../meshtest $i $1 $1.bin
+done ;
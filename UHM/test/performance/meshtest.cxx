@@ -0,0 +1,113 @@
+#include "uhm.hxx"
+
+// convert ASCII mesh into binary mesh and compare the load time;
+// ASCII import is parsed on n_thread byte ranges and has to match the
+// single thread import. The tree snapshot of the ASCII mesh has to load
+// on the binary mesh.
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  uhm::Mesh m;
+
+  // input check
+  if (argc != 4) {
+    printf("Try : meshtest [n_thread][input_file][output_file]\n");
+    return 0;
+  }
+
+  int n_threads;
+  char *filename, *binaryname;
+  n_threads  = atoi( (argv[1]) );
+  filename   = argv[2];
+  binaryname = argv[3];
+
+  double t_base, t_ascii, t_export, t_binary;
+  unsigned long long h_ascii, h_serial, h_binary;
+  int n_nodes, n_elements, is_serial_same;
+
+  // reference : ASCII mesh parsed on one thread
+  uhm::set_num_threads(1);
+  m = new uhm::Mesh_;
+  m->import_file( filename );
+  h_serial   = m->get_connectivity_hash();
+  n_nodes    = m->get_n_nodes();
+  n_elements = m->get_n_elements();
+  delete m;
+
+  uhm::set_num_threads(n_threads);
+
+  printf( "BEGIN : Import ASCII mesh from file : %s\n", filename );
+  m = new uhm::Mesh_;
+  t_base  = uhm::timer();
+  m->import_file( filename );
+  t_ascii = uhm::timer() - t_base;
+  h_ascii = m->get_connectivity_hash();
+  printf( "END   : Import ASCII mesh < n_nodes %d, n_elements %d >\n",
+	  m->get_n_nodes(), m->get_n_elements() );
+
+  is_serial_same = (h_ascii == h_serial &&
+                    n_nodes == m->get_n_nodes() &&
+                    n_elements == m->get_n_elements());
+
+  printf( "BEGIN : Export binary mesh to file : %s\n", binaryname );
+  t_base   = uhm::timer();
+  m->export_binary( binaryname );
+  t_export = uhm::timer() - t_base;
+  printf( "END   : Export binary mesh \n" );
+
+  // tree snapshot of the ASCII mesh, loaded again on the binary mesh
+  char treename[1024];
+  sprintf(treename, "%s.tree", binaryname);
+
+  printf( "BEGIN : Export tree to file : %s\n", treename );
+  uhm::build_tree(m);
+  m->lock();
+  m->export_tree( treename );
+  m->unlock();
+  printf( "END   : Export tree \n" );
+
+  delete m;
+
+  printf( "BEGIN : Import binary mesh from file : %s\n", binaryname );
+  m = new uhm::Mesh_;
+  t_base   = uhm::timer();
+  m->import_file( binaryname );
+  t_binary = uhm::timer() - t_base;
+  h_binary = m->get_connectivity_hash();
+  printf( "END   : Import binary mesh < n_nodes %d, n_elements %d >\n",
+	  m->get_n_nodes(), m->get_n_elements() );
+
+  printf( "BEGIN : Import tree from file : %s\n", treename );
+  int is_tree_loaded = m->import_tree( treename );
+  printf( "END   : Import tree < loaded %d >\n", is_tree_loaded );
+
+  struct stat s_ascii, s_binary;
+  stat(filename, &s_ascii);
+  stat(binaryname, &s_binary);
+
+  printf("--------------------------\n");
+  printf("Threads                = %d\n", n_threads);
+  printf("ASCII file (MB)        = %E\n", s_ascii.st_size/1.0e6);
+  printf("Binary file (MB)       = %E\n", s_binary.st_size/1.0e6);
+  printf("--------------------------\n");
+  printf("Time ASCII import (s)  = %E\n", t_ascii);
+  printf("ASCII import (MB/s)    = %E\n", s_ascii.st_size/1.0e6/t_ascii);
+  printf("Time binary export (s) = %E\n", t_export);
+  printf("Time binary import (s) = %E\n", t_binary);
+  printf("Binary import (MB/s)   = %E\n", s_binary.st_size/1.0e6/t_binary);
+  printf("Speed up               = %6.2lf\n", t_ascii/t_binary);
+  printf("Same as 1 thread       = %d\n", is_serial_same);
+  printf("--------------------------\n");
+
+  if (h_ascii == h_binary && is_tree_loaded && is_serial_same)
+    printf("TESTING MESH : **** PASS **** \n");
+  else
+    printf("TESTING MESH : **** FAIL **** \n");
+
+  delete m;
+
+  FLA_Finalize();
+  return 0;
+}
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+echo '****** Tree build variants on a structured mesh *******'
+
+for v in 4 5 6 7 8 9 10 ; do \
+    ../treetest 1 32 3 $v
+done ;
@@ -0,0 +1,301 @@
+#include "uhm.hxx"
+
+#define UHM_ERROR_TOL 1.0e-5
+#define UHM_BALANCE_TOL 0.6
+
+// structured quad mesh with vertex, edge and interior nodes
+// node ids are offset by kind : 0 vertex, 1 x-edge, 2 y-edge, 3 interior
+// with is_variable, the interior nodes of the upper half have order 2p
+static int node_id(int kind, int i, int j, int n) {
+  return (kind*(n+1) + i)*(n+1) + j;
+}
+
+static uhm::Mesh create_mesh(int n, int p, int is_coord, int is_variable) {
+  uhm::Mesh m = new uhm::Mesh_;
+
+  for (int i=0;i<n;++i) {
+    for (int j=0;j<n;++j) {
+      uhm::Element e = m->add_element();
+      int pe = ((is_variable && i >= n/2) ? 2*p : p);
+
+      e->add_node( m->add_node( node_id(0, i  , j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j  , n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i  , j+1, n), 1 ) );
+      e->add_node( m->add_node( node_id(0, i+1, j+1, n), 1 ) );
+
+      e->add_node( m->add_node( node_id(1, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(1, i  , j+1, n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i  , j  , n), p-1 ) );
+      e->add_node( m->add_node( node_id(2, i+1, j  , n), p-1 ) );
+
+      e->add_node( m->add_node( node_id(3, i  , j  , n), (pe-1)*(pe-1) ) );
+    }
+  }
+
+  // vertex positions; edge and interior nodes follow through centroids
+  if (is_coord) 
+    for (int i=0;i<=n;++i) 
+      for (int j=0;j<=n;++j) 
+        m->find_node( node_id(0, i, j, n) )->set_coord( i, j, 0.0 );
+
+  return m;
+}
+
+// largest share of the leaf elimination flops under one child of root
+static double tree_balance(uhm::Mesh m) {
+  uhm::Element root = m->get_root();
+  int n_children = root->get_n_children();
+  if (n_children < 2) 
+    return 1.0;
+
+  std::vector< double > w(n_children, 0.0);
+  double total = 0.0, w_max = 0.0;
+
+  for (int k=0;k<n_children;++k) {
+    std::vector< uhm::Element > tmp;
+    tmp.push_back( root->get_child(k) );
+    for (int i=0;i<tmp.size();++i) {
+      uhm::Element e = tmp.at(i);
+      if (e->get_n_children()) {
+        for (int j=0;j<e->get_n_children();++j) 
+          tmp.push_back( e->get_child(j) );
+      } else {
+        double flop_decompose, flop_solve, buffer;
+        unsigned int n_nonzero_factor;
+        e->estimate_cost(UHM_LU_NOPIV, UHM_REAL, 1,
+                         flop_decompose, flop_solve, 
+                         n_nonzero_factor, buffer);
+        w[k] += flop_decompose;
+      }
+    }
+    total += w[k];
+    w_max  = max(w_max, w[k]);
+  }
+  return (total > 0.0 ? w_max/total : 1.0);
+}
+
+// elimination flops and factor nonzeros of the locked tree
+static void tree_cost(uhm::Mesh m, double &flop, unsigned int &n_nonzero) {
+  double flop_solve, buffer;
+  if (!m->is_locked()) 
+    m->lock();
+  m->estimate_cost(UHM_LU_NOPIV, UHM_REAL, 1, 
+                   flop, flop_solve, n_nonzero, buffer);
+}
+
+// factorize a random matrix on the tree and return the residual
+static double check_tree(uhm::Mesh m) {
+  if (!m->is_locked()) 
+    m->lock();
+  m->create_matrix_without_buffer( UHM_REAL, 1 );
+  m->create_matrix_buffer();
+  m->random_matrix();
+  m->set_rhs();
+
+  m->lu_nopiv_with_free();
+  m->solve_lu_nopiv();
+  m->check_lu_nopiv();
+
+  double residual = m->get_residual();
+  m->free_matrix();
+  m->unlock();
+
+  return residual;
+}
+
+// leaf ( i, j ) is split into four children; a child keeps one corner,
+// the two edges and the interior node of the leaf, and gets a new 
+// interior node, so the interface of the leaf is unchanged
+static void refine_leaf(uhm::Mesh m, int i, int j, int n, int p) {
+  uhm::Element e = m->refine_element(i*n + j, false, 4);
+
+  for (int k=0;k<4;++k) {
+    uhm::Element c = e->get_child(k);
+    int di = k%2, dj = k/2;
+
+    c->add_node( m->find_node( node_id(0, i+di, j+dj, n) ) );
+    c->add_node( m->find_node( node_id(1, i   , j+dj, n) ) );
+    c->add_node( m->find_node( node_id(2, i+di, j   , n) ) );
+    c->add_node( m->find_node( node_id(3, i   , j   , n) ) );
+
+    c->add_node( m->add_node( std::make_pair(node_id(3, i, j, n), k+1), 
+                              (p-1)*(p-1) ) );
+  }
+}
+
+// ( factor, schur ) dofs of the elements in the tree
+static void tree_stat(uhm::Mesh m, 
+                      std::map< int, std::pair<int,int> > &stat) {
+  std::vector< uhm::Element > tmp;
+  tmp.push_back( m->get_root() );
+
+  stat.clear();
+  for (int i=0;i<tmp.size();++i) {
+    stat[ tmp.at(i)->get_id() ] = tmp.at(i)->get_n_dof();
+    for (int j=0;j<tmp.at(i)->get_n_children();++j) 
+      tmp.push_back( tmp.at(i)->get_child(j) );
+  }
+}
+
+// relock after refine and unrefine; compared with a full lock, and the
+// elements outside the updated subtree and its ancestors are reusable
+static int check_relock(uhm::Mesh m, int n, int p, double &residual) {
+  int is_same = true, op[3][3] = { { 1, n/2, n/2 }, 
+                                   { 1, 0,   0   }, 
+                                   { 0, n/2, n/2 } };
+  uhm::Mesh bak = new uhm::Mesh_;
+
+  m->lock();
+  residual = 0.0;
+
+  for (int k=0;k<3;++k) {
+    int id = op[k][1]*n + op[k][2];
+
+    m->backup(bak);
+    if (op[k][0]) refine_leaf(m, op[k][1], op[k][2], n, p);
+    else          m->unrefine_element(id);
+    m->relock();
+
+    // four new leaves are dissected again below the refined one
+    if (op[k][0] && m->find_element(id)->get_n_children() > 2) 
+      is_same = false;
+
+    std::map< int, std::pair<int,int> > stat, full;
+    tree_stat(m, stat);
+
+    std::set< int > region;
+    {
+      std::vector< uhm::Element > tmp;
+      tmp.push_back( m->find_element(id) );
+      for (int i=0;i<tmp.size();++i) 
+        for (int j=0;j<tmp.at(i)->get_n_children();++j) 
+          tmp.push_back( tmp.at(i)->get_child(j) );
+      for (uhm::Element a=tmp.at(0)->get_parent();
+           a!=uhm::nil_element;a=a->get_parent())
+        tmp.push_back( a );
+      for (int i=0;i<tmp.size();++i) 
+        region.insert( tmp.at(i)->get_id() );
+    }
+
+    m->check_reuse(bak);
+
+    std::map< int, std::pair<int,int> >::iterator it;
+    for (it=stat.begin();it!=stat.end();++it) 
+      if (!region.count(it->first) && 
+          !m->find_element(it->first)->is_matrix_reusable()) 
+        is_same = false;
+
+    residual = max(residual, check_tree(m));
+
+    m->lock();
+    tree_stat(m, full);
+
+    is_same = ( is_same && stat == full );
+  }
+  delete bak;
+
+  return is_same;
+}
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  uhm::Mesh m;
+
+  // input check
+  if (argc != 5) {
+    printf("Try : treetest [n_thread][n_elements per side][p][variant]\n");
+    printf(" - variant 4 (METIS), 5 (weighted METIS), 6 (bisection),\n");
+    printf("           7 (coordinates), 8 (7 without coordinates),\n");
+    printf("           9 (relock after refinement on var 6),\n");
+    printf("          10 (5 with variable p, balance of the root split)\n");
+    return 0;
+  }
+
+  int n_threads, n, p, variant;
+  n_threads = atoi( (argv[1]) );
+  n         = atoi( (argv[2]) );
+  p         = atoi( (argv[3]) );
+  variant   = atoi( (argv[4]) );
+
+  double t_base, t_build_tree, residual;
+
+  uhm::set_num_threads(n_threads);
+
+  printf( "BEGIN : Create mesh %d x %d \n", n, n );
+  m = create_mesh(n, p, (variant != 8), (variant == 10));
+  printf( "END   : Create mesh < n_nodes %d, n_elements %d >\n",
+	  m->get_n_nodes(), m->get_n_elements() );
+
+  printf( "BEGIN : Build tree var %d\n", variant );
+  t_base = uhm::timer();
+  switch (variant) {
+  case 4: uhm::build_tree_var_4(m); break;
+  case 5: 
+  case 10: uhm::build_tree_var_5(m, UHM_LU_NOPIV, UHM_REAL, 1); break;
+  case 6: 
+  case 9: uhm::build_tree_var_6(m); break;
+  case 7: 
+  case 8: uhm::build_tree_var_7(m); break;
+  default:
+    printf("Unknown variant %d\n", variant);
+    return 0;
+  }
+  t_build_tree = uhm::timer() - t_base;
+  printf( "END   : Build tree < n_nodes %d, n_elements %d >\n",
+	  m->get_n_nodes(), m->get_n_elements() );
+
+  // weighted bisection should split the flops, not the elements
+  int is_same = true;
+  double balance = 0.0;
+  if (variant == 10) {
+    m->lock();
+    balance = tree_balance(m);
+    is_same = (balance <= UHM_BALANCE_TOL);
+  }
+
+  // var 7 against var 4 on the same mesh; without coordinates the 
+  // fallback has to give the var 4 ordering, so fill and flops match
+  double flop = 0.0, flop_4 = 0.0;
+  unsigned int n_nonzero = 0, n_nonzero_4 = 0;
+  if (variant == 7 || variant == 8) {
+    uhm::Mesh m4 = create_mesh(n, p, (variant != 8), false);
+    uhm::build_tree_var_4(m4);
+    tree_cost(m4, flop_4, n_nonzero_4);
+    tree_cost(m,  flop,   n_nonzero);
+    if (variant == 8) 
+      is_same = (n_nonzero == n_nonzero_4 && 
+                 fabs(flop - flop_4) <= UHM_ERROR_TOL*flop_4);
+    delete m4;
+  }
+
+  if (variant == 9) {
+    is_same = check_relock(m, n, p, residual);
+  } else {
+    residual = check_tree(m);
+  }
+
+  printf("--------------------------\n");
+  printf("Threads                = %d\n", n_threads);
+  printf("Variant                = %d\n", variant);
+  printf("Time build tree (s)    = %E\n", t_build_tree);
+  printf("Residual               = %E\n", residual);
+  if (variant == 10)
+    printf("Balance ( max share )  = %E\n", balance);
+  if (variant == 7 || variant == 8) {
+    printf("Flop    var 7 / var 4  = %E / %E\n", flop, flop_4);
+    printf("Nonzero var 7 / var 4  = %u / %u\n", n_nonzero, n_nonzero_4);
+  }
+  printf("--------------------------\n");
+
+  if (residual < UHM_ERROR_TOL && is_same)
+    printf("TESTING TREE : **** PASS **** \n");
+  else
+    printf("TESTING TREE : **** FAIL **** \n");
+
+  delete m;
+
+  FLA_Finalize();
+  return 0;
+}
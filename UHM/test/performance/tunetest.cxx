@@ -0,0 +1,71 @@
+#include "uhm.hxx"
+
+// tune the hier block size per ( fs, ss ) front shape for a method on
+// this machine and store the profile; import_hier_block_profile loads
+// it for later runs factored with the same method
+
+int main (int argc, char **argv)
+{
+  FLA_Init();
+
+  // input check
+  if (argc != 5) {
+    printf("Try : tunetest [n_thread][n_itr][decomposition][output_file]\n");
+    return 0;
+  }
+
+  int n_threads, n_itr, decomposition;
+  char *filename;
+  n_threads     = atoi( (argv[1]) );
+  n_itr         = atoi( (argv[2]) );
+  decomposition = atoi( (argv[3]) );
+  filename      = argv[4];
+
+  uhm::set_num_threads(n_threads);
+
+  int f[] = { 32, 64, 128, 256, 512, 1024, 2048 };
+  int b[] = { 32, 64, 96, 128, 192, 256, 384, 512 };
+
+  // ** schur part of half and of the full factor size
+  std::vector< std::pair<int,int> > front;
+  for (int i=0;i<sizeof(f)/sizeof(int);++i) {
+    front.push_back( std::make_pair(f[i], f[i]/2) );
+    front.push_back( std::make_pair(f[i], f[i]) );
+  }
+  std::vector<int> block(b, b + sizeof(b)/sizeof(int));
+
+  double t_base, t_tune;
+
+  printf( "BEGIN : Tune block size\n" );
+  t_base = uhm::timer();
+  uhm::tune_hier_block_size( decomposition, UHM_REAL, front, block, n_itr );
+  t_tune = uhm::timer() - t_base;
+  printf( "END   : Tune block size\n" );
+
+  uhm::export_hier_block_profile( filename );
+
+  std::vector< std::pair< std::pair<int,int>, int > > profile;
+  uhm::get_hier_block_profile( profile );
+
+  printf("--------------------------\n");
+  printf("N threads             = %d\n", n_threads);
+  printf("N iteration           = %d\n", n_itr);
+  printf("Decomposition         = %d\n", decomposition);
+  printf("CHOL(1), LU_NOPIV(2), LU_PIV(3), LU_INCPIV(4), QR(5)\n");
+  printf("Time tune (s)         = %E\n", t_tune);
+  printf("--------------------------\n");
+  for (int i=0;i<profile.size();++i) {
+    if (profile[i].second)
+      printf("Front %6d x %6d = block %d\n", 
+             profile[i].first.first, profile[i].first.second, 
+             profile[i].second);
+    else 
+      printf("Front %6d x %6d = flat\n", 
+             profile[i].first.first, profile[i].first.second);
+  }
+  printf("--------------------------\n");
+
+  FLA_Finalize();
+
+  return 0;
+}
@@ -47,3 +47,17 @@ echo '****** Test for all decomposition method for toy mesh *******'
 ../uhmtest 2 3 256 ../../uhmfile/toy_mesh.uhm
 ../uhmtest 2 3 256 ../../uhmfile/toy_mesh.uhm
 ../uhmtest 2 3 256 ../../uhmfile/toy_mesh.uhm
+
+echo '****** Test for streamed rhs on toy mesh *******'
+
+for d in 1 2 3 4 5 ; do \
+    ../uhmtest 2 $d 256 ../../uhmfile/toy_mesh.uhm 3
+done ;
+
+echo '****** Test for batched leaf factorization on toy mesh *******'
+
+for d in 1 2 3 ; do \
+    ../uhmtest 1 $d 256 ../../uhmfile/toy_mesh.uhm 0 2
+    ../uhmtest 2 $d 256 ../../uhmfile/toy_mesh.uhm 0 2
+    ../uhmtest 2 $d 256 ../../uhmfile/toy_mesh.uhm 3 2
+done ;
@@ -2,6 +2,28 @@
 
 #define UHM_ERROR_TOL 1.0e-5
 
+static void collect_leaves(uhm::Element e, std::vector< uhm::Element > &leaves) {
+  if (e->is_leaf()) {
+    leaves.push_back(e);
+    return;
+  }
+  for (int i=0;i<e->get_n_children();++i)
+    collect_leaves(e->get_child(i), leaves);
+}
+
+// x of the leaves as a global vector, summed when unassembled
+static void gather_leaves(uhm::Mesh m, int assemble, std::vector<double> &v) {
+  std::vector< uhm::Element > leaves;
+  collect_leaves(m->get_root(), leaves);
+
+  int n_dof = m->get_n_dof();
+  v.assign(n_dof, 0.0);
+
+  uhm::DSparse_ sp(0, 0, 1);
+  for (int i=0;i<leaves.size();++i)
+    sp.import_rhs(v, assemble, n_dof, 1, leaves[i]);
+}
+
 int main (int argc, char **argv)
 {
   FLA_Init();
@@ -9,20 +31,23 @@ int main (int argc, char **argv)
   uhm::Mesh m;
 
   // input check
-  if (argc != 5) {
-    printf("Try : uhm [n_thread][decomposition][blocksize][input_file]\n");
+  if (argc < 5 || argc > 7) {
+    printf("Try : uhm [n_thread][decomposition][blocksize][input_file][n_stream][leaf_batch]\n");
     return 0;
   }
 
-  int n_threads, decomposition, blocksize, svd_cutoff;
+  int n_threads, decomposition, blocksize, svd_cutoff, n_stream, leaf_batch;
   double rel_thres;
   char *filename;
   n_threads     = atoi( (argv[1]) );
   decomposition = atoi( (argv[2]) );
   blocksize     = atoi( (argv[3]) );
   filename      = argv[4];
+  n_stream      = (argc >= 6 ? atoi( (argv[5]) ) : 0);
+  leaf_batch    = (argc == 7 ? atoi( (argv[6]) ) : 0);
 
-  double t_base, t_tmp, t_build_tree, t_decompose, t_solve;
+  double t_base, t_tmp, t_build_tree, t_decompose, t_solve, t_stream = 0.0;
+  double e_stream = 0.0;
   double f_decompose, f_solve, m_estimate, m_used, m_max_used;
 
   printf( "BEGIN : Import mesh from file : %s\n", filename );
@@ -43,6 +68,7 @@ int main (int argc, char **argv)
 	  m->get_n_nodes(), m->get_n_elements() );
 
   m->lock();
+  m->set_leaf_batch(leaf_batch);
 
   int datatype = UHM_REAL; 
   int n_rhs    = 1;
@@ -155,6 +181,46 @@ int main (int argc, char **argv)
     break;
   }
   
+  // many rhs streamed through the factorization in blocks of n_rhs,
+  // column j is ( j+1 ) times the assembled rhs of the leaves
+  if (n_stream) {
+    int n_dof = m->get_n_dof();
+    std::vector<double> b0, b(n_dof*n_stream), x, x0;
+
+    m->set_rhs();
+    gather_leaves(m, UHM_UNASSEMBLED, b0);
+    for (int j=0;j<n_stream;++j)
+      for (int i=0;i<n_dof;++i)
+        b[i+j*n_dof] = (j+1)*b0[i];
+
+    printf("BEGIN : Streamed Solve\n");
+    t_base   = uhm::timer();
+    m->solve(decomposition, n_stream, b, x);
+    t_stream = uhm::timer() - t_base;
+    printf("END   : Streamed Solve\n");
+
+    // leaf x is overwritten by the stream
+    m->set_rhs();
+    switch (decomposition) {
+    case UHM_CHOL:      m->solve_chol();     break;
+    case UHM_LU_NOPIV:  m->solve_lu_nopiv(); break;
+    case UHM_LU_INCPIV:
+    case UHM_LU_PIV:    m->solve_lu_piv();   break;
+    case UHM_QR:        m->solve_qr();       break;
+    }
+
+    // streamed columns against the column solved by the tree
+    gather_leaves(m, UHM_ASSEMBLED, x0);
+    double norm = 0.0;
+    for (int i=0;i<n_dof;++i)
+      norm = max(norm, fabs(x0[i]));
+    for (int j=0;j<n_stream;++j)
+      for (int i=0;i<n_dof;++i)
+        e_stream = max(e_stream, fabs(x[i+j*n_dof] - (j+1)*x0[i])/(j+1));
+    if (norm > 0.0)
+      e_stream /= norm;
+  }
+
   switch (decomposition) {
   case UHM_CHOL:
     printf("BEGIN : CHOL Check\n");
@@ -209,6 +275,10 @@ int main (int argc, char **argv)
   else
     printf("Hier-Matrix is NOT used \n");
 
+  if (leaf_batch)
+    printf("Leaf batch is used ( min group = %d, width = %d )\n",
+           leaf_batch, UHM_BATCH_WIDTH);
+
   printf("--------------------------\n");
   printf("Time build tree (s)   = %E\n", t_build_tree);
   printf("Time tree / Time decom= %E\n", t_build_tree/t_decompose);
@@ -226,6 +296,13 @@ int main (int argc, char **argv)
   printf("FLOP decom (GFLOP/s)  = %6.3lf\n", f_decompose/t_decompose/1.0e9);
   printf("FLOP solve (GFLOP/s)  = %6.3lf\n", f_solve/t_solve/1.0e9);
   printf("--------------------------\n");
+  if (n_stream) {
+    printf("Streamed RHS          = %d\n", n_stream);
+    printf("Time stream (s)       = %E\n", t_stream);
+    printf("Stream (RHS/s)        = %E\n", n_stream/t_stream);
+    printf("Stream error          = %E\n", e_stream);
+    printf("--------------------------\n");
+  }
   switch (decomposition) {
   case UHM_CHOL:
   case UHM_LU_NOPIV:
@@ -236,7 +313,7 @@ int main (int argc, char **argv)
     double residual = m->get_residual();
 
     printf("Residual              = %E\n", residual);
-    if ( residual < UHM_ERROR_TOL ) 
+    if ( residual < UHM_ERROR_TOL && e_stream < UHM_ERROR_TOL ) 
       printf("TESTING UHM : **** PASS **** \n");
     else 
       printf("TESTING UHM : **** FAIL **** \n");